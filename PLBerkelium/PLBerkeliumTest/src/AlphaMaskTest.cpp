@@ -0,0 +1,161 @@
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/Core/MemoryManager.h>
+#include <PLBerkelium/AlphaMask.h>
+#include <PLBerkelium/BufferCopy.h>
+#include <PLBerkelium/TextureUploader.h>
+
+#include "Random.h"
+#include "Tests.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLBerkelium;
+
+namespace PLBerkeliumTest {
+
+
+//[-------------------------------------------------------]
+//[ Internal helpers                                      ]
+//[-------------------------------------------------------]
+static inline Berkelium::Rect MakeRect(int nLeft, int nTop, int nWidth, int nHeight)
+{
+	Berkelium::Rect cRect;
+	cRect.mLeft   = nLeft;
+	cRect.mTop    = nTop;
+	cRect.mWidth  = nWidth;
+	cRect.mHeight = nHeight;
+	return cRect;
+}
+
+
+static inline bool IsBlockVisible(const uint8 *pImage, int nWidth, int nHeight, int nX, int nY)
+{
+	// reference, any pixel of the block the position is in
+	const int nBlockLeft = (nX >> ALPHAMASKSHIFT) << ALPHAMASKSHIFT;
+	const int nBlockTop  = (nY >> ALPHAMASKSHIFT) << ALPHAMASKSHIFT;
+	for (int y = nBlockTop; y < nBlockTop + (1 << ALPHAMASKSHIFT) && y < nHeight; y++)
+	{
+		for (int x = nBlockLeft; x < nBlockLeft + (1 << ALPHAMASKSHIFT) && x < nWidth; x++)
+		{
+			if (pImage[(size_t(y) * nWidth + x) * 4 + 3] > CLICKTHROUGHALPHA)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+
+//[-------------------------------------------------------]
+//[ Functions                                             ]
+//[-------------------------------------------------------]
+uint32 VerifyAlphaMask(uint32 nIterations)
+{
+	uint32 nNumOfFailures = 0;
+	AlphaMask cMask;
+	Random cRandom;
+	for (uint32 nIteration = 0; nIteration < nIterations; nIteration++)
+	{
+		const int nWidth  = 1 + cRandom.Get() % 96;
+		const int nHeight = 1 + cRandom.Get() % 96;
+		const size_t nSize = size_t(nWidth) * size_t(nHeight) * 4;
+		uint8 *pImage = new uint8[nSize];
+		uint8 *pPaint = new uint8[nSize];
+
+		// a few visible rects on a transparent page
+		MemoryManager::Set(pImage, 0, uint32(nSize));
+		const int nNumOfRects = 1 + cRandom.Get() % 8;
+		for (int i = 0; i < nNumOfRects; i++)
+		{
+			const Berkelium::Rect cRect = TextureUploader::ClipRect(MakeRect(cRandom.Get() % nWidth, cRandom.Get() % nHeight, 1 + cRandom.Get() % nWidth, 1 + cRandom.Get() % nHeight), nWidth, nHeight);
+			const uint8 nAlpha = (cRandom.Get() % 2) ? 255 : uint8(cRandom.Get());
+			for (int y = cRect.top(); y < cRect.bottom(); y++)
+			{
+				for (int x = cRect.left(); x < cRect.right(); x++)
+				{
+					pImage[(size_t(y) * nWidth + x) * 4 + 3] = nAlpha;
+				}
+			}
+		}
+
+		// after a full paint the mask has to match the blocks
+		const Berkelium::Rect cFullRect = MakeRect(0, 0, nWidth, nHeight);
+		cMask.SetSize(nWidth, nHeight);
+		cMask.Clear();
+		cMask.Update(pImage, cFullRect, 1, &cFullRect);
+		bool bFailed = !cMask.IsValid();
+		for (int y = 0; y < nHeight && !bFailed; y++)
+		{
+			for (int x = 0; x < nWidth; x++)
+			{
+				if (cMask.IsHit(x, y) != IsBlockVisible(pImage, nWidth, nHeight, x, y))
+				{
+					bFailed = true;
+				}
+			}
+		}
+
+		for (int nStep = 0; nStep < 8 && !bFailed; nStep++)
+		{
+			if (cRandom.Get() % 2)
+			{
+				// a partial paint, the buffer holds the bounds of the rect like berkelium sends it, the rect may stick out
+				const Berkelium::Rect cRect = MakeRect(cRandom.Get() % nWidth - 4, cRandom.Get() % nHeight - 4, 1 + cRandom.Get() % (nWidth / 2 + 8), 1 + cRandom.Get() % (nHeight / 2 + 8));
+				const Berkelium::Rect cBufferRect = TextureUploader::ClipRect(cRect, nWidth, nHeight);
+				if (cBufferRect.width() <= 0 || cBufferRect.height() <= 0)
+				{
+					continue;
+				}
+				for (int y = cBufferRect.top(); y < cBufferRect.bottom(); y++)
+				{
+					for (int x = cBufferRect.left(); x < cBufferRect.right(); x++)
+					{
+						const uint8 nAlpha = (cRandom.Get() % 4) ? 0 : uint8(cRandom.Get());
+						pImage[(size_t(y) * nWidth + x) * 4 + 3] = nAlpha;
+						pPaint[(size_t(y - cBufferRect.top()) * cBufferRect.width() + (x - cBufferRect.left())) * 4 + 3] = nAlpha;
+					}
+				}
+				cMask.Update(pPaint, cBufferRect, 1, &cRect);
+			}
+			else
+			{
+				// a scroll, the exposed pixels keep their old content like in the image
+				const Berkelium::Rect cScrollRect = MakeRect(cRandom.Get() % nWidth - 4, cRandom.Get() % nHeight - 4, 1 + cRandom.Get() % (nWidth + 8), 1 + cRandom.Get() % (nHeight + 8));
+				const int dx = (cRandom.Get() % 3) ? cRandom.Get() % (2 * nWidth + 1) - nWidth : 0;
+				const int dy = (cRandom.Get() % 3) ? cRandom.Get() % (2 * nHeight + 1) - nHeight : 0;
+				BufferCopy::ScrollRect(pImage, nWidth, nHeight, dx, dy, cScrollRect);
+				cMask.Scroll(dx, dy, cScrollRect);
+			}
+
+			// a visible pixel must never let the mouse through
+			for (int y = 0; y < nHeight && !bFailed; y++)
+			{
+				for (int x = 0; x < nWidth; x++)
+				{
+					if (pImage[(size_t(y) * nWidth + x) * 4 + 3] > CLICKTHROUGHALPHA && !cMask.IsHit(x, y))
+					{
+						bFailed = true;
+					}
+				}
+			}
+		}
+
+		if (bFailed)
+		{
+			nNumOfFailures++;
+		}
+
+		delete [] pImage;
+		delete [] pPaint;
+	}
+	return nNumOfFailures;
+}
+
+
+};
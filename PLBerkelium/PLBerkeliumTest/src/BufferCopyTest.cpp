@@ -0,0 +1,224 @@
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/Core/MemoryManager.h>
+#include <PLCore/System/System.h>
+#include <PLBerkelium/BufferCopy.h>
+
+#include "Random.h"
+#include "Tests.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLBerkelium;
+
+namespace PLBerkeliumTest {
+
+
+//[-------------------------------------------------------]
+//[ Internal helpers                                      ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    The row by row copy the copy kernel replaced
+*/
+static void LegacyCopyRects(uint8 *pImageBuffer, int nWidth, const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, size_t numCopyRects, const Berkelium::Rect *copyRects)
+{
+	for (size_t i = 0; i < numCopyRects; i++)
+	{
+		const int nCrTop = copyRects[i].top() - sourceBufferRect.top();
+		const int nCrLeft = copyRects[i].left() - sourceBufferRect.left();
+		for (int nRow = 0; nRow < copyRects[i].height(); nRow++)
+		{
+			const int nStartPosition = nWidth * (copyRects[i].top() + nRow) + copyRects[i].left();
+			MemoryManager::Copy(&pImageBuffer[nStartPosition * 4], sourceBuffer + (nCrLeft + (nRow + nCrTop) * sourceBufferRect.width()) * 4, copyRects[i].width() * 4);
+		}
+	}
+}
+
+
+//[-------------------------------------------------------]
+//[ Functions                                             ]
+//[-------------------------------------------------------]
+String BenchmarkBufferCopy(uint32 nIterations)
+{
+	static const int nSizes[3][2] = { { 1280, 720 }, { 1920, 1080 }, { 3840, 2160 } };
+	static const char *szNames[3] = { "720p", "1080p", "4K" };
+
+	if (!nIterations)
+	{
+		nIterations = 1;
+	}
+
+	String sReport = "Copy kernel: " + BufferCopy::GetInstructionSet() + "\n";
+	for (int nSize = 0; nSize < 3; nSize++)
+	{
+		const int nWidth  = nSizes[nSize][0];
+		const int nHeight = nSizes[nSize][1];
+		uint8 *pSource      = new uint8[nWidth * nHeight * 4];
+		uint8 *pDestination = new uint8[nWidth * nHeight * 4];
+		MemoryManager::Set(pSource, 0x7f, nWidth * nHeight * 4);
+
+		// a full frame and a grid of 8x8 rects covering the frame
+		Berkelium::Rect cFullRect;
+		cFullRect.mLeft   = 0;
+		cFullRect.mTop    = 0;
+		cFullRect.mWidth  = nWidth;
+		cFullRect.mHeight = nHeight;
+		Berkelium::Rect cGridRects[64];
+		for (int i = 0; i < 64; i++)
+		{
+			cGridRects[i].mLeft   = (i % 8) * (nWidth / 8);
+			cGridRects[i].mTop    = (i / 8) * (nHeight / 8);
+			cGridRects[i].mWidth  = nWidth / 8;
+			cGridRects[i].mHeight = nHeight / 8;
+		}
+
+		for (int nCase = 0; nCase < 2; nCase++)
+		{
+			const size_t nNumOfRects = nCase ? 64 : 1;
+			const Berkelium::Rect *pRects = nCase ? cGridRects : &cFullRect;
+
+			uint64 nStart = System::GetInstance()->GetMicroseconds();
+			for (uint32 i = 0; i < nIterations; i++)
+			{
+				LegacyCopyRects(pDestination, nWidth, pSource, cFullRect, nNumOfRects, pRects);
+			}
+			const uint64 nLegacy = (System::GetInstance()->GetMicroseconds() - nStart) / nIterations;
+
+			nStart = System::GetInstance()->GetMicroseconds();
+			for (uint32 i = 0; i < nIterations; i++)
+			{
+				BufferCopy::CopyRects(pDestination, nWidth, nHeight, pSource, cFullRect, nNumOfRects, pRects, false);
+			}
+			const uint64 nKernel = (System::GetInstance()->GetMicroseconds() - nStart) / nIterations;
+
+			nStart = System::GetInstance()->GetMicroseconds();
+			for (uint32 i = 0; i < nIterations; i++)
+			{
+				BufferCopy::CopyRects(pDestination, nWidth, nHeight, pSource, cFullRect, nNumOfRects, pRects, true);
+			}
+			const uint64 nKernelSwizzle = (System::GetInstance()->GetMicroseconds() - nStart) / nIterations;
+
+			sReport += String(szNames[nSize]) + (nCase ? " 64 rects" : " full") +
+					   ": legacy " + String(nLegacy) + " us, kernel " + String(nKernel) +
+					   " us, kernel with swizzle " + String(nKernelSwizzle) + " us\n";
+		}
+
+		delete [] pSource;
+		delete [] pDestination;
+	}
+	return sReport;
+}
+
+
+
+uint32 VerifyScroll(uint32 nIterations)
+{
+	uint32 nNumOfFailures = 0;
+	Random cRandom;
+	for (uint32 nIteration = 0; nIteration < nIterations; nIteration++)
+	{
+		const int nWidth  = 1 + cRandom.Get() % 96;
+		const int nHeight = 1 + cRandom.Get() % 96;
+		const size_t nSize = size_t(nWidth) * size_t(nHeight) * 4;
+
+		// the scroll rect may stick out of the image
+		Berkelium::Rect cScrollRect;
+		cScrollRect.mLeft   = cRandom.Get() % nWidth - 4;
+		cScrollRect.mTop    = cRandom.Get() % nHeight - 4;
+		cScrollRect.mWidth  = 1 + cRandom.Get() % (nWidth + 8);
+		cScrollRect.mHeight = 1 + cRandom.Get() % (nHeight + 8);
+		const int dx = (cRandom.Get() % 3) ? cRandom.Get() % (2 * nWidth + 1) - nWidth : 0;
+		const int dy = (cRandom.Get() % 3) ? cRandom.Get() % (2 * nHeight + 1) - nHeight : 0;
+
+		// the old frame and the new frame berkelium renders
+		uint8 *pOld       = new uint8[nSize];
+		uint8 *pNew       = new uint8[nSize];
+		uint8 *pImage     = new uint8[nSize];
+		uint8 *pReference = new uint8[nSize];
+		for (size_t i = 0; i < nSize; i++)
+		{
+			pOld[i] = uint8(cRandom.Get());
+			pNew[i] = uint8(cRandom.Get());
+		}
+		MemoryManager::Copy(pImage, pOld, uint32(nSize));
+
+		// full copy reference: inside the clipped scroll rect every pixel either comes from the old frame or is exposed
+		MemoryManager::Copy(pReference, pOld, uint32(nSize));
+		const int nLeft   = cScrollRect.left()   < 0       ? 0       : cScrollRect.left();
+		const int nTop    = cScrollRect.top()    < 0       ? 0       : cScrollRect.top();
+		const int nRight  = cScrollRect.right()  > nWidth  ? nWidth  : cScrollRect.right();
+		const int nBottom = cScrollRect.bottom() > nHeight ? nHeight : cScrollRect.bottom();
+		for (int y = nTop; y < nBottom; y++)
+		{
+			for (int x = nLeft; x < nRight; x++)
+			{
+				const int nSourceX = x - dx;
+				const int nSourceY = y - dy;
+				const uint8 *pPixel = (nSourceX >= nLeft && nSourceX < nRight && nSourceY >= nTop && nSourceY < nBottom) ? &pOld[(size_t(nSourceY) * nWidth + nSourceX) * 4] : &pNew[(size_t(y) * nWidth + x) * 4];
+				MemoryManager::Copy(&pReference[(size_t(y) * nWidth + x) * 4], pPixel, 4);
+			}
+		}
+
+		// scroll engine followed by the exposed strips as copy rects
+		BufferCopy::ScrollRect(pImage, nWidth, nHeight, dx, dy, cScrollRect);
+		Berkelium::Rect cFullRect;
+		cFullRect.mLeft   = 0;
+		cFullRect.mTop    = 0;
+		cFullRect.mWidth  = nWidth;
+		cFullRect.mHeight = nHeight;
+		Berkelium::Rect cExposedRects[2];
+		cExposedRects[0].mLeft   = nLeft;
+		cExposedRects[0].mWidth  = nRight - nLeft;
+		cExposedRects[0].mTop    = (dy > 0) ? nTop : nBottom + dy;
+		cExposedRects[0].mHeight = (dy > 0) ? dy : -dy;
+		cExposedRects[1].mTop    = nTop;
+		cExposedRects[1].mHeight = nBottom - nTop;
+		cExposedRects[1].mLeft   = (dx > 0) ? nLeft : nRight + dx;
+		cExposedRects[1].mWidth  = (dx > 0) ? dx : -dx;
+		for (int i = 0; i < 2; i++)
+		{
+			// limit the strips to the clipped scroll rect
+			if (cExposedRects[i].mTop < nTop)
+			{
+				cExposedRects[i].mHeight -= nTop - cExposedRects[i].mTop;
+				cExposedRects[i].mTop = nTop;
+			}
+			if (cExposedRects[i].mLeft < nLeft)
+			{
+				cExposedRects[i].mWidth -= nLeft - cExposedRects[i].mLeft;
+				cExposedRects[i].mLeft = nLeft;
+			}
+			if (cExposedRects[i].bottom() > nBottom)
+			{
+				cExposedRects[i].mHeight = nBottom - cExposedRects[i].mTop;
+			}
+			if (cExposedRects[i].right() > nRight)
+			{
+				cExposedRects[i].mWidth = nRight - cExposedRects[i].mLeft;
+			}
+			if (cExposedRects[i].mWidth > 0 && cExposedRects[i].mHeight > 0)
+			{
+				BufferCopy::CopyRect(pImage, nWidth, nHeight, pNew, cFullRect, cExposedRects[i], false);
+			}
+		}
+
+		if (MemoryManager::Compare(pImage, pReference, uint32(nSize)))
+		{
+			nNumOfFailures++;
+		}
+
+		delete [] pOld;
+		delete [] pNew;
+		delete [] pImage;
+		delete [] pReference;
+	}
+	return nNumOfFailures;
+}
+
+
+};
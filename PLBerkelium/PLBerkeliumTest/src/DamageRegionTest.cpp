@@ -0,0 +1,262 @@
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/Core/MemoryManager.h>
+#include <PLCore/System/System.h>
+#include <PLBerkelium/DamageRegion.h>
+#include <PLBerkelium/TextureUploader.h>
+
+#include "Random.h"
+#include "Tests.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLBerkelium;
+
+namespace PLBerkeliumTest {
+
+
+//[-------------------------------------------------------]
+//[ Internal helpers                                      ]
+//[-------------------------------------------------------]
+static inline uint64 GetRectArea(const Berkelium::Rect &cRect)
+{
+	return uint64(cRect.width()) * uint64(cRect.height());
+}
+
+
+static inline Berkelium::Rect MakeRect(int nLeft, int nTop, int nWidth, int nHeight)
+{
+	Berkelium::Rect cRect;
+	cRect.mLeft   = nLeft;
+	cRect.mTop    = nTop;
+	cRect.mWidth  = nWidth;
+	cRect.mHeight = nHeight;
+	return cRect;
+}
+
+
+/**
+*  @brief
+*    Returns the rects of one frame of a benchmark paint stream at 1080p
+*/
+static size_t GetStreamRects(int nStream, uint32 nFrame, Berkelium::Rect *pRects, Random &cRandom)
+{
+	size_t nNumOfRects = 0;
+	switch (nStream)
+	{
+		case 0:
+			// a blinking caret
+			pRects[nNumOfRects++] = MakeRect(960, 500, 2, 18);
+			break;
+
+		case 1:
+		{
+			// typing, the new glyph and the caret moving over by one glyph
+			const int nX = 400 + 9 * int(nFrame % 100);
+			pRects[nNumOfRects++] = MakeRect(nX, 500, 9, 18);
+			pRects[nNumOfRects++] = MakeRect(nX, 500, 2, 18);
+			pRects[nNumOfRects++] = MakeRect(nX + 9, 500, 2, 18);
+			break;
+		}
+
+		case 2:
+		{
+			// a page scrolled on the GPU, the exposed strip and the scroll bar thumb
+			const int nThumb = 100 + int(nFrame % 800);
+			pRects[nNumOfRects++] = MakeRect(0, 1040, 1904, 40);
+			pRects[nNumOfRects++] = MakeRect(1904, nThumb, 16, 120);
+			pRects[nNumOfRects++] = MakeRect(1904, nThumb + 4, 16, 120);
+			break;
+		}
+
+		case 3:
+		{
+			// hover effects following the mouse, the old and new button, a tool tip and the cursor
+			const int nX = 100 + int((nFrame * 37) % 1600);
+			const int nY = 200 + int((nFrame * 13) % 600);
+			pRects[nNumOfRects++] = MakeRect(nX, nY, 120, 32);
+			pRects[nNumOfRects++] = MakeRect(nX + 100, nY, 120, 32);
+			pRects[nNumOfRects++] = MakeRect(nX + 20, nY + 40, 200, 24);
+			pRects[nNumOfRects++] = MakeRect(nX + 60, nY + 10, 16, 16);
+			break;
+		}
+
+		case 4:
+			// text reflow, one rect per line of a paragraph
+			for (int i = 0; i < 40; i++)
+			{
+				pRects[nNumOfRects++] = MakeRect(300, 300 + 18 * i, 600 - 7 * (i % 5), 18);
+			}
+			break;
+
+		case 5:
+			// an animated page, scattered sprites
+			for (int i = 0; i < 24; i++)
+			{
+				pRects[nNumOfRects++] = MakeRect(cRandom.Get() % 1900, cRandom.Get() % 1060, 16 + cRandom.Get() % 80, 16 + cRandom.Get() % 80);
+			}
+			break;
+	}
+	return nNumOfRects;
+}
+
+
+//[-------------------------------------------------------]
+//[ Functions                                             ]
+//[-------------------------------------------------------]
+uint32 VerifyDamageRegion(uint32 nIterations)
+{
+	uint32 nNumOfFailures = 0;
+	DamageRegion cRegion;
+	Random cRandom;
+	for (uint32 nIteration = 0; nIteration < nIterations; nIteration++)
+	{
+		const int nWidth  = 1 + cRandom.Get() % 96;
+		const int nHeight = 1 + cRandom.Get() % 96;
+		const uint32 nSize = uint32(nWidth * nHeight);
+		uint8 *pAdded   = new uint8[nSize];
+		uint8 *pCovered = new uint8[nSize];
+
+		for (int nMode = 0; nMode < 2; nMode++)
+		{
+			cRegion.SetSize(nWidth, nHeight);
+			cRegion.Clear();
+			cRegion.SetExact(nMode == 0);
+			cRegion.SetCallCost(uint32(cRandom.Get() % 256));
+			MemoryManager::Set(pAdded, 0, nSize);
+			MemoryManager::Set(pCovered, 0, nSize);
+
+			// no more rects than the region holds, so it never has to merge at a loss
+			bool bFailed = false;
+			uint64 nAddedCost = 0;
+			const int nNumOfRects = 1 + cRandom.Get() % MAXDAMAGERECTS;
+			for (int i = 0; i < nNumOfRects; i++)
+			{
+				// the rect may stick out of the surface
+				const Berkelium::Rect cRect = MakeRect(cRandom.Get() % nWidth - 4, cRandom.Get() % nHeight - 4, 1 + cRandom.Get() % (nWidth / 2 + 8), 1 + cRandom.Get() % (nHeight / 2 + 8));
+				if (!cRegion.Add(cRect))
+				{
+					bFailed = true;
+				}
+
+				const Berkelium::Rect cClippedRect = TextureUploader::ClipRect(cRect, nWidth, nHeight);
+				if (cClippedRect.width() > 0 && cClippedRect.height() > 0)
+				{
+					nAddedCost += GetRectArea(cClippedRect) + cRegion.GetCallCost();
+					for (int y = cClippedRect.top(); y < cClippedRect.bottom(); y++)
+					{
+						MemoryManager::Set(&pAdded[y * nWidth + cClippedRect.left()], 1, uint32(cClippedRect.width()));
+					}
+				}
+			}
+
+			// the rects have to stay inside the surface
+			for (uint32 i = 0; i < cRegion.GetNumOfRects() && !bFailed; i++)
+			{
+				const Berkelium::Rect &cRect = cRegion.GetRects()[i];
+				if (cRect.left() < 0 || cRect.top() < 0 || cRect.right() > nWidth || cRect.bottom() > nHeight || cRect.width() <= 0 || cRect.height() <= 0)
+				{
+					bFailed = true;
+				}
+				else
+				{
+					for (int y = cRect.top(); y < cRect.bottom(); y++)
+					{
+						MemoryManager::Set(&pCovered[y * nWidth + cRect.left()], 1, uint32(cRect.width()));
+					}
+				}
+			}
+
+			// every added pixel is covered, in exact mode nothing else
+			for (uint32 i = 0; i < nSize && !bFailed; i++)
+			{
+				if ((pAdded[i] && !pCovered[i]) || (cRegion.IsExact() && pCovered[i] && !pAdded[i]))
+				{
+					bFailed = true;
+				}
+			}
+
+			// coalescing never makes the upload more expensive
+			if (cRegion.GetCost() > nAddedCost)
+			{
+				bFailed = true;
+			}
+
+			if (bFailed)
+			{
+				nNumOfFailures++;
+			}
+		}
+
+		delete [] pAdded;
+		delete [] pCovered;
+	}
+	return nNumOfFailures;
+}
+
+
+String BenchmarkDamageRegion(uint32 nIterations)
+{
+	static const char *szNames[6] = { "caret", "typing", "scrolling", "hover", "text reflow", "animated" };
+	static const uint32 nNumOfFrames = 240;
+
+	if (!nIterations)
+	{
+		nIterations = 1;
+	}
+
+	DamageRegion cRegion;
+	cRegion.SetSize(1920, 1080);
+	String sReport = "Damage region at 1080p, call cost " + String(cRegion.GetCallCost()) + " pixels, " + String(nNumOfFrames) + " frames per stream\n";
+	Berkelium::Rect cRects[64];
+	for (int nStream = 0; nStream < 6; nStream++)
+	{
+		// the stream as sent, each rect uploaded on its own
+		uint64 nRawRects = 0;
+		uint64 nRawCost  = 0;
+		Random cRandom;
+		for (uint32 nFrame = 0; nFrame < nNumOfFrames; nFrame++)
+		{
+			const size_t nNumOfRects = GetStreamRects(nStream, nFrame, cRects, cRandom);
+			for (size_t i = 0; i < nNumOfRects; i++)
+			{
+				nRawCost += GetRectArea(TextureUploader::ClipRect(cRects[i], 1920, 1080)) + cRegion.GetCallCost();
+			}
+			nRawRects += nNumOfRects;
+		}
+
+		// the same stream coalesced per frame
+		uint64 nRects = 0;
+		uint64 nCost  = 0;
+		uint64 nTime  = 0;
+		for (uint32 nIteration = 0; nIteration < nIterations; nIteration++)
+		{
+			cRandom = Random();
+			for (uint32 nFrame = 0; nFrame < nNumOfFrames; nFrame++)
+			{
+				const size_t nNumOfRects = GetStreamRects(nStream, nFrame, cRects, cRandom);
+				const uint64 nStart = System::GetInstance()->GetMicroseconds();
+				cRegion.Clear();
+				cRegion.Add(nNumOfRects, cRects);
+				nTime += System::GetInstance()->GetMicroseconds() - nStart;
+				if (nIteration == 0)
+				{
+					nRects += cRegion.GetNumOfRects();
+					nCost  += cRegion.GetCost();
+				}
+			}
+		}
+
+		sReport += String(szNames[nStream]) + ": " + String(nRawRects) + " rects, cost " + String(nRawCost) +
+				   " -> " + String(nRects) + " rects, cost " + String(nCost) +
+				   ", " + String(float(double(nTime) / double(nIterations) / double(nNumOfFrames))) + " us per frame\n";
+	}
+	return sReport;
+}
+
+
+};
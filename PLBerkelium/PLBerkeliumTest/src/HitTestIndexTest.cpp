@@ -0,0 +1,194 @@
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/System/System.h>
+#include <PLCore/Container/List.h>
+#include <PLCore/Container/Iterator.h>
+#include <PLBerkelium/HitTestIndex.h>
+
+#include "Random.h"
+#include "Tests.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLMath;
+using namespace PLBerkelium;
+
+namespace PLBerkeliumTest {
+
+
+//[-------------------------------------------------------]
+//[ Internal helpers                                      ]
+//[-------------------------------------------------------]
+struct sBenchmarkWindow
+{
+	int nX, nY, nWidth, nHeight;
+	int nWidgetX, nWidgetY, nWidgetWidth, nWidgetHeight;
+};
+
+
+static inline bool IsInside(const Vector2i &vPosition, const int &nX, const int &nY, const int &nWidth, const int &nHeight)
+{
+	return (vPosition.x > nX && vPosition.y > nY && vPosition.x < nX + nWidth && vPosition.y < nY + nHeight);
+}
+
+
+static const sBenchmarkWindow *GetTopMostByLists(sBenchmarkWindow *psWindows, uint32 nNumOfWindows, const Vector2i &vPosition)
+{
+	// the former path, two lists per mouse event
+	List<sBenchmarkWindow*> *plstEnabledWindows = new List<sBenchmarkWindow*>;
+	for (uint32 i = 0; i < nNumOfWindows; i++)
+	{
+		plstEnabledWindows->Add(&psWindows[i]);
+	}
+
+	List<sBenchmarkWindow*> *plstMouseOverWindows = new List<sBenchmarkWindow*>;
+	Iterator<sBenchmarkWindow*> cIterator = plstEnabledWindows->GetIterator();
+	while (cIterator.HasNext())
+	{
+		sBenchmarkWindow *psWindow = cIterator.Next();
+		if (IsInside(vPosition, psWindow->nX, psWindow->nY, psWindow->nWidth, psWindow->nHeight) ||
+			IsInside(vPosition, psWindow->nWidgetX, psWindow->nWidgetY, psWindow->nWidgetWidth, psWindow->nWidgetHeight))
+		{
+			plstMouseOverWindows->Add(psWindow);
+		}
+	}
+
+	// the z-order was a linear search per candidate
+	const sBenchmarkWindow *psTopMostWindow = nullptr;
+	int nHigherIndex = -1;
+	Iterator<sBenchmarkWindow*> cOverIterator = plstMouseOverWindows->GetIterator();
+	while (cOverIterator.HasNext())
+	{
+		const sBenchmarkWindow *psWindow = cOverIterator.Next();
+		for (uint32 i = 0; i < nNumOfWindows; i++)
+		{
+			if (&psWindows[i] == psWindow)
+			{
+				if (int(i) > nHigherIndex)
+				{
+					nHigherIndex = int(i);
+					psTopMostWindow = psWindow;
+				}
+				break;
+			}
+		}
+	}
+
+	delete plstMouseOverWindows;
+	delete plstEnabledWindows;
+	return psTopMostWindow;
+}
+
+
+static inline void DragBenchmarkWindow(sBenchmarkWindow &sWindow, const int &nX, const uint32 &nFrame)
+{
+	sWindow.nX = nX + int(nFrame % 200) - 100;
+}
+
+
+//[-------------------------------------------------------]
+//[ Functions                                             ]
+//[-------------------------------------------------------]
+String BenchmarkHitTestIndex(uint32 nIterations)
+{
+	static const uint32 nNumOfWindows = 200;
+	static const uint32 nQueriesPerSecond = 1000;
+	static const uint32 nQueriesPerFrame = 16;
+
+	if (!nIterations)
+	{
+		nIterations = 1;
+	}
+
+	// random windows on a 1080p screen, every fourth has a widget hanging out of it (e.g. an open select box)
+	sBenchmarkWindow sWindows[nNumOfWindows];
+	Random cRandom;
+	for (uint32 i = 0; i < nNumOfWindows; i++)
+	{
+		sBenchmarkWindow &sWindow = sWindows[i];
+		sWindow.nWidth  = 160 + cRandom.Get() % 480;
+		sWindow.nHeight = 120 + cRandom.Get() % 360;
+		sWindow.nX = cRandom.Get() % (1920 - sWindow.nWidth);
+		sWindow.nY = cRandom.Get() % (1080 - sWindow.nHeight);
+		sWindow.nWidgetX = sWindow.nX + cRandom.Get() % sWindow.nWidth;
+		sWindow.nWidgetY = sWindow.nY + sWindow.nHeight/2;
+		sWindow.nWidgetWidth  = (i % 4) ? 0 : 120;
+		sWindow.nWidgetHeight = (i % 4) ? 0 : 200;
+	}
+
+	// the front window is dragged at 60 Hz, so there are 16 mouse events per frame
+	sBenchmarkWindow &sFrontWindow = sWindows[nNumOfWindows - 1];
+	const int nFrontX = sFrontWindow.nX;
+
+	HitTestIndex cIndex;
+	Vector2i vPositions[nQueriesPerSecond];
+	const void *pListResults[nQueriesPerSecond];
+	const void *pIndexResults[nQueriesPerSecond];
+	Vector2i vPosition(960, 540);
+	uint64 nListTime = 0;
+	uint64 nIndexTime = 0;
+	uint32 nMismatches = 0;
+	for (uint32 nSecond = 0; nSecond < nIterations; nSecond++)
+	{
+		// a random walk of the mouse, one position per millisecond
+		for (uint32 i = 0; i < nQueriesPerSecond; i++)
+		{
+			vPosition.x += cRandom.Get() % 33 - 16;
+			vPosition.y += cRandom.Get() % 33 - 16;
+			vPosition.x = (vPosition.x < 0) ? 0 : ((vPosition.x > 1919) ? 1919 : vPosition.x);
+			vPosition.y = (vPosition.y < 0) ? 0 : ((vPosition.y > 1079) ? 1079 : vPosition.y);
+			vPositions[i] = vPosition;
+		}
+
+		uint64 nStart = System::GetInstance()->GetMicroseconds();
+		for (uint32 i = 0; i < nQueriesPerSecond; i++)
+		{
+			if (i % nQueriesPerFrame == 0)
+			{
+				DragBenchmarkWindow(sFrontWindow, nFrontX, (nSecond*nQueriesPerSecond + i)/nQueriesPerFrame);
+			}
+			pListResults[i] = GetTopMostByLists(sWindows, nNumOfWindows, vPositions[i]);
+		}
+		nListTime += System::GetInstance()->GetMicroseconds() - nStart;
+
+		// the drag invalidates the index, it is rebuilt before the next hit test
+		nStart = System::GetInstance()->GetMicroseconds();
+		for (uint32 i = 0; i < nQueriesPerSecond; i++)
+		{
+			if (i % nQueriesPerFrame == 0)
+			{
+				DragBenchmarkWindow(sFrontWindow, nFrontX, (nSecond*nQueriesPerSecond + i)/nQueriesPerFrame);
+				cIndex.Clear();
+				for (uint32 nWindow = 0; nWindow < nNumOfWindows; nWindow++)
+				{
+					sBenchmarkWindow &sWindow = sWindows[nWindow];
+					cIndex.Add(&sWindow, int(nWindow), sWindow.nX, sWindow.nY, sWindow.nWidth, sWindow.nHeight);
+					cIndex.Add(&sWindow, int(nWindow), sWindow.nWidgetX, sWindow.nWidgetY, sWindow.nWidgetWidth, sWindow.nWidgetHeight);
+				}
+			}
+			pIndexResults[i] = cIndex.Get(vPositions[i]);
+		}
+		nIndexTime += System::GetInstance()->GetMicroseconds() - nStart;
+
+		for (uint32 i = 0; i < nQueriesPerSecond; i++)
+		{
+			if (pIndexResults[i] != pListResults[i])
+			{
+				nMismatches++;
+			}
+		}
+	}
+
+	const double fNumOfQueries = double(nIterations) * double(nQueriesPerSecond);
+	return "Hit test, " + String(nNumOfWindows) + " windows (" + String(cIndex.GetNumOfRects()) + " rects), 1 kHz mouse for " + String(nIterations) + " seconds\n" +
+		   "lists: " + String(float(double(nListTime) / fNumOfQueries)) + " us per event, 2 allocations per event\n" +
+		   "index: " + String(float(double(nIndexTime) / fNumOfQueries)) + " us per event including " + String(cIndex.GetStats().nRebuilds) + " rebuilds, no allocations per event\n" +
+		   "mismatches: " + String(nMismatches) + "\n";
+}
+
+
+};
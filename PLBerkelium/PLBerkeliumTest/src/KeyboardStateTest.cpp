@@ -0,0 +1,168 @@
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLBerkelium/KeyboardState.h>
+
+#include "Random.h"
+#include "Tests.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLBerkelium;
+
+namespace PLBerkeliumTest {
+
+
+//[-------------------------------------------------------]
+//[ Functions                                             ]
+//[-------------------------------------------------------]
+uint32 VerifyKeyboardState(uint32 nIterations)
+{
+	// a few text keys, a few keys that type nothing and shift, control and a second key holding the same modifier
+	static const int nCodes[] = { 0x41, 0x42, 0x43, 0x20, 0x25, 0x26, 0x2E, 0x70, 0x10, 0x11, 0x5B, 0x5C };
+	static const int nModifiers[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 8, 8 };
+	static const char nTexts[] = { 'a', 'b', 'c', ' ', 0, 0, 0, 0, 0, 0, 0, 0 };
+	const uint32 nNumOfCodes = sizeof(nCodes)/sizeof(int);
+
+	uint32 nNumOfFailures = 0;
+	Random cRandom;
+	for (uint32 nIteration = 0; nIteration < nIterations; nIteration++)
+	{
+		KeyboardState cKeyboard;
+		const uint32 nDelay = uint32(cRandom.Get() % 600);
+		const uint32 nInterval = 1 + uint32(cRandom.Get() % 100);
+		cKeyboard.SetRepeat(nDelay, nInterval);
+
+		// the plain timer of every key, 0 if it does not repeat
+		bool bDown[sizeof(nCodes)/sizeof(int)];
+		uint64 nDueTimes[sizeof(nCodes)/sizeof(int)];
+		int nTextRepeat = -1;
+		for (uint32 i = 0; i < nNumOfCodes; i++)
+		{
+			bDown[i] = false;
+			nDueTimes[i] = 0;
+		}
+
+		uint64 nTime = 1 + uint64(cRandom.Get() % 100000);
+		bool bFailed = false;
+		for (uint32 nStep = 0; nStep < 400 && !bFailed; nStep++)
+		{
+			// frames of a few milliseconds, now and then a stall
+			nTime += (cRandom.Get() % 50 == 0) ? uint64(cRandom.Get() % 3000) : uint64(cRandom.Get() % 40);
+
+			const uint32 nIndex = uint32(cRandom.Get()) % nNumOfCodes;
+			const int nAction = cRandom.Get() % 4;
+			if (nAction == 0)
+			{
+				const bool bPressed = cKeyboard.Press(nCodes[nIndex], nModifiers[nIndex], nTexts[nIndex], false, nTime);
+				if (bPressed == bDown[nIndex])
+				{
+					bFailed = true;
+				}
+				if (!bDown[nIndex])
+				{
+					bDown[nIndex] = true;
+					if (!nModifiers[nIndex])
+					{
+						if (nTexts[nIndex])
+						{
+							if (nTextRepeat >= 0)
+							{
+								nDueTimes[nTextRepeat] = 0;
+							}
+							nTextRepeat = int(nIndex);
+						}
+						nDueTimes[nIndex] = nTime + nDelay;
+					}
+				}
+			}
+			else if (nAction == 1)
+			{
+				if (cKeyboard.Release(nCodes[nIndex]) != bDown[nIndex])
+				{
+					bFailed = true;
+				}
+				bDown[nIndex] = false;
+				nDueTimes[nIndex] = 0;
+				if (nTextRepeat == int(nIndex))
+				{
+					nTextRepeat = -1;
+				}
+			}
+			else if (nAction == 2 && cRandom.Get() % 20 == 0)
+			{
+				cKeyboard.StopRepeats();
+				for (uint32 i = 0; i < nNumOfCodes; i++)
+				{
+					nDueTimes[i] = 0;
+				}
+				nTextRepeat = -1;
+			}
+			else
+			{
+				// every due key repeats exactly once
+				bool bRepeated[sizeof(nCodes)/sizeof(int)];
+				for (uint32 i = 0; i < nNumOfCodes; i++)
+				{
+					bRepeated[i] = false;
+				}
+				const uint32 nNumOfRepeats = cKeyboard.Update(nTime);
+				for (uint32 i = 0; i < nNumOfRepeats; i++)
+				{
+					uint32 nRepeatIndex = 0;
+					while (nRepeatIndex < nNumOfCodes && nCodes[nRepeatIndex] != cKeyboard.GetRepeat(i))
+					{
+						nRepeatIndex++;
+					}
+					if (nRepeatIndex == nNumOfCodes || bRepeated[nRepeatIndex])
+					{
+						bFailed = true;
+					}
+					else
+					{
+						bRepeated[nRepeatIndex] = true;
+					}
+				}
+				for (uint32 i = 0; i < nNumOfCodes; i++)
+				{
+					const bool bDue = (nDueTimes[i] && nDueTimes[i] <= nTime);
+					if (bDue != bRepeated[i])
+					{
+						bFailed = true;
+					}
+					if (bDue)
+					{
+						nDueTimes[i] = (nDueTimes[i] + nInterval <= nTime) ? nTime + nInterval : nDueTimes[i] + nInterval;
+					}
+				}
+			}
+
+			// the modifiers and the held keys follow the presses and releases
+			int nExpectedModifiers = 0;
+			uint32 nExpectedHeldKeys = 0;
+			for (uint32 i = 0; i < nNumOfCodes; i++)
+			{
+				if (bDown[i])
+				{
+					nExpectedModifiers |= nModifiers[i];
+					nExpectedHeldKeys++;
+				}
+			}
+			if (cKeyboard.GetModifiers() != nExpectedModifiers || cKeyboard.GetNumOfHeldKeys() != nExpectedHeldKeys)
+			{
+				bFailed = true;
+			}
+		}
+		if (bFailed)
+		{
+			nNumOfFailures++;
+		}
+	}
+	return nNumOfFailures;
+}
+
+
+};
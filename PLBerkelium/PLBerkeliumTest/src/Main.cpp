@@ -0,0 +1,70 @@
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/Main.h>
+#include <PLCore/System/System.h>
+#include <PLCore/System/Console.h>
+
+#include "Tests.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLBerkeliumTest;
+
+
+//[-------------------------------------------------------]
+//[ Program entry point                                   ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Runs the verifications and benchmarks of the PLBerkelium building blocks
+*
+*  @return
+*    number of failed verifications, 0 if everything is fine
+*/
+int PLMain(const String &sExecutableFilename, const Array<String> &lstArguments)
+{
+	const Console &cConsole = System::GetInstance()->GetConsole();
+	uint32 nNumOfFailedTests = 0;
+
+	cConsole.Print("Buffer copy benchmark, 50 iterations\n");
+	cConsole.Print(BenchmarkBufferCopy(50));
+
+	uint32 nNumOfFailures = VerifyScroll(1000);
+	cConsole.Print("Scroll verification: " + String(nNumOfFailures) + " of 1000 randomized scrolls differ from the reference\n");
+	if (nNumOfFailures)
+	{
+		nNumOfFailedTests++;
+	}
+
+	nNumOfFailures = VerifyDamageRegion(1000);
+	cConsole.Print("Damage region verification: " + String(nNumOfFailures) + " of 1000 randomized regions failed\n");
+	if (nNumOfFailures)
+	{
+		nNumOfFailedTests++;
+	}
+	cConsole.Print(BenchmarkDamageRegion(100));
+
+	cConsole.Print("Hit test benchmark, 10 simulated seconds\n");
+	cConsole.Print(BenchmarkHitTestIndex(10));
+
+	nNumOfFailures = VerifyAlphaMask(1000);
+	cConsole.Print("Alpha mask verification: " + String(nNumOfFailures) + " of 1000 randomized masks failed\n");
+	if (nNumOfFailures)
+	{
+		nNumOfFailedTests++;
+	}
+
+	nNumOfFailures = VerifyKeyboardState(1000);
+	cConsole.Print("Keyboard state verification: " + String(nNumOfFailures) + " of 1000 randomized key sequences failed\n");
+	if (nNumOfFailures)
+	{
+		nNumOfFailedTests++;
+	}
+
+	cConsole.Print(String(nNumOfFailedTests) + " verifications failed\n");
+	return int(nNumOfFailedTests);
+}
@@ -0,0 +1,73 @@
+#ifndef __PLBERKELIUMTEST_RANDOM_H__
+#define __PLBERKELIUMTEST_RANDOM_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkeliumTest {
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Pseudo random numbers of one test
+*
+*  @remarks
+*    Every test owns its generator, so the sequence does not depend on the order the tests run in and the global
+*    state of rand() is left alone. The same seed gives the same sequence on every platform.
+*/
+class Random {
+
+
+	public:
+		/**
+		*  @brief
+		*    Constructor
+		*
+		*  @param[in] PLCore::uint32 nSeed
+		*    start of the sequence, 0 is taken as 1
+		*/
+		Random(PLCore::uint32 nSeed = 1) :
+			m_nState(nSeed ? nSeed : 1)
+		{
+		}
+
+		/**
+		*  @brief
+		*    Returns the next number of the sequence
+		*
+		*  @return
+		*    number from 0 to 0x7fffffff, like rand() with a larger range
+		*/
+		int Get()
+		{
+			// xorshift, never reaches 0 from a state that is not 0
+			m_nState ^= m_nState << 13;
+			m_nState ^= m_nState >> 17;
+			m_nState ^= m_nState << 5;
+			return int(m_nState & 0x7fffffff);
+		}
+
+	protected:
+
+	private:
+		PLCore::uint32 m_nState;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUMTEST_RANDOM_H__
@@ -0,0 +1,128 @@
+#ifndef __PLBERKELIUMTEST_TESTS_H__
+#define __PLBERKELIUMTEST_TESTS_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+#include <PLCore/String/String.h>
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkeliumTest {
+
+
+//[-------------------------------------------------------]
+//[ Functions                                             ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Benchmarks the copy kernel against the plain row by row copy
+*
+*  @remarks
+*    Runs a full frame copy and a 64 rect copy at 720p, 1080p and 4K, with and without swizzle.
+*
+*  @param[in] PLCore::uint32 nIterations
+*
+*  @return
+*    human readable report, one line per measurement
+*/
+PLCore::String BenchmarkBufferCopy(PLCore::uint32 nIterations = 50);
+
+/**
+*  @brief
+*    Verifies the scroll engine against a full copy reference
+*
+*  @remarks
+*    Uses random image sizes, scroll rects (also partly outside the image) and (dx, dy),
+*    the exposed rects are applied as copy rects afterwards just like berkelium would send them.
+*
+*  @param[in] PLCore::uint32 nIterations
+*
+*  @return
+*    number of iterations where the result differed from the reference, 0 if everything is fine
+*/
+PLCore::uint32 VerifyScroll(PLCore::uint32 nIterations = 1000);
+
+/**
+*  @brief
+*    Verifies the damage region against a per pixel reference
+*
+*  @remarks
+*    Adds random rectangles (also partly outside the surface) in exact and in cost mode and checks that every
+*    added pixel is covered, that exact mode covers no other pixel, that rectangles stay inside the surface
+*    and that the region never costs more than the added rectangles.
+*
+*  @param[in] PLCore::uint32 nIterations
+*
+*  @return
+*    number of iterations that failed a check, 0 if everything is fine
+*/
+PLCore::uint32 VerifyDamageRegion(PLCore::uint32 nIterations = 1000);
+
+/**
+*  @brief
+*    Benchmarks the damage region on typical berkelium paint streams
+*
+*  @remarks
+*    The streams mimic what berkelium sends for a blinking caret, typing, a scrolling page, hover effects
+*    and an animated page at 1080p. For each stream the rectangles and upload cost are compared with
+*    and without coalescing, together with the time spent adding.
+*
+*  @param[in] PLCore::uint32 nIterations
+*
+*  @return
+*    human readable report, one line per stream
+*/
+PLCore::String BenchmarkDamageRegion(PLCore::uint32 nIterations = 100);
+
+/**
+*  @brief
+*    Benchmarks the hit test index against the former list based mouse over test
+*
+*  @remarks
+*    200 windows, some with a widget, are hit tested by a 1 kHz mouse while the front window is dragged
+*    at 60 Hz, so the index is rebuilt every 16 queries. Both tests have to find the same windows.
+*
+*  @param[in] PLCore::uint32 nIterations
+*    simulated seconds
+*
+*  @return
+*    report
+*/
+PLCore::String BenchmarkHitTestIndex(PLCore::uint32 nIterations = 10);
+
+/**
+*  @brief
+*    Verifies the alpha mask against the pixels on randomized paints and scrolls
+*
+*  @remarks
+*    Every visible pixel has to be a hit, after a full paint the mask has to match the blocks exactly.
+*
+*  @param[in] PLCore::uint32 nIterations
+*
+*  @return
+*    number of failed iterations
+*/
+PLCore::uint32 VerifyAlphaMask(PLCore::uint32 nIterations = 1000);
+
+/**
+*  @brief
+*    Verifies the key repeats against a plain per key timer on randomized presses, releases and frame times
+*
+*  @param[in] PLCore::uint32 nIterations
+*
+*  @return
+*    number of failed iterations
+*/
+PLCore::uint32 VerifyKeyboardState(PLCore::uint32 nIterations = 1000);
+
+
+};
+
+
+#endif // __PLBERKELIUMTEST_TESTS_H__
@@ -0,0 +1,150 @@
+#ifndef __PLBERKELIUM_ALPHAMASK_H__
+#define __PLBERKELIUM_ALPHAMASK_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+
+#include "berkelium/Rect.hpp"
+
+#include "PLBerkelium.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Defines                                               ]
+//[-------------------------------------------------------]
+#define ALPHAMASKSHIFT 2			/**< Log2 of the pixels along each side of the block one bit stands for, 4x4 blocks */
+#define CLICKTHROUGHALPHA 16		/**< Pixels with an alpha up to this let the mouse through to what is behind the window */
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    One bit per 4x4 block of a window that tells whether any pixel of the block is visible
+*
+*  @remarks
+*    The mask follows the paints of berkelium (see Update() and Scroll()), a hit test reads one bit and never touches
+*    the image or the texture. A block only partly covered by a paint or a scroll keeps its bit if it was set,
+*    so the mask may take the mouse on a few transparent pixels too many but never lets it through a visible one.
+*    Until a paint covered the whole surface the mask is not valid and every position is a hit.
+*/
+class AlphaMask {
+
+
+	public:
+		PLBERKELIUM_API AlphaMask();
+		PLBERKELIUM_API ~AlphaMask();
+
+		/**
+		*  @brief
+		*    Sets the size of the surface, the mask is cleared when the size changes
+		*
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*/
+		PLBERKELIUM_API void SetSize(const int &nWidth, const int &nHeight);
+
+		/**
+		*  @brief
+		*    Clears the mask, it is not valid until a paint covers the whole surface again
+		*/
+		PLBERKELIUM_API void Clear();
+
+		/**
+		*  @brief
+		*    Returns whether or not a paint covered the whole surface since the last clear
+		*
+		*  @return
+		*    'true' if valid, else 'false'
+		*/
+		PLBERKELIUM_API bool IsValid() const;
+
+		/**
+		*  @brief
+		*    Updates the blocks of the painted rectangles
+		*
+		*  @param[in] const PLCore::uint8 * pBuffer
+		*    BGRA or RGBA pixels of the buffer rectangle, the alpha is the fourth byte
+		*  @param[in] const Berkelium::Rect & cBufferRect
+		*    rectangle of the surface the buffer holds
+		*  @param[in] size_t nNumOfRects
+		*  @param[in] const Berkelium::Rect * pRects
+		*    painted rectangles of the surface, only the part within the buffer rectangle is read
+		*/
+		PLBERKELIUM_API void Update(const PLCore::uint8 *pBuffer, const Berkelium::Rect &cBufferRect, size_t nNumOfRects, const Berkelium::Rect *pRects);
+
+		/**
+		*  @brief
+		*    Moves the blocks of a scroll rectangle like BufferCopy::ScrollRect() moves the pixels
+		*
+		*  @param[in] int dx
+		*  @param[in] int dy
+		*  @param[in] const Berkelium::Rect & cScrollRect
+		*/
+		PLBERKELIUM_API void Scroll(int dx, int dy, const Berkelium::Rect &cScrollRect);
+
+		/**
+		*  @brief
+		*    Returns whether or not a position takes the mouse
+		*
+		*  @param[in] const int & nX
+		*  @param[in] const int & nY
+		*
+		*  @return
+		*    'true' if the block is visible, the mask is not valid or the position is outside the surface, else 'false'
+		*/
+		PLBERKELIUM_API bool IsHit(const int &nX, const int &nY) const;
+
+	protected:
+
+	private:
+		/**
+		*  @brief
+		*    Sets or clears the bit of a block
+		*
+		*  @param[in] PLCore::uint32 nBlockX
+		*  @param[in] PLCore::uint32 nBlockY
+		*  @param[in] bool bVisible
+		*/
+		void SetBlock(PLCore::uint32 nBlockX, PLCore::uint32 nBlockY, bool bVisible);
+
+		/**
+		*  @brief
+		*    Returns the bit of a block
+		*
+		*  @param[in] const PLCore::uint32 * pnBits
+		*  @param[in] PLCore::uint32 nBlockX
+		*  @param[in] PLCore::uint32 nBlockY
+		*
+		*  @return
+		*    'true' if visible, else 'false'
+		*/
+		bool GetBlock(const PLCore::uint32 *pnBits, PLCore::uint32 nBlockX, PLCore::uint32 nBlockY) const;
+
+		PLCore::uint32 *m_pnBits;		/**< Bits of the blocks, row by row */
+		PLCore::uint32 *m_pnScrollBits;	/**< Bits before a scroll, kept to not allocate on every scroll */
+		int m_nWidth;
+		int m_nHeight;
+		PLCore::uint32 m_nWordsPerRow;
+		PLCore::uint32 m_nNumOfWords;
+		bool m_bValid;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_ALPHAMASK_H__
@@ -0,0 +1,120 @@
+#ifndef __PLBERKELIUM_BUFFERCOPY_H__
+#define __PLBERKELIUM_BUFFERCOPY_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+#include <PLCore/String/String.h>
+
+#include "berkelium/Rect.hpp"
+
+#include "PLBerkelium.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Copy kernel for moving berkelium paint data into 32 bit image buffers
+*
+*  @remarks
+*    Every copy is clipped against the source buffer rectangle and the destination image.
+*    Berkelium paints BGRA, when swizzling is requested the kernel writes canonical RGBA in the same pass.
+*    The row kernel is specialized at compile time for the swizzle and instruction set (AVX2, SSE2 or scalar),
+*    the best instruction set supported by the CPU is picked once at runtime.
+*    The AVX2 kernel needs Visual Studio 2012 or later (or GCC), the Visual Studio 2010 toolchain of this project
+*    builds SSE2 and scalar only.
+*/
+class BufferCopy {
+
+
+	public:
+		/**
+		*  @brief
+		*    Copies a single rectangle from the source buffer into the destination image
+		*
+		*  @param[in] PLCore::uint8 * pDestination
+		*  @param[in] const int & nDestinationWidth
+		*  @param[in] const int & nDestinationHeight
+		*  @param[in] const unsigned char * sourceBuffer
+		*  @param[in] const Berkelium::Rect & sourceBufferRect
+		*  @param[in] const Berkelium::Rect & copyRect
+		*  @param[in] const bool & bSwizzle
+		*/
+		PLBERKELIUM_API static void CopyRect(PLCore::uint8 *pDestination, const int &nDestinationWidth, const int &nDestinationHeight, const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, const Berkelium::Rect &copyRect, const bool &bSwizzle);
+
+		/**
+		*  @brief
+		*    Copies a list of rectangles from the source buffer into the destination image
+		*
+		*  @param[in] PLCore::uint8 * pDestination
+		*  @param[in] const int & nDestinationWidth
+		*  @param[in] const int & nDestinationHeight
+		*  @param[in] const unsigned char * sourceBuffer
+		*  @param[in] const Berkelium::Rect & sourceBufferRect
+		*  @param[in] size_t numCopyRects
+		*  @param[in] const Berkelium::Rect * copyRects
+		*  @param[in] const bool & bSwizzle
+		*/
+		PLBERKELIUM_API static void CopyRects(PLCore::uint8 *pDestination, const int &nDestinationWidth, const int &nDestinationHeight, const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, size_t numCopyRects, const Berkelium::Rect *copyRects, const bool &bSwizzle);
+
+		/**
+		*  @brief
+		*    Scrolls the content of a rectangle of the image in place
+		*
+		*  @remarks
+		*    The content of the scroll rect moves by (dx, dy), anything moved outside the scroll rect is dropped.
+		*    The scroll rect is clipped against the image and the shared region is moved with memmove in a row
+		*    order that never overwrites rows that still need to be read, so any (dx, dy) is safe.
+		*    The exposed parts of the scroll rect keep their old content, they are expected to arrive as copy rects.
+		*
+		*  @param[in] PLCore::uint8 * pImageBuffer
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*  @param[in] int dx
+		*  @param[in] int dy
+		*  @param[in] const Berkelium::Rect & scrollRect
+		*/
+		PLBERKELIUM_API static void ScrollRect(PLCore::uint8 *pImageBuffer, const int &nWidth, const int &nHeight, int dx, int dy, const Berkelium::Rect &scrollRect);
+
+		/**
+		*  @brief
+		*    Copies a row of pixels
+		*
+		*  @note
+		*    Source and destination may be the same row, swizzling a row in place swaps between BGRA and RGBA.
+		*
+		*  @param[in] PLCore::uint8 * pDestination
+		*  @param[in] const PLCore::uint8 * pSource
+		*  @param[in] PLCore::uint32 nNumOfPixels
+		*  @param[in] const bool & bSwizzle
+		*/
+		PLBERKELIUM_API static void CopyRow(PLCore::uint8 *pDestination, const PLCore::uint8 *pSource, PLCore::uint32 nNumOfPixels, const bool &bSwizzle);
+
+		/**
+		*  @brief
+		*    Returns the name of the instruction set used by the copy kernel
+		*
+		*  @return
+		*    "AVX2", "SSE2" or "Scalar"
+		*/
+		PLBERKELIUM_API static PLCore::String GetInstructionSet();
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_BUFFERCOPY_H__
@@ -0,0 +1,127 @@
+#ifndef __PLBERKELIUM_CONTROLTABLE_H__
+#define __PLBERKELIUM_CONTROLTABLE_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+#include <PLInput/Input/Controller.h>
+#include <PLInput/Input/Controls/Control.h>
+
+#include "PLBerkelium.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Definitions                                           ]
+//[-------------------------------------------------------]
+enum EControlKind
+{
+	ControlKindIgnored = 0,		/**< The Gui does nothing with the control */
+	ControlKindMouseMove,		/**< Mouse axis, the mouse moved */
+	ControlKindMouseButton,		/**< Mouse button, the code is the berkelium button */
+	ControlKindMouseWheel,		/**< Mouse wheel axis */
+	ControlKindKey,				/**< Keyboard button, the code is the windows virtual key code */
+	NumOfControlKinds
+};
+
+
+//[-------------------------------------------------------]
+//[ Structures                                            ]
+//[-------------------------------------------------------]
+struct sControlInfo
+{
+	PLCore::uint32 nID;			/**< Index of the control in the definitions, the same on every controller */
+	EControlKind nKind;			/**< What the Gui does with the control */
+	int nCode;					/**< Berkelium button of a mouse button, windows virtual key code of a key */
+	char nText;					/**< Character a key types, 0 if it types nothing */
+	char nShiftText;			/**< Character a key types with shift held, 0 if it is the same as nText */
+	int nModifier;				/**< Berkelium modifier a key holds while it is down, 0 for none */
+	bool bKeypad;				/**< Whether or not a key is on the numpad */
+};
+
+
+struct sControlBinding
+{
+	const PLInput::Control *pControl;	/**< Control of the connected controller, not owned */
+	sControlInfo sInfo;					/**< Definition the control resolved to */
+};
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Controls of a controller resolved once to what the Gui does with them
+*
+*  @remarks
+*    The control names are compared once in Resolve(), an event afterwards only looks up the control instance in a
+*    sorted array and never touches a string. The definitions follow the names of PLInput::VirtualStandardController
+*    and cover the mouse and the whole keyboard, including modifiers, arrows, function keys and the numpad.
+*/
+class ControlTable {
+
+
+	public:
+		PLBERKELIUM_API ControlTable();
+		PLBERKELIUM_API ~ControlTable();
+
+		/**
+		*  @brief
+		*    Resolves the controls of a controller, the former bindings are removed
+		*
+		*  @param[in] const PLInput::Controller & cController
+		*
+		*  @return
+		*    number of controls that resolved to a definition
+		*/
+		PLBERKELIUM_API PLCore::uint32 Resolve(const PLInput::Controller &cController);
+
+		/**
+		*  @brief
+		*    Removes all bindings
+		*/
+		PLBERKELIUM_API void Clear();
+
+		/**
+		*  @brief
+		*    Returns what the Gui does with a control
+		*
+		*  @param[in] const PLInput::Control & cControl
+		*
+		*  @return
+		*    definition, a null pointer if the control was not resolved (do not destroy the returned instance!)
+		*/
+		PLBERKELIUM_API const sControlInfo *Get(const PLInput::Control &cControl) const;
+
+		/**
+		*  @brief
+		*    Returns the number of resolved controls
+		*
+		*  @return
+		*    number of bindings
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfBindings() const;
+
+	protected:
+
+	private:
+		sControlBinding *m_psBindings;		/**< Sorted by control address */
+		PLCore::uint32 m_nNumOfBindings;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_CONTROLTABLE_H__
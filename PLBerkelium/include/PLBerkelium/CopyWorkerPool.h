@@ -0,0 +1,178 @@
+#ifndef __PLBERKELIUM_COPYWORKERPOOL_H__
+#define __PLBERKELIUM_COPYWORKERPOOL_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+#include <PLCore/System/Thread.h>
+#include <PLCore/System/Mutex.h>
+#include <PLCore/System/Semaphore.h>
+
+#include "berkelium/Rect.hpp"
+
+#include "PLBerkelium.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Forward declarations                                  ]
+//[-------------------------------------------------------]
+class CopyWorker;
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Pool of worker threads that share the paint copies of the berkelium windows
+*
+*  @remarks
+*    A copy is split into tasks, large rectangles by row band and rectangle lists by rectangle.
+*    Idle workers and the calling thread take the next open task until all tasks are done, so a
+*    worker that is late to wake up does not hold back the others. The call returns when all
+*    tasks are done, the image buffer is complete before it is uploaded.
+*    Copies with less pixels than the threshold (e.g. caret blinks) stay on the calling thread.
+*/
+class CopyWorkerPool {
+
+
+	friend class CopyWorker;
+
+
+	public:
+		/**
+		*  @brief
+		*    Constructor
+		*
+		*  @param[in] PLCore::uint32 nNumOfWorkers
+		*    number of worker threads, 0 uses one worker less than there are processors
+		*/
+		PLBERKELIUM_API CopyWorkerPool(PLCore::uint32 nNumOfWorkers = 0);
+		PLBERKELIUM_API ~CopyWorkerPool();
+
+		/**
+		*  @brief
+		*    Returns the number of worker threads
+		*
+		*  @return
+		*    number of worker threads, 0 if all copies are done on the calling thread
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfWorkers() const;
+
+		/**
+		*  @brief
+		*    Sets the number of pixels a copy needs before it is shared with the workers
+		*
+		*  @param[in] PLCore::uint32 nNumOfPixels
+		*/
+		PLBERKELIUM_API void SetThreshold(PLCore::uint32 nNumOfPixels);
+
+		/**
+		*  @brief
+		*    Returns the number of pixels a copy needs before it is shared with the workers
+		*
+		*  @return
+		*    threshold in pixels
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetThreshold() const;
+
+		/**
+		*  @brief
+		*    Copies a list of rectangles from the source buffer into the destination image
+		*
+		*  @remarks
+		*    Same as BufferCopy::CopyRects(), but shared with the workers if the copy is large enough.
+		*
+		*  @param[in] PLCore::uint8 * pDestination
+		*  @param[in] const int & nDestinationWidth
+		*  @param[in] const int & nDestinationHeight
+		*  @param[in] const unsigned char * sourceBuffer
+		*  @param[in] const Berkelium::Rect & sourceBufferRect
+		*  @param[in] size_t numCopyRects
+		*  @param[in] const Berkelium::Rect * copyRects
+		*  @param[in] const bool & bSwizzle
+		*/
+		PLBERKELIUM_API void CopyRects(PLCore::uint8 *pDestination, const int &nDestinationWidth, const int &nDestinationHeight, const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, size_t numCopyRects, const Berkelium::Rect *copyRects, const bool &bSwizzle);
+
+		/**
+		*  @brief
+		*    Ends the current frame, the copy time of the frame becomes the last frame copy time
+		*/
+		PLBERKELIUM_API void EndFrame();
+
+		/**
+		*  @brief
+		*    Returns the time spent in copies during the last frame
+		*
+		*  @return
+		*    microseconds the calling thread spent waiting for copies in the last frame
+		*/
+		PLBERKELIUM_API PLCore::uint64 GetLastFrameCopyTime() const;
+
+		/**
+		*  @brief
+		*    Returns the number of copies that were shared with the workers
+		*
+		*  @return
+		*    number of shared copies since creation
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfSharedCopies() const;
+
+	protected:
+
+	private:
+		/**
+		*  @brief
+		*    Adds a task, grows the task list if needed
+		*
+		*  @param[in] const Berkelium::Rect & cRect
+		*/
+		void AddTask(const Berkelium::Rect &cRect);
+
+		/**
+		*  @brief
+		*    Takes and runs open tasks until there are none left
+		*
+		*  @note
+		*    Called by the workers and the calling thread
+		*/
+		void RunTasks();
+
+		CopyWorker **m_ppWorkers;
+		PLCore::uint32 m_nNumOfWorkers;
+		PLCore::uint32 m_nThreshold;
+		PLCore::Mutex m_cTaskMutex;
+		PLCore::Semaphore m_cWorkSemaphore;
+		PLCore::Semaphore m_cDoneSemaphore;
+		volatile bool m_bShutdown;
+		Berkelium::Rect *m_pTasks;
+		PLCore::uint32 m_nMaxTasks;
+		PLCore::uint32 m_nNumOfTasks;
+		PLCore::uint32 m_nNextTask;
+		PLCore::uint8 *m_pDestination;
+		int m_nDestinationWidth;
+		int m_nDestinationHeight;
+		const unsigned char *m_pSourceBuffer;
+		Berkelium::Rect m_cSourceBufferRect;
+		bool m_bSwizzle;
+		PLCore::uint64 m_nFrameCopyTime;
+		PLCore::uint64 m_nLastFrameCopyTime;
+		PLCore::uint32 m_nNumOfSharedCopies;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_COPYWORKERPOOL_H__
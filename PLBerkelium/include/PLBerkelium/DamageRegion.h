@@ -0,0 +1,239 @@
+#ifndef __PLBERKELIUM_DAMAGEREGION_H__
+#define __PLBERKELIUM_DAMAGEREGION_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+#include <PLCore/String/String.h>
+
+#include "berkelium/Rect.hpp"
+
+#include "PLBerkelium.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Defines                                               ]
+//[-------------------------------------------------------]
+#define MAXDAMAGERECTS 32	/**< Rectangles a damage region holds, beyond that the cheapest pair is merged */
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Set of dirty rectangles of a surface, coalesced for uploading
+*
+*  @remarks
+*    Every rectangle costs one upload call, every pixel costs its upload. Two rectangles are merged into their
+*    bounding rectangle when uploading the bounding rectangle is not more expensive than uploading both plus
+*    one call, the call cost is given in pixels. Rectangles covered by another one are always dropped.
+*    In exact mode rectangles are only merged when the bounding rectangle covers no pixel outside of them,
+*    this is needed when only the added rectangles hold valid data (e.g. a staging buffer).
+*/
+class DamageRegion {
+
+
+	public:
+		PLBERKELIUM_API DamageRegion();
+
+		/**
+		*  @brief
+		*    Sets the size of the surface, the region is cleared when the size changes
+		*
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*/
+		PLBERKELIUM_API void SetSize(const int &nWidth, const int &nHeight);
+
+		/**
+		*  @brief
+		*    Sets the cost of one upload call
+		*
+		*  @param[in] PLCore::uint32 nNumOfPixels
+		*    number of pixels that cost as much to upload as one upload call
+		*/
+		PLBERKELIUM_API void SetCallCost(PLCore::uint32 nNumOfPixels);
+
+		/**
+		*  @brief
+		*    Returns the cost of one upload call
+		*
+		*  @return
+		*    call cost in pixels
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetCallCost() const;
+
+		/**
+		*  @brief
+		*    Sets whether merged rectangles may cover pixels that were not added
+		*
+		*  @param[in] const bool & bExact
+		*    'true' never covers pixels that were not added, 'false' trades pixels for upload calls
+		*/
+		PLBERKELIUM_API void SetExact(const bool &bExact);
+
+		/**
+		*  @brief
+		*    Returns whether merged rectangles may cover pixels that were not added
+		*
+		*  @return
+		*    'true' if exact, else 'false'
+		*/
+		PLBERKELIUM_API bool IsExact() const;
+
+		/**
+		*  @brief
+		*    Removes all rectangles
+		*/
+		PLBERKELIUM_API void Clear();
+
+		/**
+		*  @brief
+		*    Marks the whole surface as damaged
+		*/
+		PLBERKELIUM_API void AddFull();
+
+		/**
+		*  @brief
+		*    Adds a rectangle
+		*
+		*  @remarks
+		*    The rectangle is clipped against the surface, empty rectangles are ignored.
+		*
+		*  @param[in] const Berkelium::Rect & cRect
+		*
+		*  @return
+		*    'true' if the rectangle was added, 'false' if the region is exact and full (the region is unchanged then)
+		*/
+		PLBERKELIUM_API bool Add(const Berkelium::Rect &cRect);
+
+		/**
+		*  @brief
+		*    Adds a list of rectangles
+		*
+		*  @param[in] size_t nNumOfRects
+		*  @param[in] const Berkelium::Rect * pRects
+		*
+		*  @return
+		*    number of rectangles added, less than given if the region is exact and full
+		*/
+		PLBERKELIUM_API size_t Add(size_t nNumOfRects, const Berkelium::Rect *pRects);
+
+		/**
+		*  @brief
+		*    Returns whether or not there is any damage
+		*
+		*  @return
+		*    'true' if there are no rectangles, else 'false'
+		*/
+		PLBERKELIUM_API bool IsEmpty() const;
+
+		/**
+		*  @brief
+		*    Returns whether or not the whole surface is damaged by AddFull()
+		*
+		*  @return
+		*    'true' if the whole surface is damaged, else 'false'
+		*/
+		PLBERKELIUM_API bool IsFull() const;
+
+		/**
+		*  @brief
+		*    Returns the number of rectangles
+		*
+		*  @return
+		*    number of rectangles, 1 if the whole surface is damaged
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfRects() const;
+
+		/**
+		*  @brief
+		*    Returns the rectangles
+		*
+		*  @return
+		*    the rectangles, clipped against the surface (do not keep the pointer across changes of the region)
+		*/
+		PLBERKELIUM_API const Berkelium::Rect *GetRects() const;
+
+		/**
+		*  @brief
+		*    Returns the number of pixels the rectangles cover
+		*
+		*  @note
+		*    Overlapping pixels are counted once per rectangle, this is what the upload costs.
+		*
+		*  @return
+		*    number of pixels
+		*/
+		PLBERKELIUM_API PLCore::uint64 GetArea() const;
+
+		/**
+		*  @brief
+		*    Returns the upload cost of the region
+		*
+		*  @return
+		*    cost in pixels, the area plus the call cost per rectangle
+		*/
+		PLBERKELIUM_API PLCore::uint64 GetCost() const;
+
+		/**
+		*  @brief
+		*    Returns the fraction of the surface the rectangles cover
+		*
+		*  @return
+		*    covered fraction, can be larger than 1 for overlapping rectangles
+		*/
+		PLBERKELIUM_API float GetCoveredFraction() const;
+
+	protected:
+
+	private:
+		/**
+		*  @brief
+		*    Inserts a clipped rectangle, merging it with the rectangles it is worth merging with
+		*
+		*  @param[in] Berkelium::Rect cRect
+		*
+		*  @return
+		*    'true' if the rectangle was inserted, else 'false'
+		*/
+		bool Insert(Berkelium::Rect cRect);
+
+		/**
+		*  @brief
+		*    Returns whether or not two rectangles should be merged into their bounding rectangle
+		*
+		*  @param[in] const Berkelium::Rect & cFirst
+		*  @param[in] const Berkelium::Rect & cSecond
+		*
+		*  @return
+		*    'true' if they should be merged, else 'false'
+		*/
+		bool IsWorthMerging(const Berkelium::Rect &cFirst, const Berkelium::Rect &cSecond) const;
+
+		int m_nWidth;
+		int m_nHeight;
+		PLCore::uint32 m_nCallCost;
+		bool m_bExact;
+		bool m_bFull;
+		Berkelium::Rect m_cRects[MAXDAMAGERECTS + 1];
+		PLCore::uint32 m_nNumOfRects;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_DAMAGEREGION_H__
@@ -37,6 +37,15 @@
 #include "PLBerkelium.h"
 #include "SRPWindow.h"
 #include "SRPMousePointer.h"
+#include "CopyWorkerPool.h"
+#include "SurfacePool.h"
+#include "ProgramCache.h"
+#include "SRPCompositor.h"
+#include "WindowAnimator.h"
+#include "HitTestIndex.h"
+#include "InputQueue.h"
+#include "ControlTable.h"
+#include "KeyboardState.h"
 
 
 //[-------------------------------------------------------]
@@ -49,17 +58,17 @@ namespace PLBerkelium {
 //[ Defines                                               ]
 //[-------------------------------------------------------]
 #define BERKELIUMDUMMYWINDOW "berkeliumdummywindow"
+#define DEFAULTANIMATIONTIME 250		/**< Milliseconds a window animation runs when no duration is given */
 
 
 //[-------------------------------------------------------]
 //[ Structures                                            ]
 //[-------------------------------------------------------]
-struct sButton
+struct sFrameStages
 {
-	PLCore::String sKey;
-	char nKey;
-	bool bValid;
-	bool bMod;
+	PLCore::uint64 nUpdateTime;		/**< Microseconds spent updating berkelium, the paints are copied in this stage */
+	PLCore::uint64 nHandlerTime;	/**< Microseconds spent in the keyboard, callback, drag and resize handlers and advancing the window animations */
+	PLCore::uint64 nUploadTime;		/**< Microseconds spent uploading the paints of all windows */
 };
 
 
@@ -174,6 +183,123 @@ class Gui : public PLCore::Object {
 		
 		/**
 		*  @brief
+		*    Uploads the paints of all windows to their textures
+		*
+		*  @note
+		*    You dont really need to call this, because it would be called by the SceneContext OnUpdate event if ConnectEventUpdate() is set.
+		*    Call it after UpdateBerkelium() otherwise, the windows then only draw textures that are complete.
+		*/
+		PLBERKELIUM_API void UploadWindows();
+		
+		/**
+		*  @brief
+		*    Returns the time the stages of the last OnUpdate() took
+		*
+		*  @return
+		*    stage times of the last update, drawing is done by the window scene render passes and not part of it
+		*/
+		PLBERKELIUM_API const sFrameStages &GetLastFrameStages() const;
+		
+		/**
+		*  @brief
+		*    Returns the number of worker threads sharing the paint copies of all windows
+		*
+		*  @remarks
+		*    Large paints are split by row band and rect lists by rect across the workers, small paints are copied
+		*    on the thread that updates berkelium.
+		*
+		*  @return
+		*    number of worker threads, 0 if all copies are done on the updating thread
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfCopyWorkers() const;
+		
+		/**
+		*  @brief
+		*    Returns the time the last UpdateBerkelium() spent copying paint data
+		*
+		*  @return
+		*    copy time in microseconds
+		*/
+		PLBERKELIUM_API PLCore::uint64 GetLastFrameCopyTime() const;
+		
+		/**
+		*  @brief
+		*    Returns the pool the window and widget textures of all windows are taken from
+		*
+		*  @return
+		*    surface pool, owned by the Gui
+		*/
+		PLBERKELIUM_API SurfacePool *GetSurfacePool() const;
+		
+		/**
+		*  @brief
+		*    Destroys all textures the surface pool keeps for reuse
+		*
+		*  @remarks
+		*    Call this under memory pressure, the textures the windows use are not touched.
+		*/
+		PLBERKELIUM_API void TrimSurfacePool();
+		
+		/**
+		*  @brief
+		*    Returns the cache the programs of all windows, widgets and the compositor are taken from
+		*
+		*  @return
+		*    program cache, owned by the Gui
+		*/
+		PLBERKELIUM_API ProgramCache *GetProgramCache() const;
+		
+		/**
+		*  @brief
+		*    Returns the animator that runs the opacity, translation and scale tweens of all windows
+		*
+		*  @return
+		*    window animator, owned by the Gui
+		*/
+		PLBERKELIUM_API WindowAnimator *GetWindowAnimator() const;
+		
+		/**
+		*  @brief
+		*    Returns the index the mouse events are routed with
+		*
+		*  @remarks
+		*    The windows keep it up to date, after changing sWindowsData::bMouseEnabled, sWindowsData::bIsVisable or the
+		*    position of a window directly, invalidate it (see HitTestIndex::Invalidate()).
+		*
+		*  @return
+		*    hit test index, owned by the Gui
+		*/
+		PLBERKELIUM_API HitTestIndex *GetHitTestIndex() const;
+		
+		/**
+		*  @brief
+		*    Returns the queue the mouse events are collected in until the next update
+		*
+		*  @return
+		*    input queue, owned by the Gui
+		*/
+		PLBERKELIUM_API InputQueue *GetInputQueue() const;
+		
+		/**
+		*  @brief
+		*    Returns the controls of the connected controller resolved to what the Gui does with them
+		*
+		*  @return
+		*    control table, owned by the Gui
+		*/
+		PLBERKELIUM_API ControlTable *GetControlTable() const;
+		
+		/**
+		*  @brief
+		*    Returns the held keys and their repeats
+		*
+		*  @return
+		*    keyboard state, owned by the Gui
+		*/
+		PLBERKELIUM_API KeyboardState *GetKeyboardState() const;
+		
+		/**
+		*  @brief
 		*    Destroys this Gui instance
 		*
 		*  @remarks
@@ -236,6 +362,15 @@ class Gui : public PLCore::Object {
 		*/
 		PLBERKELIUM_API SRPMousePointer *GetMousePointer() const;
 		
+		/**
+		*  @brief
+		*    Returns the compositor that draws all windows
+		*
+		*  @return
+		*    pointer to the compositor (can be a null pointer before the renderers are set, do not destroy the returned instance!)
+		*/
+		PLBERKELIUM_API SRPCompositor *GetCompositor() const;
+		
 		/**
 		*  @brief
 		*    Focuses a window
@@ -262,6 +397,7 @@ class Gui : public PLCore::Object {
 		*
 		*  @remarks
 		*    This is required for mouse and keyboard input, not mandatory.
+		*    The controls are resolved by name here (see ControlTable), controls added to the controller later are ignored.
 		*
 		*  @param[in] PLInput::Controller * pController
 		*
@@ -277,10 +413,13 @@ class Gui : public PLCore::Object {
 		*  @remarks
 		*    This is needed to process the update structure which includes;
 		*    -> UpdateBerkelium()
+		*    -> DispatchInput()
 		*    -> KeyboardHandler()
 		*    -> DefaultCallBackHandler()
 		*    -> DragWindowHandler()
 		*    -> ResizeWindowHandler()
+		*    -> WindowAnimator::Update()
+		*    -> UploadWindows()
 		*
 		*  @note
 		*    Not setting this will disable the above from being called by the EventUpdate.
@@ -329,6 +468,104 @@ class Gui : public PLCore::Object {
 		*    'true' if the visibility of the window was set, else 'false'
 		*/
 		PLBERKELIUM_API bool SetWindowVisible(const PLCore::String &sName, const bool &bVisible = true);
+		
+		/**
+		*  @brief
+		*    Sets whether or not the mouse goes through the transparent pixels of a window by name
+		*
+		*  @remarks
+		*    Clicks on the transparent parts of a HUD window then reach the windows behind or the scene (see SRPWindow::SetClickThrough()).
+		*
+		*  @param[in] const PLCore::String & sName
+		*  @param[in] const bool & bClickThrough
+		*
+		*  @return
+		*    'true' if the window was found, else 'false'
+		*/
+		PLBERKELIUM_API bool SetWindowClickThrough(const PLCore::String &sName, const bool &bClickThrough = true);
+		
+		/**
+		*  @brief
+		*    Sets how long a key is held before it repeats and how fast it repeats then
+		*
+		*  @param[in] const PLCore::uint32 & nDelay
+		*    milliseconds, KEYREPEATDELAY by default
+		*  @param[in] const PLCore::uint32 & nInterval
+		*    milliseconds, KEYREPEATINTERVAL by default
+		*/
+		PLBERKELIUM_API void SetKeyRepeat(const PLCore::uint32 &nDelay, const PLCore::uint32 &nInterval);
+		
+		/**
+		*  @brief
+		*    Shows or hides a window by name with a fade
+		*
+		*  @remarks
+		*    A hidden window is shown at opacity 0 and faded in, a window is hidden when it faded out.
+		*    The fade runs on the GPU, the page is not repainted.
+		*
+		*  @note
+		*    Window will be unfocused if you want to hide it.
+		*
+		*  @param[in] const PLCore::String & sName
+		*  @param[in] const bool & bVisible
+		*  @param[in] const PLCore::uint32 & nDuration
+		*    milliseconds
+		*
+		*  @return
+		*    'true' if the fade was started, else 'false'
+		*/
+		PLBERKELIUM_API bool SetWindowVisibleAnimated(const PLCore::String &sName, const bool &bVisible = true, const PLCore::uint32 &nDuration = DEFAULTANIMATIONTIME);
+		
+		/**
+		*  @brief
+		*    Fades a window by name to the given opacity
+		*
+		*  @param[in] const PLCore::String & sName
+		*  @param[in] const float & fOpacity
+		*    opacity from 0 to 1, the window stays visible and takes mouse input at 0
+		*  @param[in] const PLCore::uint32 & nDuration
+		*    milliseconds
+		*
+		*  @return
+		*    'true' if the fade was started, else 'false'
+		*/
+		PLBERKELIUM_API bool FadeWindow(const PLCore::String &sName, const float &fOpacity, const PLCore::uint32 &nDuration = DEFAULTANIMATIONTIME);
+		
+		/**
+		*  @brief
+		*    Moves a window by name to the given position with a slide
+		*
+		*  @remarks
+		*    The window is at the new position right away, so the mouse input follows at once, only the
+		*    drawing slides over from where the window was drawn.
+		*
+		*  @param[in] const PLCore::String & sName
+		*  @param[in] const int & nX
+		*  @param[in] const int & nY
+		*  @param[in] const PLCore::uint32 & nDuration
+		*    milliseconds
+		*
+		*  @return
+		*    'true' if the slide was started, else 'false'
+		*/
+		PLBERKELIUM_API bool SlideWindow(const PLCore::String &sName, const int &nX, const int &nY, const PLCore::uint32 &nDuration = DEFAULTANIMATIONTIME);
+		
+		/**
+		*  @brief
+		*    Scales the drawing of a window by name around its center
+		*
+		*  @remarks
+		*    The texture is stretched, the page is not resized, use ResizeWindow() of the window for that.
+		*
+		*  @param[in] const PLCore::String & sName
+		*  @param[in] const float & fScale
+		*  @param[in] const PLCore::uint32 & nDuration
+		*    milliseconds
+		*
+		*  @return
+		*    'true' if the scale was started, else 'false'
+		*/
+		PLBERKELIUM_API bool ScaleWindow(const PLCore::String &sName, const float &fScale, const PLCore::uint32 &nDuration = DEFAULTANIMATIONTIME);
 		
 		/**
 		*  @brief
@@ -338,10 +575,24 @@ class Gui : public PLCore::Object {
 		*    This will be deprecated when no longer needed.
 		*/
 		PLBERKELIUM_API void DebugNamesOfWindows();
+		
+		/**
+		*  @brief
+		*    A debug method to output the paint and upload statistics of all windows
+		*
+		*  @remarks
+		*    When some windows stream through pixel buffers and others upload straight, the render thread time
+		*    per MiB of both paths is compared to estimate the stall time the pixel buffers avoided.
+		*
+		*  @param[in] const bool & bReset
+		*/
+		PLBERKELIUM_API void DebugStatsOfWindows(const bool &bReset = false);
 
 	protected:
 
 	private:
+		typedef void (Gui::*ControlHandler)(PLInput::Control &cControl, const sControlInfo &sInfo);
+
 		void DebugToConsole(const PLCore::String &sString);
 		
 		/**
@@ -376,30 +627,12 @@ class Gui : public PLCore::Object {
 		
 		/**
 		*  @brief
-		*    Returns mouse enabled window(s)
+		*    Rebuilds the hit test index from the visible, mouse enabled windows and their widgets
 		*
 		*  @remarks
-		*    This iterates trough all windows and returns a list of those that allow mouse events.
-		*
-		*  @return
-		*    Pointer to the list created (can be a null pointer, destroy the returned instance when you no longer need it)
-		*/
-		PLCore::List<SRPWindow*> *GetMouseEnabledWindows();
-		
-		/**
-		*  @brief
-		*    Returns window(s) if the mouse is currently over them
-		*
-		*  @note
-		*    This iterates trough windows given as parameter and returns a list of those where the mouse is currently over.
-		*
-		*  @param[in] const PLCore::List<SRPWindow * > * plstEnabledWindows
-		*  @param[in] const PLMath::Vector2i & vMousePos
-		*
-		*  @return
-		*    Pointer to the list created (can be a null pointer, destroy the returned instance when you no longer need it)
+		*    The z-order of a window is looked up once per rebuild, the index is only rebuilt after it was invalidated.
 		*/
-		PLCore::List<SRPWindow*> *GetMouseOverWindows(const PLCore::List<SRPWindow*> *plstEnabledWindows, const PLMath::Vector2i &vMousePos);
+		void UpdateHitTestIndex();
 		
 		/**
 		*  @brief
@@ -413,6 +646,42 @@ class Gui : public PLCore::Object {
 		*/
 		void DestroyMousePointer() const;
 		
+		/**
+		*  @brief
+		*    Creates the compositor
+		*/
+		void CreateCompositor();
+		
+		/**
+		*  @brief
+		*    Destroys the compositor
+		*/
+		void DestroyCompositor() const;
+		
+		/**
+		*  @brief
+		*    Returns a window by name that may be animated
+		*
+		*  @param[in] const PLCore::String & sName
+		*
+		*  @return
+		*    pointer to window, a null pointer for the dummy window or if the window cannot be found (do not destroy the returned instance!)
+		*/
+		SRPWindow *GetAnimatableWindow(const PLCore::String &sName);
+		
+		/**
+		*  @brief
+		*    Returns a number parameter of a default callback
+		*
+		*  @param[in] const sCallBack * psCallBack
+		*  @param[in] const PLCore::uint32 & nIndex
+		*  @param[in] const double & fDefault
+		*
+		*  @return
+		*    the number parameter, the default if javascript did not pass it
+		*/
+		static double GetCallBackNumber(const sCallBack *psCallBack, const PLCore::uint32 &nIndex, const double &fDefault);
+		
 		/**
 		*  @brief
 		*    Processes update methods
@@ -420,34 +689,39 @@ class Gui : public PLCore::Object {
 		*  @remarks
 		*    Processes the update structure which includes;
 		*    -> UpdateBerkelium()
+		*    -> DispatchInput()
 		*    -> KeyboardHandler()
 		*    -> DefaultCallBackHandler()
 		*    -> DragWindowHandler()
 		*    -> ResizeWindowHandler()
+		*    -> WindowAnimator::Update()
+		*    -> UploadWindows()
+		*    The stages run in this order every frame, the window scene render passes draw afterwards.
 		*/
 		void OnUpdate();
 		
 		/**
 		*  @brief
-		*    Processes all mouse events
+		*    Queues the mouse events of a control
+		*
+		*  @remarks
+		*    Every mouse control event is a move to the current mouse position, a mouse button or the wheel is queued
+		*    after it. Nothing is sent to berkelium here, see DispatchInput().
 		*
 		*  @param[in] PLInput::Control & cControl
+		*  @param[in] const sControlInfo & sInfo
 		*/
-		void MouseEvents(PLInput::Control &cControl);
+		void MouseEvents(PLInput::Control &cControl, const sControlInfo &sInfo);
 		
 		/**
 		*  @brief
-		*    Returns top most window
+		*    Sends the queued mouse events to the windows
 		*
 		*  @remarks
-		*    This iterates trough windows given as parameter and returns the top most one.
-		*
-		*  @param[in] PLCore::List<SRPWindow * > * plstWindows
-		*
-		*  @return
-		*    pointer to window (can be a null pointer, do not destroy the returned instance!)
+		*    Called once per update and when the queue is full. The mouse pointer is moved once, each event is hit
+		*    tested and a move is only sent if the window or the position changed.
 		*/
-		SRPWindow *GetTopMostWindow(PLCore::List<SRPWindow*> *plstWindows);
+		void DispatchInput();
 		
 		/**
 		*  @brief
@@ -463,23 +737,31 @@ class Gui : public PLCore::Object {
 		*    Process mouse clicking on a window
 		*
 		*  @param[in] SRPWindow * pSRPWindow
-		*  @param[in] PLInput::Control & cControl
+		*  @param[in] const int & nButton
+		*    berkelium button, 0 left, 1 middle, 2 right
+		*  @param[in] const bool & bPressed
+		*  @param[in] const PLCore::uint64 & nTime
+		*    millisecond the button event came in, for the double click
 		*/
-		void MouseClicks(SRPWindow *pSRPWindow, PLInput::Control &cControl);
+		void MouseClicks(SRPWindow *pSRPWindow, const int &nButton, const bool &bPressed, const PLCore::uint64 &nTime);
 		
 		/**
 		*  @brief
 		*    Process mouse scrolling on a window
 		*
 		*  @param[in] SRPWindow * pSRPWindow
-		*  @param[in] PLInput::Control & cControl
+		*  @param[in] const float & fDelta
+		*    accumulated wheel delta
 		*/
-		void MouseScrolls(SRPWindow *pSRPWindow, PLInput::Control &cControl);
+		void MouseScrolls(SRPWindow *pSRPWindow, const float &fDelta);
 		
 		/**
 		*  @brief
 		*    On control method that should be called when a control event is fired
 		*
+		*  @remarks
+		*    The control is looked up in the control table and handed to the handler of its kind.
+		*
 		*  @note
 		*    This only happens if you have connected the controller, see ConnectController().
 		*
@@ -501,9 +783,15 @@ class Gui : public PLCore::Object {
 		*  @brief
 		*    Processes all keyboard events
 		*
+		*  @remarks
+		*    Every key is pressed and released in the keyboard state, also without a focused window, so the modifiers
+		*    stay right. The focused window gets a key down, the character the key types unless control or alt is
+		*    held, and a key up on the release. A native repeat of a held key is ignored, see KeyboardHandler().
+		*
 		*  @param[in] PLInput::Control & cControl
+		*  @param[in] const sControlInfo & sInfo
 		*/
-		void KeyboardEvents(PLInput::Control &cControl);
+		void KeyboardEvents(PLInput::Control &cControl, const sControlInfo &sInfo);
 		
 		/**
 		*  @brief
@@ -518,28 +806,32 @@ class Gui : public PLCore::Object {
 		/**
 		*  @brief
 		*    Handles all keyboard related processes on update
+		*
+		*  @remarks
+		*    Sends the repeats of the held keys that came due to the focused window, only the keys in the passed slots
+		*    of the repeat wheel are looked at.
 		*/
 		void KeyboardHandler();
 		
 		/**
 		*  @brief
-		*    Adds a text key to the keyboard handler
+		*    Returns the berkelium window the keys go to
 		*
-		*  @param[in] const PLCore::String & sName
-		*  @param[in] const PLCore::String & sKey
-		*  @param[in] sButton * psButton
+		*  @return
+		*    the focused window if it allows for key events, else a null pointer
 		*/
-		void AddTextKey(const PLCore::String &sName, const PLCore::String &sKey, sButton *psButton);
+		Berkelium::Window *GetKeyboardWindow() const;
 		
 		/**
 		*  @brief
-		*    Adds a key to the keyboard handler
+		*    Sends a key down and the character the key types
 		*
-		*  @param[in] const PLCore::String & sName
-		*  @param[in] const char & nKey
-		*  @param[in] sButton * psButton
+		*  @param[in] Berkelium::Window * pWindow
+		*  @param[in] const int & nCode
+		*    windows virtual key code of a held key
+		*  @param[in] const bool & bRepeat
 		*/
-		void AddKey(const PLCore::String &sName, const char &nKey, sButton *psButton);
+		void SendKey(Berkelium::Window *pWindow, const int &nCode, const bool &bRepeat) const;
 		
 		/**
 		*  @brief
@@ -548,6 +840,8 @@ class Gui : public PLCore::Object {
 		*  @remarks
 		*    If the resizing window is defined and certain parameter are met.
 		*    The window will be resizing on screen relative to the mouse movement.
+		*    While the mouse moves only the texture is previewed at the new size, the page is resized when
+		*    the mouse rests for the resize idle time of the window or when the mouse is released.
 		*
 		*  @note
 		*    This method is somewhat experimental and is subject to change
@@ -560,6 +854,7 @@ class Gui : public PLCore::Object {
 		PLScene::SceneRenderer *m_pCurrentSceneRenderer;
 		PLRenderer::Renderer *m_pCurrentRenderer;
 		SRPMousePointer *m_pSRPMousePointer;
+		SRPCompositor *m_pCompositor;
 		SRPWindow *m_pFocusedWindow;
 		bool m_bControlsEnabled;
 		bool m_bIsUpdateConnected;
@@ -573,12 +868,18 @@ class Gui : public PLCore::Object {
 		SRPWindow *m_pResizeWindow;
 		bool m_bMouseMoved;
 		PLMath::Vector2i m_vLockMousePos;
-		PLCore::HashMap<PLCore::String, sButton*> *m_pmapTextButtonHandler;
-		PLCore::HashMap<PLCore::String, sButton*> *m_pmapKeyButtonHandler;
-		PLCore::uint64 m_nLastTextKeySendTime;
-		PLCore::uint64 m_nLastKeySendTime;
-		int m_nTextKeyHitCount;
-		int m_nKeyHitCount;
+		CopyWorkerPool *m_pCopyWorkerPool;
+		SurfacePool *m_pSurfacePool;
+		ProgramCache *m_pProgramCache;
+		WindowAnimator *m_pWindowAnimator;
+		HitTestIndex *m_pHitTestIndex;
+		InputQueue *m_pInputQueue;
+		ControlTable *m_pControlTable;
+		ControlHandler m_cControlHandlers[NumOfControlKinds];	/**< Handler of each control kind, a null pointer ignores the control */
+		KeyboardState *m_pKeyboardState;
+		SRPWindow *m_pLastMoveWindow;
+		PLMath::Vector2i m_vLastMovePos;
+		sFrameStages m_sFrameStages;
 
 
 };
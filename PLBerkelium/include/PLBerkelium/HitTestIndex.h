@@ -0,0 +1,170 @@
+#ifndef __PLBERKELIUM_HITTESTINDEX_H__
+#define __PLBERKELIUM_HITTESTINDEX_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+#include <PLCore/String/String.h>
+#include <PLMath/Vector2i.h>
+
+#include "PLBerkelium.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Forward declarations                                  ]
+//[-------------------------------------------------------]
+class AlphaMask;
+
+
+//[-------------------------------------------------------]
+//[ Defines                                               ]
+//[-------------------------------------------------------]
+#define MINHITTESTRECTS 64		/**< Rectangles a hit test index holds before it grows for the first time */
+
+
+//[-------------------------------------------------------]
+//[ Structures                                            ]
+//[-------------------------------------------------------]
+struct sHitTestRect
+{
+	void *pKey;					/**< Window the mouse events go to, the index never looks at it, not owned */
+	int nZ;						/**< Z-order of the window, higher is in front */
+	int nLeft;					/**< Left edge on screen, exclusive */
+	int nTop;					/**< Top edge on screen, exclusive */
+	int nRight;					/**< Right edge on screen, exclusive */
+	int nBottom;				/**< Bottom edge on screen, exclusive */
+	const AlphaMask *pAlphaMask;	/**< Mask the mouse goes through the transparent pixels with, a null pointer takes the whole rectangle, not owned */
+	float fMaskScale;			/**< Mask pixels per screen pixel */
+};
+
+
+struct sHitTestIndexStats
+{
+	PLCore::uint32 nQueries;	/**< Hit tests answered */
+	PLCore::uint32 nRebuilds;	/**< Times the rectangles were rebuilt */
+};
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Rectangles of the visible, mouse enabled windows and their widgets in z-order
+*
+*  @remarks
+*    The Gui rebuilds the rectangles only after the index was invalidated, the windows invalidate it when they are
+*    moved, resized, shown, hidden or moved to front and when their widgets change. A hit test walks the rectangles
+*    front to back and stops at the first hit, it never allocates. The array only grows while rebuilding.
+*/
+class HitTestIndex {
+
+
+	public:
+		PLBERKELIUM_API HitTestIndex();
+		PLBERKELIUM_API ~HitTestIndex();
+
+		/**
+		*  @brief
+		*    Marks the rectangles as outdated, the Gui rebuilds them before the next hit test
+		*/
+		PLBERKELIUM_API void Invalidate();
+
+		/**
+		*  @brief
+		*    Returns whether or not the rectangles are outdated
+		*
+		*  @return
+		*    'true' if they have to be rebuilt, else 'false'
+		*/
+		PLBERKELIUM_API bool IsDirty() const;
+
+		/**
+		*  @brief
+		*    Removes all rectangles to rebuild them, the index is up to date again afterwards
+		*/
+		PLBERKELIUM_API void Clear();
+
+		/**
+		*  @brief
+		*    Adds a rectangle, it is sorted in by its z-order
+		*
+		*  @remarks
+		*    Adding back to front is the cheapest, a rectangle is inserted in front of all rectangles of the same or a
+		*    lower z-order. Empty rectangles are ignored. The mask is read on every hit test, so it may change
+		*    without a rebuild.
+		*
+		*  @param[in] void * pKey
+		*    window the mouse events go to, returned by Get() as is
+		*  @param[in] const int & nZ
+		*    z-order, higher is in front
+		*  @param[in] const int & nX
+		*  @param[in] const int & nY
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*  @param[in] const AlphaMask * pAlphaMask
+		*    mask with its origin at the top left corner, where it is not hit the mouse goes through to the rectangles behind
+		*  @param[in] const float & fMaskScale
+		*    mask pixels per screen pixel
+		*/
+		PLBERKELIUM_API void Add(void *pKey, const int &nZ, const int &nX, const int &nY, const int &nWidth, const int &nHeight, const AlphaMask *pAlphaMask = nullptr, const float &fMaskScale = 1.0f);
+
+		/**
+		*  @brief
+		*    Returns the top most window at a position
+		*
+		*  @remarks
+		*    The edges are not part of a rectangle, like the former mouse over test. A masked rectangle that is not
+		*    hit by its mask is skipped.
+		*
+		*  @param[in] const PLMath::Vector2i & vPosition
+		*
+		*  @return
+		*    key of the window as given to Add(), a null pointer if no rectangle is hit
+		*/
+		PLBERKELIUM_API void *Get(const PLMath::Vector2i &vPosition);
+
+		/**
+		*  @brief
+		*    Returns the number of rectangles
+		*
+		*  @return
+		*    number of rectangles
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfRects() const;
+
+		/**
+		*  @brief
+		*    Returns the index statistics
+		*
+		*  @return
+		*    statistics since creation
+		*/
+		PLBERKELIUM_API const sHitTestIndexStats &GetStats() const;
+
+	protected:
+
+	private:
+		sHitTestRect *m_psRects;
+		PLCore::uint32 m_nNumOfRects;
+		PLCore::uint32 m_nMaxRects;
+		bool m_bDirty;
+		sHitTestIndexStats m_sStats;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_HITTESTINDEX_H__
@@ -0,0 +1,203 @@
+#ifndef __PLBERKELIUM_INPUTQUEUE_H__
+#define __PLBERKELIUM_INPUTQUEUE_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+#include <PLMath/Vector2i.h>
+
+#include "PLBerkelium.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Defines                                               ]
+//[-------------------------------------------------------]
+#define MAXINPUTEVENTS 256		/**< Coalesced events an input queue holds, when it is full it is dispatched right away */
+
+
+//[-------------------------------------------------------]
+//[ Definitions                                           ]
+//[-------------------------------------------------------]
+enum EInputEventType
+{
+	InputMouseMove = 0,		/**< The mouse moved to the position */
+	InputMouseButton,		/**< A mouse button was pressed or released at the position */
+	InputMouseWheel			/**< The wheel turned at the position */
+};
+
+
+//[-------------------------------------------------------]
+//[ Structures                                            ]
+//[-------------------------------------------------------]
+struct sInputEvent
+{
+	EInputEventType nType;			/**< Type of the event */
+	PLMath::Vector2i vPosition;		/**< Mouse position on screen */
+	int nButton;					/**< Berkelium button of a button event, 0 left, 1 middle, 2 right */
+	bool bPressed;					/**< Whether the button of a button event is down */
+	float fWheelDelta;				/**< Accumulated wheel delta of a wheel event */
+	PLCore::uint64 nTime;			/**< Millisecond the event came in (see PLCore::Timing::GetPastTime()) */
+};
+
+
+struct sInputQueueStats
+{
+	PLCore::uint32 nReceived;		/**< Control events that came in */
+	PLCore::uint32 nQueued;			/**< Events left after coalescing */
+	PLCore::uint32 nForwarded;		/**< Calls made to berkelium when the events were dispatched */
+	PLCore::uint32 nOverflows;		/**< Times the queue was full and dispatched before the update */
+};
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Mouse events collected between two updates of a Gui, coalesced as they come in
+*
+*  @remarks
+*    A move right after a move replaces it, a wheel turn right after a wheel turn at the same position is added to
+*    it, button events keep their order. The Gui dispatches the queue once per update, so a high
+*    rate mouse costs at most a few berkelium calls per frame. The events live in a fixed array, nothing is allocated.
+*/
+class InputQueue {
+
+
+	public:
+		PLBERKELIUM_API InputQueue();
+		PLBERKELIUM_API ~InputQueue();
+
+		/**
+		*  @brief
+		*    Counts a control event that came in
+		*
+		*  @remarks
+		*    Every control event counts, also those that only merge into a queued event.
+		*/
+		PLBERKELIUM_API void Receive();
+
+		/**
+		*  @brief
+		*    Adds a move
+		*
+		*  @param[in] const PLMath::Vector2i & vPosition
+		*  @param[in] const PLCore::uint64 & nTime
+		*
+		*  @return
+		*    'true' if queued, 'false' if the queue is full (dispatch it and add the move again)
+		*/
+		PLBERKELIUM_API bool AddMove(const PLMath::Vector2i &vPosition, const PLCore::uint64 &nTime);
+
+		/**
+		*  @brief
+		*    Adds a button press or release
+		*
+		*  @param[in] const PLMath::Vector2i & vPosition
+		*  @param[in] const int & nButton
+		*  @param[in] const bool & bPressed
+		*  @param[in] const PLCore::uint64 & nTime
+		*
+		*  @return
+		*    'true' if queued, 'false' if the queue is full (dispatch it and add the button again)
+		*/
+		PLBERKELIUM_API bool AddButton(const PLMath::Vector2i &vPosition, const int &nButton, const bool &bPressed, const PLCore::uint64 &nTime);
+
+		/**
+		*  @brief
+		*    Adds a wheel turn
+		*
+		*  @param[in] const PLMath::Vector2i & vPosition
+		*  @param[in] const float & fDelta
+		*  @param[in] const PLCore::uint64 & nTime
+		*
+		*  @return
+		*    'true' if queued, 'false' if the queue is full (dispatch it and add the wheel turn again)
+		*/
+		PLBERKELIUM_API bool AddWheel(const PLMath::Vector2i &vPosition, const float &fDelta, const PLCore::uint64 &nTime);
+
+		/**
+		*  @brief
+		*    Returns the number of queued events
+		*
+		*  @return
+		*    number of events
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfEvents() const;
+
+		/**
+		*  @brief
+		*    Returns a queued event
+		*
+		*  @param[in] PLCore::uint32 nIndex
+		*    index from 0 (oldest) to GetNumOfEvents() - 1
+		*
+		*  @return
+		*    event
+		*/
+		PLBERKELIUM_API const sInputEvent &GetEvent(PLCore::uint32 nIndex) const;
+
+		/**
+		*  @brief
+		*    Removes all events after they were dispatched, the statistics are kept
+		*/
+		PLBERKELIUM_API void Clear();
+
+		/**
+		*  @brief
+		*    Counts calls made to berkelium while dispatching
+		*
+		*  @param[in] PLCore::uint32 nNumOfCalls
+		*/
+		PLBERKELIUM_API void AddForwarded(PLCore::uint32 nNumOfCalls = 1);
+
+		/**
+		*  @brief
+		*    Counts a dispatch before the update because the queue was full
+		*/
+		PLBERKELIUM_API void AddOverflow();
+
+		/**
+		*  @brief
+		*    Returns the queue statistics
+		*
+		*  @return
+		*    statistics since creation
+		*/
+		PLBERKELIUM_API const sInputQueueStats &GetStats() const;
+
+	protected:
+
+	private:
+		/**
+		*  @brief
+		*    Appends an event
+		*
+		*  @param[in] const sInputEvent & sEvent
+		*
+		*  @return
+		*    'true' if appended, 'false' if the queue is full
+		*/
+		bool Append(const sInputEvent &sEvent);
+
+		sInputEvent m_sEvents[MAXINPUTEVENTS];
+		PLCore::uint32 m_nNumOfEvents;
+		sInputQueueStats m_sStats;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_INPUTQUEUE_H__
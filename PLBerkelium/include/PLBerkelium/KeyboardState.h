@@ -0,0 +1,249 @@
+#ifndef __PLBERKELIUM_KEYBOARDSTATE_H__
+#define __PLBERKELIUM_KEYBOARDSTATE_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+
+#include "PLBerkelium.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Defines                                               ]
+//[-------------------------------------------------------]
+#define MAXKEYCODES 256				/**< Windows virtual key codes a keyboard state holds */
+#define KEYREPEATDELAY 400			/**< Default milliseconds a key is held before it repeats */
+#define KEYREPEATINTERVAL 50		/**< Default milliseconds between two repeats */
+#define KEYREPEATTICK 8				/**< Milliseconds one slot of the repeat wheel stands for */
+#define KEYREPEATSLOTS 64			/**< Slots of the repeat wheel, a power of two */
+#define KEYMODIFIERBITS 4			/**< Lowest modifier bits that are counted per held key, shift, control, alt and meta */
+
+
+//[-------------------------------------------------------]
+//[ Structures                                            ]
+//[-------------------------------------------------------]
+struct sKeyState
+{
+	bool bDown;					/**< Whether or not the key is held */
+	bool bKeypad;				/**< Whether or not the key is on the numpad */
+	char nText;					/**< Character the key types, decided with the modifiers when it was pressed, 0 for none */
+	int nModifier;				/**< Modifier the key holds while it is down, 0 for none */
+	PLCore::uint64 nDueTime;	/**< Millisecond of the next repeat */
+	PLCore::uint32 nRepeats;	/**< Repeats since the key was pressed */
+	int nNext;					/**< Next key in the same slot of the repeat wheel, -1 for none */
+	int nPrevious;				/**< Previous key in the same slot of the repeat wheel, -1 for none */
+	int nSlot;					/**< Slot of the repeat wheel, -1 if the key does not repeat */
+};
+
+
+struct sKeyboardStateStats
+{
+	PLCore::uint32 nPresses;	/**< Keys pressed */
+	PLCore::uint32 nRepeats;	/**< Repeats that came due */
+	PLCore::uint32 nVisits;		/**< Keys looked at in the repeat wheel, due or not */
+};
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Held keys of the keyboard and when they repeat next
+*
+*  @remarks
+*    The keys live in a fixed array indexed by their windows virtual key code, nothing is allocated on a press. A
+*    held key that repeats is linked into the slot of a timer wheel its next repeat falls in, so an update only looks
+*    at the slots of the milliseconds that passed and the keys in them. Keys that type a character repeat one at a
+*    time like on a native keyboard, the last one pressed repeats. Modifier keys never repeat.
+*/
+class KeyboardState {
+
+
+	public:
+		PLBERKELIUM_API KeyboardState();
+		PLBERKELIUM_API ~KeyboardState();
+
+		/**
+		*  @brief
+		*    Sets the repeat timing, keys held already keep their next repeat
+		*
+		*  @param[in] const PLCore::uint32 & nDelay
+		*    milliseconds a key is held before it repeats
+		*  @param[in] const PLCore::uint32 & nInterval
+		*    milliseconds between two repeats, at least one
+		*/
+		PLBERKELIUM_API void SetRepeat(const PLCore::uint32 &nDelay, const PLCore::uint32 &nInterval);
+
+		/**
+		*  @brief
+		*    Returns the milliseconds a key is held before it repeats
+		*
+		*  @return
+		*    delay
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetRepeatDelay() const;
+
+		/**
+		*  @brief
+		*    Returns the milliseconds between two repeats
+		*
+		*  @return
+		*    interval
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetRepeatInterval() const;
+
+		/**
+		*  @brief
+		*    Presses a key
+		*
+		*  @param[in] const int & nCode
+		*    windows virtual key code
+		*  @param[in] const int & nModifier
+		*    modifier the key holds, 0 for none, a modifier key does not repeat
+		*  @param[in] const char & nText
+		*    character the key types, 0 for none
+		*  @param[in] const bool & bKeypad
+		*  @param[in] const PLCore::uint64 & nTime
+		*    millisecond of the press
+		*
+		*  @return
+		*    'true' if the key went down, 'false' if it was down already or the code is out of range
+		*/
+		PLBERKELIUM_API bool Press(const int &nCode, const int &nModifier, const char &nText, const bool &bKeypad, const PLCore::uint64 &nTime);
+
+		/**
+		*  @brief
+		*    Releases a key
+		*
+		*  @param[in] const int & nCode
+		*
+		*  @return
+		*    'true' if the key went up, 'false' if it was not down or the code is out of range
+		*/
+		PLBERKELIUM_API bool Release(const int &nCode);
+
+		/**
+		*  @brief
+		*    Stops the repeats of all held keys, they stay down until they are released
+		*
+		*  @remarks
+		*    Used when the keyboard focus moves, so a held key does not repeat into the next window.
+		*/
+		PLBERKELIUM_API void StopRepeats();
+
+		/**
+		*  @brief
+		*    Collects the keys whose repeat came due and schedules their next repeat
+		*
+		*  @remarks
+		*    A key repeats at most once per update, after a long frame the next repeat is an interval after the update.
+		*
+		*  @param[in] const PLCore::uint64 & nTime
+		*    millisecond of the update
+		*
+		*  @return
+		*    number of due keys, see GetRepeat()
+		*/
+		PLBERKELIUM_API PLCore::uint32 Update(const PLCore::uint64 &nTime);
+
+		/**
+		*  @brief
+		*    Returns a key that came due in the last update
+		*
+		*  @param[in] PLCore::uint32 nIndex
+		*    index from 0 to the return value of Update() - 1
+		*
+		*  @return
+		*    windows virtual key code
+		*/
+		PLBERKELIUM_API int GetRepeat(PLCore::uint32 nIndex) const;
+
+		/**
+		*  @brief
+		*    Returns the state of a key
+		*
+		*  @param[in] const int & nCode
+		*    windows virtual key code, has to be below MAXKEYCODES
+		*
+		*  @return
+		*    key state
+		*/
+		PLBERKELIUM_API const sKeyState &GetKey(const int &nCode) const;
+
+		/**
+		*  @brief
+		*    Returns the modifiers of the held keys
+		*
+		*  @return
+		*    modifiers
+		*/
+		PLBERKELIUM_API int GetModifiers() const;
+
+		/**
+		*  @brief
+		*    Returns the number of held keys
+		*
+		*  @return
+		*    number of keys
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfHeldKeys() const;
+
+		/**
+		*  @brief
+		*    Returns the keyboard statistics
+		*
+		*  @return
+		*    statistics since creation
+		*/
+		PLBERKELIUM_API const sKeyboardStateStats &GetStats() const;
+
+	protected:
+
+	private:
+		/**
+		*  @brief
+		*    Links a key into the slot of its next repeat
+		*
+		*  @param[in] const int & nCode
+		*  @param[in] const PLCore::uint64 & nDueTime
+		*/
+		void Schedule(const int &nCode, const PLCore::uint64 &nDueTime);
+
+		/**
+		*  @brief
+		*    Unlinks a key from its slot, it does not repeat anymore
+		*
+		*  @param[in] const int & nCode
+		*/
+		void Unschedule(const int &nCode);
+
+		sKeyState m_sKeys[MAXKEYCODES];
+		int m_nSlots[KEYREPEATSLOTS];				/**< First key of each slot, -1 for none */
+		int m_nRepeats[MAXKEYCODES];				/**< Keys that came due in the last update */
+		PLCore::uint32 m_nNumOfRepeats;
+		PLCore::uint32 m_nModifierHolds[KEYMODIFIERBITS];	/**< Held keys per modifier bit, two keys may hold the same modifier */
+		PLCore::uint32 m_nNumOfHeldKeys;
+		int m_nTextRepeatCode;						/**< Key that types a character and repeats, -1 for none */
+		PLCore::uint32 m_nDelay;
+		PLCore::uint32 m_nInterval;
+		PLCore::uint64 m_nLastTick;					/**< Tick of the last update, its slot is looked at again on the next update */
+		sKeyboardStateStats m_sStats;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_KEYBOARDSTATE_H__
@@ -0,0 +1,196 @@
+#ifndef __PLBERKELIUM_PROGRAMCACHE_H__
+#define __PLBERKELIUM_PROGRAMCACHE_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+#include <PLCore/String/String.h>
+#include <PLCore/Container/HashMap.h>
+#include <PLRenderer/Renderer/Renderer.h>
+#include <PLRenderer/Renderer/ProgramWrapper.h>
+#include <PLRenderer/Renderer/VertexBuffer.h>
+#include <PLRenderer/Renderer/VertexShader.h>
+#include <PLRenderer/Renderer/FragmentShader.h>
+#include <PLMath/Vector2.h>
+
+#include "PLBerkelium.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Definitions                                           ]
+//[-------------------------------------------------------]
+enum EProgramVariant
+{
+	ProgramVariantPlain = 0,	/**< The texture holds RGBA, the copy kernel swizzled */
+	ProgramVariantSwizzle,		/**< The texture holds the berkelium BGRA data as is, the shader swizzles */
+	NumOfProgramVariants
+};
+
+
+//[-------------------------------------------------------]
+//[ Structures                                            ]
+//[-------------------------------------------------------]
+struct sCachedProgram
+{
+	PLRenderer::VertexShader *pVertexShader;		/**< Owned by the cache */
+	PLRenderer::FragmentShader *pFragmentShader;	/**< Owned by the cache */
+	PLRenderer::ProgramWrapper *pProgramWrapper;	/**< Owned by the cache, a null pointer if the program could not be created */
+};
+
+
+struct sProgramCacheStats
+{
+	PLCore::uint32 nCompiled;		/**< Programs compiled and linked */
+	PLCore::uint32 nReused;			/**< Requests served with an already linked program */
+};
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Cache of the window programs and the unit quad, shared by all windows, widgets and the compositor of a Gui
+*
+*  @remarks
+*    Programs are keyed by renderer API and variant, so each variant is compiled and linked once per renderer
+*    instead of once per window. The cache owns the programs and their shaders, the users must not destroy them.
+*    All quads are drawn from one static unit quad, the program places it with the QuadRect and TextureRect
+*    uniforms and fades it with the Opacity uniform (see SetQuad()), so moving, resizing or fading a quad never
+*    touches a vertex buffer.
+*/
+class ProgramCache {
+
+
+	public:
+		PLBERKELIUM_API ProgramCache();
+		PLBERKELIUM_API ~ProgramCache();
+
+		/**
+		*  @brief
+		*    Returns the program of a variant, compiles and links it on first use
+		*
+		*  @remarks
+		*    A program that could not be created is not tried again.
+		*
+		*  @param[in] PLRenderer::Renderer & cRenderer
+		*  @param[in] EProgramVariant nVariant
+		*
+		*  @return
+		*    program, a null pointer on error (do not destroy the returned instance!)
+		*/
+		PLBERKELIUM_API PLRenderer::ProgramWrapper *Get(PLRenderer::Renderer &cRenderer, EProgramVariant nVariant);
+
+		/**
+		*  @brief
+		*    Returns the unit quad, creates it on first use
+		*
+		*  @param[in] PLRenderer::Renderer & cRenderer
+		*
+		*  @return
+		*    unit quad, a null pointer on error (do not destroy the returned instance!)
+		*/
+		PLBERKELIUM_API PLRenderer::VertexBuffer *GetUnitQuad(PLRenderer::Renderer &cRenderer);
+
+		/**
+		*  @brief
+		*    Destroys all programs and unit quads
+		*
+		*  @remarks
+		*    Programs and unit quads handed out before are no longer valid.
+		*/
+		PLBERKELIUM_API void Clear();
+
+		/**
+		*  @brief
+		*    Returns the number of cached programs
+		*
+		*  @return
+		*    number of programs
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfPrograms() const;
+
+		/**
+		*  @brief
+		*    Returns the cache statistics
+		*
+		*  @return
+		*    statistics since creation
+		*/
+		PLBERKELIUM_API const sProgramCacheStats &GetStats() const;
+
+		/**
+		*  @brief
+		*    Compiles and links the program of a variant
+		*
+		*  @remarks
+		*    For users without cache, the program does not take over the shaders, the caller destroys all three.
+		*
+		*  @param[in] PLRenderer::Renderer & cRenderer
+		*  @param[in] EProgramVariant nVariant
+		*  @param[out] PLRenderer::VertexShader *& pVertexShader
+		*  @param[out] PLRenderer::FragmentShader *& pFragmentShader
+		*
+		*  @return
+		*    program, a null pointer on error
+		*/
+		PLBERKELIUM_API static PLRenderer::ProgramWrapper *CreateProgram(PLRenderer::Renderer &cRenderer, EProgramVariant nVariant, PLRenderer::VertexShader *&pVertexShader, PLRenderer::FragmentShader *&pFragmentShader);
+
+		/**
+		*  @brief
+		*    Creates a static unit quad, a triangle strip from (0, 0) to (1, 1) with the same texture coordinates
+		*
+		*  @remarks
+		*    For users without cache, the caller destroys it.
+		*
+		*  @param[in] PLRenderer::Renderer & cRenderer
+		*
+		*  @return
+		*    unit quad, a null pointer on error
+		*/
+		PLBERKELIUM_API static PLRenderer::VertexBuffer *CreateUnitQuad(PLRenderer::Renderer &cRenderer);
+
+		/**
+		*  @brief
+		*    Places the unit quad for the next draw with a program
+		*
+		*  @param[in] PLRenderer::ProgramWrapper & cProgramWrapper
+		*  @param[in] const PLMath::Vector2 & vPosition
+		*    top left corner in pixels
+		*  @param[in] const PLMath::Vector2 & vSize
+		*    size in pixels
+		*  @param[in] const PLMath::Vector2 & vTextureCoordinateScale
+		*    texture coordinate size the quad samples, the used part of the texture
+		*  @param[in] const PLMath::Vector2 & vTextureCoordinateOffset
+		*    texture coordinate of the top left corner
+		*  @param[in] const float & fOpacity
+		*    factor the texel alpha is multiplied with
+		*  @param[in] const bool & bPremultiply
+		*    multiply the color with the alpha, for drawing into a target that is presented with premultiplied blending
+		*/
+		PLBERKELIUM_API static void SetQuad(PLRenderer::ProgramWrapper &cProgramWrapper, const PLMath::Vector2 &vPosition, const PLMath::Vector2 &vSize, const PLMath::Vector2 &vTextureCoordinateScale = PLMath::Vector2::One, const PLMath::Vector2 &vTextureCoordinateOffset = PLMath::Vector2::Zero, const float &fOpacity = 1.0f, const bool &bPremultiply = false);
+
+	protected:
+
+	private:
+		PLCore::HashMap<PLCore::String, sCachedProgram*> m_mapPrograms;
+		PLCore::HashMap<PLCore::String, PLRenderer::VertexBuffer*> m_mapUnitQuads;
+		sProgramCacheStats m_sStats;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_PROGRAMCACHE_H__
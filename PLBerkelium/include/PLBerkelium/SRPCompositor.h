@@ -0,0 +1,424 @@
+#ifndef __PLBERKELIUM_SRPCOMPOSITOR_H__
+#define __PLBERKELIUM_SRPCOMPOSITOR_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/System/System.h>
+#include <PLCore/System/Console.h>
+#include <PLCore/Container/Array.h>
+#include <PLScene/Compositing/SceneRendererPass.h>
+#include <PLScene/Compositing/SceneRenderer.h>
+#include <PLRenderer/Renderer/Renderer.h>
+#include <PLRenderer/Renderer/VertexBuffer.h>
+#include <PLRenderer/Renderer/TextureBuffer.h>
+#include <PLRenderer/Renderer/ProgramWrapper.h>
+#include <PLRenderer/Renderer/VertexShader.h>
+#include <PLRenderer/Renderer/FragmentShader.h>
+#include <PLRenderer/Renderer/SurfaceTextureBuffer.h>
+#include <PLMath/Vector2.h>
+#include <PLMath/Matrix4x4.h>
+
+#include "PLBerkelium.h"
+#include "ProgramCache.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Forward declarations                                  ]
+//[-------------------------------------------------------]
+class SRPWindow;
+
+
+//[-------------------------------------------------------]
+//[ Definitions                                           ]
+//[-------------------------------------------------------]
+enum ECompositeDirtyReason
+{
+	CompositeDirtyUpload = 0,		/**< A window or widget texture changed */
+	CompositeDirtyMove,				/**< A quad moved, was resized or its animated opacity changed */
+	CompositeDirtyOrder,			/**< The z-order of the windows changed */
+	CompositeDirtyVisibility,		/**< A window or widget was shown or hidden */
+	CompositeDirtyViewport,			/**< The viewport size changed, the cache was (re)created */
+	CompositeDirtyInvalidated,		/**< Asked for by Invalidate() or a setting of the compositor changed */
+	NumOfCompositeDirtyReasons
+};
+
+
+//[-------------------------------------------------------]
+//[ Structures                                            ]
+//[-------------------------------------------------------]
+struct sCompositorQuad
+{
+	PLRenderer::TextureBuffer *pTextureBuffer;	/**< Texture of the window or widget, owned by the window */
+	PLMath::Vector2 vPosition;					/**< Top left corner in pixels */
+	PLMath::Vector2 vSize;						/**< Size in pixels */
+	PLMath::Vector2 vTextureCoordinateScale;	/**< Used part of the texture */
+	PLMath::Vector2 vTextureCoordinateOffset;	/**< Inset of the used part, half a texel with linear filtering */
+	float fOpacity;								/**< Opacity of the window the quad belongs to */
+	bool bSwizzle;								/**< The texture holds the berkelium BGRA data as is, the shader swizzles */
+	bool bOpaque;								/**< The window is not transparent and not faded, the quad is drawn without blending */
+	bool bCulled;								/**< The quad is covered by an opaque quad in front of it and not drawn */
+	bool bLinear;								/**< The window renders below its size, the texture is upscaled with linear filtering */
+};
+
+
+struct sCompositorStats
+{
+	PLCore::uint32 nQuads;				/**< Window and widget quads drawn in the last frame */
+	PLCore::uint32 nCulled;				/**< Quads of visible windows and widgets not drawn in the last frame because an opaque quad covered them */
+	PLCore::uint32 nOpaque;				/**< Quads drawn without blending in the last frame */
+	PLCore::uint32 nDrawCalls;			/**< Draw calls issued in the last frame, one per quad */
+	PLCore::uint32 nProgramChanges;		/**< Programs set in the last frame, the shared state is set once per program */
+	PLCore::uint32 nTextureChanges;		/**< Textures bound in the last frame */
+};
+
+
+struct sCompositeCacheStats
+{
+	PLCore::uint32 nRecomposites;							/**< Frames the quads were drawn into the composite cache */
+	PLCore::uint32 nPresents;								/**< Frames the composite cache was drawn to the screen */
+	PLCore::uint32 nDirtyReasons[NumOfCompositeDirtyReasons];	/**< Recomposites per reason, one recomposite can have several reasons */
+};
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Scene render pass that draws all windows and widgets of a Gui in one go
+*
+*  @remarks
+*    Instead of one scene render pass per window that sets the program, blend state, sampler states and
+*    matrix for four vertices, the windows are kept here in z-order. Each frame the quads of the visible windows
+*    and their widgets are collected back to front and drawn from the shared unit quad, the shared state is set
+*    once, the program and texture only when they change and per quad only the placement uniforms are set.
+*    Every window and widget has its own texture, so there is one draw call per quad.
+*    Quads inside an opaque quad in front of them are culled, opaque quads (windows that are not transparent and
+*    not faded) are drawn without blending. See SetDepthOrdered() for drawing the opaque quads front to back
+*    and SetCached() for drawing the quads only when something changed.
+*/
+class SRPCompositor : public PLScene::SceneRendererPass {
+
+
+	//[-------------------------------------------------------]
+	//[ RTTI interface                                        ]
+	//[-------------------------------------------------------]
+	pl_class(PLBERKELIUM_RTTI_EXPORT, SRPCompositor, "PLBerkelium", PLScene::SceneRendererPass, "")
+		pl_constructor_2(ParameterConstructor, PLRenderer::Renderer*, PLScene::SceneRenderer*, "", "")
+	pl_class_end
+
+
+	public:
+		PLBERKELIUM_API SRPCompositor(PLRenderer::Renderer *pRenderer, PLScene::SceneRenderer *pSceneRenderer);
+		PLBERKELIUM_API virtual ~SRPCompositor();
+
+		/**
+		*  @brief
+		*    Destroys this instance
+		*/
+		PLBERKELIUM_API void DestroyInstance() const;
+
+		/**
+		*  @brief
+		*    Returns whether or not the compositor is added to the scene renderer
+		*
+		*  @return
+		*    'true' if initialized, else 'false'
+		*/
+		PLBERKELIUM_API bool IsInitialized() const;
+
+		/**
+		*  @brief
+		*    Adds a window on top of all other windows
+		*
+		*  @param[in] SRPWindow * pSRPWindow
+		*
+		*  @return
+		*    'true' if the window was added, 'false' if it is already there
+		*/
+		PLBERKELIUM_API bool AddWindow(SRPWindow *pSRPWindow);
+
+		/**
+		*  @brief
+		*    Removes a window
+		*
+		*  @param[in] SRPWindow * pSRPWindow
+		*
+		*  @return
+		*    'true' if the window was removed, else 'false'
+		*/
+		PLBERKELIUM_API bool RemoveWindow(SRPWindow *pSRPWindow);
+
+		/**
+		*  @brief
+		*    Moves a window on top of all other windows
+		*
+		*  @param[in] SRPWindow * pSRPWindow
+		*/
+		PLBERKELIUM_API void MoveToFront(SRPWindow *pSRPWindow);
+
+		/**
+		*  @brief
+		*    Returns the z-order index of a window
+		*
+		*  @param[in] SRPWindow * pSRPWindow
+		*
+		*  @return
+		*    index, higher is more in front, -1 if the window is not composited
+		*/
+		PLBERKELIUM_API int GetIndex(SRPWindow *pSRPWindow) const;
+
+		/**
+		*  @brief
+		*    Returns the number of composited windows
+		*
+		*  @return
+		*    number of windows
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfWindows() const;
+
+		/**
+		*  @brief
+		*    Returns a composited window
+		*
+		*  @param[in] PLCore::uint32 nIndex
+		*    z-order index, 0 is the back most window
+		*
+		*  @return
+		*    window, a null pointer if the index is out of range
+		*/
+		PLBERKELIUM_API SRPWindow *GetWindow(PLCore::uint32 nIndex) const;
+
+		/**
+		*  @brief
+		*    Returns the statistics of the last frame
+		*
+		*  @return
+		*    statistics of the last draw
+		*/
+		PLBERKELIUM_API const sCompositorStats &GetStats() const;
+
+		/**
+		*  @brief
+		*    Sets whether the opaque quads are drawn front to back with the depth test keeping the z-order
+		*
+		*  @remarks
+		*    The opaque quads then go first, front to back, and the GPU rejects what they cover before shading it,
+		*    the blended quads follow back to front. Partly covered opaque windows then cost no overdraw.
+		*    The depth buffer of the render target is cleared for it, so only turn this on when the render target has
+		*    a depth buffer and no pass after the compositor needs the scene depth. Off by default, all quads are then
+		*    drawn back to front.
+		*
+		*  @param[in] const bool & bDepthOrdered
+		*/
+		PLBERKELIUM_API void SetDepthOrdered(const bool &bDepthOrdered);
+
+		/**
+		*  @brief
+		*    Returns whether the opaque quads are drawn front to back with the depth test keeping the z-order
+		*
+		*  @return
+		*    'true' if depth ordered, else 'false'
+		*/
+		PLBERKELIUM_API bool IsDepthOrdered() const;
+
+		/**
+		*  @brief
+		*    Sets whether the quads are composed into a cache that is presented with one fullscreen quad
+		*
+		*  @remarks
+		*    Most frames no window changes. With the cache the quads are only drawn into it when a window or widget
+		*    uploaded, moved, changed its z-order or visibility or the viewport size changed (see ECompositeDirtyReason),
+		*    all other frames draw the cache only. The cache is a render target of viewport size with premultiplied
+		*    colors, depth ordering then clears the depth buffer of the cache instead of the one of the scene.
+		*    Off by default.
+		*
+		*  @param[in] const bool & bCached
+		*/
+		PLBERKELIUM_API void SetCached(const bool &bCached);
+
+		/**
+		*  @brief
+		*    Returns whether the quads are composed into a cache
+		*
+		*  @return
+		*    'true' if cached, else 'false'
+		*/
+		PLBERKELIUM_API bool IsCached() const;
+
+		/**
+		*  @brief
+		*    Marks the composite cache as outdated, the quads are drawn into it on the next frame
+		*
+		*  @remarks
+		*    The windows call this when they upload, the placement, z-order and visibility of the quads and the
+		*    viewport size are compared every frame.
+		*
+		*  @param[in] const ECompositeDirtyReason & nReason
+		*/
+		PLBERKELIUM_API void Invalidate(const ECompositeDirtyReason &nReason = CompositeDirtyInvalidated);
+
+		/**
+		*  @brief
+		*    Returns the composite cache statistics
+		*
+		*  @return
+		*    statistics since creation
+		*/
+		PLBERKELIUM_API const sCompositeCacheStats &GetCacheStats() const;
+
+		/**
+		*  @brief
+		*    Sets the cache the programs are taken from
+		*
+		*  @remarks
+		*    The cache is owned by the creator of the compositor (see Gui), a null pointer lets the compositor create its own programs.
+		*
+		*  @param[in] ProgramCache * pProgramCache
+		*/
+		PLBERKELIUM_API void SetProgramCache(ProgramCache *pProgramCache);
+
+	protected:
+
+	private:
+		void DebugToConsole(const PLCore::String &sString);
+
+		virtual void Draw(PLRenderer::Renderer &cRenderer, const PLScene::SQCull &cCullQuery) override;
+
+		/**
+		*  @brief
+		*    Adds a quad to the list drawn this frame, grows the list if needed
+		*
+		*  @param[in] const sCompositorQuad & sQuad
+		*/
+		void AddQuad(const sCompositorQuad &sQuad);
+
+		/**
+		*  @brief
+		*    Draws the collected quads that are not culled to the current render target
+		*
+		*  @param[in] const PLMath::Matrix4x4 & mObjectSpaceToClipSpace
+		*/
+		void DrawQuads(const PLMath::Matrix4x4 &mObjectSpaceToClipSpace);
+
+		/**
+		*  @brief
+		*    Draws the collected quads into the composite cache if it is outdated and draws the cache
+		*
+		*  @param[in] const PLMath::Matrix4x4 & mObjectSpaceToClipSpace
+		*
+		*  @return
+		*    'true' if the cache was drawn, 'false' if the cache could not be created
+		*/
+		bool DrawCached(const PLMath::Matrix4x4 &mObjectSpaceToClipSpace);
+
+		/**
+		*  @brief
+		*    Compares the collected quads with the ones of the last frame
+		*
+		*  @return
+		*    dirty reasons as bits (1 << ECompositeDirtyReason), 0 if nothing changed
+		*/
+		PLCore::uint32 CompareQuads() const;
+
+		/**
+		*  @brief
+		*    Destroys the composite cache
+		*/
+		void DestroyCache();
+
+		/**
+		*  @brief
+		*    Draws a collected quad, sets the program and texture only when they change
+		*
+		*  @param[in] PLCore::uint32 nIndex
+		*    z-order index of the quad, 0 is the back most quad
+		*  @param[in] const PLMath::Matrix4x4 & mObjectSpaceToClipSpace
+		*  @param[in, out] PLRenderer::ProgramWrapper *& pCurrentProgramWrapper
+		*  @param[in, out] PLRenderer::TextureBuffer *& pCurrentTextureBuffer
+		*/
+		void DrawQuad(PLCore::uint32 nIndex, const PLMath::Matrix4x4 &mObjectSpaceToClipSpace, PLRenderer::ProgramWrapper *&pCurrentProgramWrapper, PLRenderer::TextureBuffer *&pCurrentTextureBuffer);
+
+		/**
+		*  @brief
+		*    Marks the collected quads that are inside an opaque quad in front of them
+		*
+		*  @return
+		*    number of culled quads
+		*/
+		PLCore::uint32 CullOccludedQuads();
+
+		/**
+		*  @brief
+		*    Adds the quads of a window and its widgets
+		*
+		*  @param[in] SRPWindow * pSRPWindow
+		*/
+		void AddWindowQuads(SRPWindow *pSRPWindow);
+
+		/**
+		*  @brief
+		*    Returns the unit quad all quads are drawn with, takes it from the cache or creates it on first use
+		*
+		*  @return
+		*    unit quad, a null pointer on error
+		*/
+		PLRenderer::VertexBuffer *GetUnitQuad();
+
+		/**
+		*  @brief
+		*    Returns the program for the given texture layout, takes it from the cache or creates it on first use
+		*
+		*  @param[in] const bool & bSwizzle
+		*
+		*  @return
+		*    program, a null pointer on error
+		*/
+		PLRenderer::ProgramWrapper *GetProgramWrapper(const bool &bSwizzle);
+
+		/**
+		*  @brief
+		*    Destroys the own programs, their shaders and the own unit quad, lets go of the cached ones
+		*/
+		void DestroyProgramWrappers();
+
+		PLScene::SceneRenderer *m_pCurrentSceneRenderer;
+		PLRenderer::Renderer *m_pCurrentRenderer;
+		bool m_bInitialized;
+		PLCore::Array<SRPWindow*> m_lstWindows;
+		sCompositorQuad *m_pQuads;
+		PLCore::uint32 m_nMaxQuads;
+		PLCore::uint32 m_nNumOfQuads;
+		sCompositorQuad *m_pLastQuads;		/**< Quads of the last frame, only kept with the composite cache */
+		PLCore::uint32 m_nMaxLastQuads;
+		PLCore::uint32 m_nNumOfLastQuads;
+		PLRenderer::VertexBuffer *m_pVertexBuffer;
+		PLRenderer::ProgramWrapper *m_pProgramWrappers[NumOfProgramVariants];
+		PLRenderer::VertexShader *m_pVertexShaders[NumOfProgramVariants];
+		PLRenderer::FragmentShader *m_pFragmentShaders[NumOfProgramVariants];
+		sCompositorStats m_sStats;
+		ProgramCache *m_pProgramCache;
+		bool m_bDepthOrdered;
+		bool m_bCached;
+		bool m_bPremultiply;							/**< The quads are drawn into the composite cache */
+		PLRenderer::SurfaceTextureBuffer *m_pCacheSurface;
+		PLCore::uint32 m_nDirtyReasons;					/**< Reasons the composite cache is outdated as bits (1 << ECompositeDirtyReason) */
+		sCompositeCacheStats m_sCacheStats;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_SRPCOMPOSITOR_H__
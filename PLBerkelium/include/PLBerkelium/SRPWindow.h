@@ -24,6 +24,7 @@
 #include <PLRenderer/RendererContext.h>
 #include <PLRenderer/Renderer/VertexShader.h>
 #include <PLRenderer/Renderer/FragmentShader.h>
+#include <PLRenderer/Renderer/SurfaceTextureBuffer.h>
 #include <PLGraphics/Image/Image.h>
 #include <PLGraphics/Image/ImageBuffer.h>
 #include <PLMath/Vector2.h>
@@ -39,6 +40,16 @@
 #include "berkelium/ScriptUtil.hpp"
 
 #include "PLBerkelium.h"
+#include "TextureUploader.h"
+#include "BufferCopy.h"
+#include "CopyWorkerPool.h"
+#include "DamageRegion.h"
+#include "SurfacePool.h"
+#include "ProgramCache.h"
+#include "SRPCompositor.h"
+#include "WindowAnimator.h"
+#include "HitTestIndex.h"
+#include "AlphaMask.h"
 
 
 //[-------------------------------------------------------]
@@ -64,6 +75,13 @@ namespace PLBerkelium {
 #define HIDEWINDOW "HideWindow"
 #define CLOSEWINDOW "CloseWindow"
 #define RESIZEWINDOW "ResizeWindow"
+#define FADEWINDOW "FadeWindow"
+#define SLIDEWINDOW "SlideWindow"
+#define SCALEWINDOW "ScaleWindow"
+#define MAXCALLBACKNUMBERS 4		/**< Number parameters of a default callback that are kept for the Gui */
+#define TOOLTIPFADEINTIME 150		/**< Milliseconds the tool tip fades in */
+#define TOOLTIPFADEOUTTIME 100		/**< Milliseconds the tool tip fades out */
+#define MINRENDERSCALE 0.125f		/**< Smallest fraction of the window size berkelium renders at */
 
 
 //[-------------------------------------------------------]
@@ -82,6 +100,32 @@ struct sWindowsData
 	bool bMouseEnabled;
 	bool bNeedsFullUpdate;
 	bool bLoaded;
+	float fFullUploadThreshold;	/**< Fraction of the surface above which dirty rectangles are uploaded as a full texture upload */
+	bool bSwizzleOnCopy;		/**< Swizzle BGRA to RGBA while copying, else the shader swizzles, change it with SRPWindow::SetSwizzleOnCopy() */
+	bool bScrollOnGPU;			/**< Move the scrolled region inside the texture on the GPU, only the exposed rectangles are uploaded */
+	PLCore::uint32 nNumOfPixelBuffers;	/**< Pixel unpack buffers used to stream uploads (0 uploads straight to the texture), change it with SRPWindow::SetNumOfPixelBuffers() */
+	bool bZeroCopy;				/**< Paint straight into mapped upload memory without an image buffer, change it with SRPWindow::SetZeroCopy() */
+	PLCore::uint32 nUploadCallCost;	/**< Pixels that cost as much to upload as one upload call, dirty rectangles are merged when that is cheaper */
+	bool bSuspendCopyWhenHidden;	/**< While hidden paints are dropped and a full paint is requested on show, else paints are copied and only the upload waits for the show */
+	PLCore::uint32 nResizeIdleTime;	/**< Milliseconds a drag resize has to rest before the page is resized, until then only the texture is previewed (0 resizes the page on every move) */
+	bool bResizeStretch;			/**< Stretch the texture over the previewed size during a drag resize, else crop it (the window then only grows when the resize is committed) */
+	float fOpacity;					/**< Opacity the window and its widgets are drawn with, at 0 they are not drawn at all */
+	PLMath::Vector2 vTranslation;	/**< Offset in pixels the window and its widgets are drawn at, mouse input keeps to the window position */
+	float fScale;					/**< Scale the window and its widgets are drawn at around the center of the window, mouse input keeps to the window size */
+	float fRenderScale;				/**< Fraction of the window size berkelium renders at, the texture is upscaled with linear filtering, change it with SRPWindow::SetRenderScale() */
+	bool bClickThrough;				/**< The mouse goes through pixels with an alpha up to CLICKTHROUGHALPHA to what is behind the window, change it with SRPWindow::SetClickThrough() */
+};
+
+
+struct sWindowStats
+{
+	PLCore::uint32 nPaints;			/**< onPaint calls that changed the image */
+	PLCore::uint32 nPaintsMerged;	/**< onPaint calls merged into an upload that was already pending */
+	PLCore::uint32 nUploads;		/**< Uploads issued to the GPU */
+	PLCore::uint32 nPaintsHidden;	/**< onPaint calls while hidden, dropped or with the upload deferred to the show */
+	PLCore::uint32 nResyncs;		/**< Full paints requested on show because paints were dropped while hidden */
+	PLCore::uint32 nResizes;		/**< Resizes sent to berkelium, each one relayouts and repaints the page */
+	PLCore::uint32 nResizePreviews;	/**< Drag resize steps that only moved the quad on the GPU */
 };
 
 
@@ -93,20 +137,21 @@ struct sCallBack
 	PLCore::String sFunctionName;
 	size_t nNumberOfParameters;
 	Berkelium::Script::Variant *pParameters;		/**< Free the resource if you no longer need it */
+	PLCore::uint32 nNumOfNumbers;					/**< Leading number parameters copied while javascript called, at most MAXCALLBACKNUMBERS */
+	double fNumbers[MAXCALLBACKNUMBERS];			/**< The copied number parameters, valid after the call unlike pParameters */
 };
 
 
 struct sWidget
 {
-	PLRenderer::VertexBuffer *pVertexBuffer;		/**< Free the resource if you no longer need it */
 	PLRenderer::ProgramWrapper *pProgramWrapper;	/**< Shared, points to SRPWindow::m_pProgramWrapper, do not free the memory */
-	PLRenderer::TextureBuffer *pTextureBuffer;		/**< Free the resource if you no longer need it */
+	PLRenderer::TextureBuffer *pTextureBuffer;		/**< Free the resource if you no longer need it, a null pointer until the first resize */
 	PLGraphics::Image cImage;
-	int nWidth;
-	int nHeight;
+	int nWidth;										/**< 0 until the first resize */
+	int nHeight;									/**< 0 until the first resize */
 	int nXPos;
 	int nYPos;
-	bool bNeedsFullUpdate;
+	bool bNeedsFullUpdate;							/**< Until the first paint the texture holds nothing to compose */
 };
 
 
@@ -124,6 +169,9 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 	pl_class_end
 
 
+	friend class SRPCompositor;
+
+
 	public:
 		PLBERKELIUM_API SRPWindow(const PLCore::String &sName);
 		PLBERKELIUM_API virtual ~SRPWindow();
@@ -190,6 +238,10 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 		*  @brief
 		*    Adds the SceneRenderPass for this window to the SceneRenderer
 		*
+		*  @remarks
+		*    With a compositor set (see SetCompositor()) the window is added to the compositor instead,
+		*    the compositor draws all its windows within its own SceneRenderPass.
+		*
 		*  @param[in] PLScene::SceneRenderer * pSceneRenderer
 		*
 		*  @return
@@ -243,6 +295,9 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 		*  @brief
 		*    Returns the size of this window
 		*
+		*  @note
+		*    While a resize preview is pending this is the previewed size.
+		*
 		*  @return
 		*    window size
 		*/
@@ -252,12 +307,30 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 		*  @brief
 		*    Returns the mouse positions relative to this window
 		*
+		*  @remarks
+		*    The position is in the pixels berkelium renders, so below a render scale of 1 it is scaled down
+		*    (see SetRenderScale()), use it for the mouse input of the page.
+		*
 		*  @param[in] const PLMath::Vector2i & vMousePos
 		*
 		*  @return
 		*    mouse position relative to window
 		*/
 		PLBERKELIUM_API PLMath::Vector2i GetRelativeMousePosition(const PLMath::Vector2i &vMousePos) const;
+
+		/**
+		*  @brief
+		*    Returns the mouse positions relative to this window in screen pixels
+		*
+		*  @remarks
+		*    Unlike GetRelativeMousePosition() the position is not scaled by the render scale, it compares with GetSize().
+		*
+		*  @param[in] const PLMath::Vector2i & vMousePos
+		*
+		*  @return
+		*    mouse position relative to window
+		*/
+		PLBERKELIUM_API PLMath::Vector2i GetRelativeMousePositionOnScreen(const PLMath::Vector2i &vMousePos) const;
 		
 		/**
 		*  @brief
@@ -323,6 +396,10 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 		*  @brief
 		*    Resizes window to given size
 		*
+		*  @remarks
+		*    Berkelium is asked for the new size, the image and texture follow when berkelium paints the new size.
+		*    Until then the current content is shown at the new size, the same way a resize preview is shown.
+		*
 		*  @note
 		*    Its not advisable to resize a window smaller than 4x4 pixels.
 		*
@@ -331,6 +408,57 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 		*/
 		PLBERKELIUM_API void ResizeWindow(const int &nWidth, const int &nHeight);
 		
+		/**
+		*  @brief
+		*    Previews a resize of the window without resizing the page
+		*
+		*  @remarks
+		*    Only the quad of the window is changed, the current texture is stretched or cropped to the new size
+		*    (see sWindowsData::bResizeStretch). The page is resized by CommitResize() or by UpdateResize() once
+		*    the preview rested for sWindowsData::nResizeIdleTime. With an idle time of 0 the page is resized right away.
+		*
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*/
+		PLBERKELIUM_API void PreviewResize(const int &nWidth, const int &nHeight);
+		
+		/**
+		*  @brief
+		*    Resizes the page to the previewed size once the preview rested for the resize idle time
+		*
+		*  @return
+		*    'true' if the page was resized, else 'false'
+		*/
+		PLBERKELIUM_API bool UpdateResize();
+		
+		/**
+		*  @brief
+		*    Resizes the page to the previewed size right away
+		*
+		*  @return
+		*    'true' if a preview was pending, else 'false'
+		*/
+		PLBERKELIUM_API bool CommitResize();
+		
+		/**
+		*  @brief
+		*    Returns whether or not a resize preview is pending
+		*
+		*  @return
+		*    'true' if the window shows a previewed size, else 'false'
+		*/
+		PLBERKELIUM_API bool IsResizePending() const;
+		
+		/**
+		*  @brief
+		*    Uploads everything painted since the last upload to the texture
+		*
+		*  @remarks
+		*    Called by the Gui for all windows after berkelium was updated, so the window passes only draw finished
+		*    textures. A hidden window keeps collecting damage, it is uploaded when the window is shown.
+		*/
+		PLBERKELIUM_API void Upload();
+		
 		/**
 		*  @brief
 		*    Adds and sets a Javascript callback method for this window
@@ -365,6 +493,9 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 		*  @brief
 		*    Returns the mouse position relative to a widget
 		*
+		*  @remarks
+		*    The position is in the pixels berkelium renders, like the widget size.
+		*
 		*  @param[in] const sWidget * psWidget
 		*  @param[in] const PLMath::Vector2i & vMousePos
 		*
@@ -399,11 +530,224 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 		*
 		*  @remarks
 		*    You can for example use this to save or use the image of this window somewhere else.
+		*    In zero copy mode the image is read back from the texture, so it shows the window as it was drawn last.
 		*
 		*  @return
 		*    image of this window
 		*/
 		PLBERKELIUM_API PLGraphics::Image GetImage() const;
+		
+		/**
+		*  @brief
+		*    Sets whether the berkelium BGRA data is swizzled to RGBA while copying
+		*
+		*  @remarks
+		*    When swizzled the texture and the image of this window hold canonical RGBA that other code can sample,
+		*    else the BGRA data is kept and the window shader swizzles per fragment.
+		*    The current image content is converted in place so no repaint is needed.
+		*
+		*  @param[in] const bool & bSwizzle
+		*/
+		PLBERKELIUM_API void SetSwizzleOnCopy(const bool &bSwizzle);
+		
+		/**
+		*  @brief
+		*    Returns the paint and upload statistics of this window
+		*
+		*  @return
+		*    statistics since creation or the last ResetStats()
+		*/
+		PLBERKELIUM_API const sWindowStats &GetStats() const;
+		
+		/**
+		*  @brief
+		*    Resets the paint and upload statistics of this window
+		*/
+		PLBERKELIUM_API void ResetStats();
+		
+		/**
+		*  @brief
+		*    Returns the texture upload statistics of this window and its widgets
+		*
+		*  @return
+		*    upload statistics since creation or the last ResetStats()
+		*/
+		PLBERKELIUM_API const sUploadStats &GetUploadStats() const;
+		
+		/**
+		*  @brief
+		*    Sets the number of pixel unpack buffers used to stream texture uploads of this window and its widgets
+		*
+		*  @remarks
+		*    With 2 or 3 buffers the upload is queued on the GPU and the render thread does not stall on a texture
+		*    the driver still uses for the previous frame. 0 uploads straight to the texture.
+		*
+		*  @param[in] const PLCore::uint32 & nNumOfBuffers
+		*
+		*  @return
+		*    'true' if the pixel buffers are in use, else 'false' (e.g. no pixel buffer object support)
+		*/
+		PLBERKELIUM_API bool SetNumOfPixelBuffers(const PLCore::uint32 &nNumOfBuffers);
+		
+		/**
+		*  @brief
+		*    Sets whether paint data is written straight into mapped upload memory
+		*
+		*  @remarks
+		*    In zero copy mode the window keeps no image buffer, berkelium paints are copied (and swizzled) straight
+		*    into a mapped staging buffer and uploaded from there. GetImage() then reads the texture back.
+		*    Zero copy implies swizzle on copy and scroll on the GPU, if the GPU can not scroll or the staging buffer
+		*    can not be mapped the window leaves zero copy mode by itself. Widgets keep their (small) image buffers.
+		*
+		*  @param[in] const bool & bZeroCopy
+		*
+		*  @return
+		*    'true' if zero copy mode is on, else 'false' (e.g. no pixel buffer object support)
+		*/
+		PLBERKELIUM_API bool SetZeroCopy(const bool &bZeroCopy);
+
+		/**
+		*  @brief
+		*    Sets the fraction of the window size berkelium renders the page at
+		*
+		*  @remarks
+		*    Below 1 the page is rendered smaller and the texture is upscaled to the window size with linear filtering,
+		*    at half scale copies, uploads and rasterization cost a quarter. Meant for windows where sharpness does not
+		*    matter (e.g. minimap overlays or ambient panels). The window size, position and the Gui keep to screen
+		*    pixels, the mouse is converted for the page (see GetRelativeMousePosition()). The page is resized to the
+		*    scaled size, the old content is stretched over the window until berkelium painted it.
+		*
+		*  @param[in] const float & fRenderScale
+		*    fraction from MINRENDERSCALE to 1
+		*/
+		PLBERKELIUM_API void SetRenderScale(const float &fRenderScale);
+
+		/**
+		*  @brief
+		*    Returns the fraction of the window size berkelium renders the page at
+		*
+		*  @return
+		*    render scale
+		*/
+		PLBERKELIUM_API float GetRenderScale() const;
+
+		/**
+		*  @brief
+		*    Returns the size berkelium renders the page at, the size of the image and of the used part of the texture
+		*
+		*  @return
+		*    render size
+		*/
+		PLBERKELIUM_API PLMath::Vector2i GetRenderSize() const;
+
+		/**
+		*  @brief
+		*    Sets whether or not the mouse goes through the transparent pixels of the window
+		*
+		*  @remarks
+		*    Meant for mostly transparent windows (e.g. a HUD over the scene). The window keeps a mask with one bit per
+		*    4x4 block that follows the paints (see AlphaMask), so a hit test reads a single bit. When turned on the mask
+		*    is built from the image, without image (zero copy mode) the window takes the mouse until the next full paint.
+		*    Widgets always take the mouse.
+		*
+		*  @param[in] const bool & bClickThrough
+		*/
+		PLBERKELIUM_API void SetClickThrough(const bool &bClickThrough);
+
+		/**
+		*  @brief
+		*    Returns the mask the mouse goes through the transparent pixels of the window with
+		*
+		*  @return
+		*    alpha mask in rendered pixels, a null pointer if the window takes the mouse on its whole rectangle (do not destroy the returned instance!)
+		*/
+		PLBERKELIUM_API const AlphaMask *GetAlphaMask() const;
+		
+		/**
+		*  @brief
+		*    Sets the worker pool that shares the paint copies of this window
+		*
+		*  @remarks
+		*    The pool is owned by the creator of the window (see Gui), a null pointer copies on the calling thread.
+		*    The tool tip window uses the same pool.
+		*
+		*  @param[in] CopyWorkerPool * pCopyWorkerPool
+		*/
+		PLBERKELIUM_API void SetCopyWorkerPool(CopyWorkerPool *pCopyWorkerPool);
+		
+		/**
+		*  @brief
+		*    Sets the pool the window and widget textures are taken from
+		*
+		*  @remarks
+		*    The pool is owned by the creator of the window (see Gui), a null pointer creates textures at the exact size.
+		*    Set it before Initialize(), the tool tip window uses the same pool.
+		*
+		*  @param[in] SurfacePool * pSurfacePool
+		*/
+		PLBERKELIUM_API void SetSurfacePool(SurfacePool *pSurfacePool);
+		
+		/**
+		*  @brief
+		*    Sets the compositor that draws the window
+		*
+		*  @remarks
+		*    The compositor is owned by the creator of the window (see Gui), a null pointer lets the window draw
+		*    within its own SceneRenderPass. Set it before AddSceneRenderPass(), the tool tip window uses the same compositor.
+		*
+		*  @param[in] SRPCompositor * pCompositor
+		*/
+		PLBERKELIUM_API void SetCompositor(SRPCompositor *pCompositor);
+		
+		/**
+		*  @brief
+		*    Sets the cache the program and unit quad of the window and its widgets are taken from
+		*
+		*  @remarks
+		*    The cache is owned by the creator of the window (see Gui), a null pointer lets the window create its own ones.
+		*    The tool tip window uses the same cache.
+		*
+		*  @param[in] ProgramCache * pProgramCache
+		*/
+		PLBERKELIUM_API void SetProgramCache(ProgramCache *pProgramCache);
+		
+		/**
+		*  @brief
+		*    Sets the animator that fades the tool tip window
+		*
+		*  @remarks
+		*    The animator is owned by the creator of the window (see Gui), it stops the tweens of the window when
+		*    the window is destroyed. A null pointer shows and hides the tool tip right away.
+		*
+		*  @param[in] WindowAnimator * pWindowAnimator
+		*/
+		PLBERKELIUM_API void SetWindowAnimator(WindowAnimator *pWindowAnimator);
+		
+		/**
+		*  @brief
+		*    Sets the hit test index the window invalidates when it is moved, resized, shown, hidden or moved to front
+		*
+		*  @remarks
+		*    The index is owned by the creator of the window (see Gui), the tool tip window takes no mouse events
+		*    and does not use it.
+		*
+		*  @param[in] HitTestIndex * pHitTestIndex
+		*/
+		PLBERKELIUM_API void SetHitTestIndex(HitTestIndex *pHitTestIndex);
+		
+		/**
+		*  @brief
+		*    Shows or hides the window
+		*
+		*  @remarks
+		*    A hidden window does not upload, depending on sWindowsData::bSuspendCopyWhenHidden it does not copy either.
+		*    On show the window resyncs once, the damage collected while hidden goes up in a single merged upload,
+		*    or if paints were dropped berkelium is asked for a full paint.
+		*    Setting sWindowsData::bIsVisable directly works as well, the resync then happens on the next draw.
+		*
+		*  @param[in] const bool & bVisible
+		*/
+		PLBERKELIUM_API void SetVisible(const bool &bVisible);
 
 	protected:
 
@@ -687,37 +1031,33 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 		
 		/**
 		*  @brief
-		*    Creates a vertex buffer with given dimensions
-		*
-		*  @param[in] const PLMath::Vector2 & vPosition
-		*  @param[in] const PLMath::Vector2 & vImageSize
+		*    Takes the unit quad the window and its widgets are drawn with
 		*
 		*  @return
-		*    pointer to created vertex buffer (can be a null pointer, destroy the returned instance when you no longer need it)
+		*    pointer to the unit quad of the program cache or an own one (can be a null pointer, do not destroy the returned instance!)
 		*/
-		PLRenderer::VertexBuffer *CreateVertexBuffer(const PLMath::Vector2 &vPosition, const PLMath::Vector2 &vImageSize);
+		PLRenderer::VertexBuffer *CreateUnitQuad();
 		
 		/**
 		*  @brief
-		*    Creates program wrapper
-		*
-		*  @return
-		*    pointer to created or already existing program wrapper (can be a null pointer, do not destroy the returned instance!)
+		*    Destroys the own unit quad, lets go of the one of the program cache
 		*/
-		PLRenderer::ProgramWrapper *CreateProgramWrapper();
+		void DestroyUnitQuad();
 		
 		/**
 		*  @brief
-		*    Updates given vertex buffer with given dimensions
-		*
-		*  @param[in] PLRenderer::VertexBuffer * pVertexBuffer
-		*  @param[in] const PLMath::Vector2 & vPosition
-		*  @param[in] const PLMath::Vector2 & vImageSize
+		*    Destroys the program wrapper and its shaders
+		*/
+		void DestroyProgramWrapper();
+		
+		/**
+		*  @brief
+		*    Creates program wrapper
 		*
 		*  @return
-		*    'true' if vertex buffer was updated, else 'false'
+		*    pointer to created or already existing program wrapper (can be a null pointer, do not destroy the returned instance!)
 		*/
-		bool UpdateVertexBuffer(PLRenderer::VertexBuffer *pVertexBuffer, const PLMath::Vector2 &vPosition, const PLMath::Vector2 &vImageSize);
+		PLRenderer::ProgramWrapper *CreateProgramWrapper();
 		
 		/**
 		*  @brief
@@ -767,6 +1107,72 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 		*  @param[in] const Berkelium::Rect & scrollRect
 		*/
 		void BufferCopyScroll(PLCore::uint8 *pImageBuffer, int &nWidth, int &nHeight, const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, size_t numCopyRects, const Berkelium::Rect *copyRects, int dx, int dy, const Berkelium::Rect &scrollRect);
+
+		/**
+		*  @brief
+		*    Follows a paint with the alpha mask if the mouse goes through the transparent pixels
+		*
+		*  @remarks
+		*    The mask is read from the berkelium buffer, so it does not depend on the image buffer.
+		*
+		*  @param[in] const unsigned char * sourceBuffer
+		*  @param[in] const Berkelium::Rect & sourceBufferRect
+		*  @param[in] size_t numCopyRects
+		*  @param[in] const Berkelium::Rect * copyRects
+		*  @param[in] int dx
+		*  @param[in] int dy
+		*  @param[in] const Berkelium::Rect & scrollRect
+		*/
+		void UpdateAlphaMask(const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, size_t numCopyRects, const Berkelium::Rect *copyRects, int dx, int dy, const Berkelium::Rect &scrollRect);
+		
+		/**
+		*  @brief
+		*    Scrolls the content of a rectangle of the window texture on the GPU
+		*
+		*  @remarks
+		*    The shared region is drawn into a scratch render target and copied back into the texture at its new place,
+		*    two steps because a texture can not be sampled and rendered to at the same time.
+		*    The image buffer is not scrolled, it is outdated until the next full update or until it is read back.
+		*    The first scroll of a window checks the pass against the CPU scroll, if they differ the CPU scrolls.
+		*
+		*  @param[in] int dx
+		*  @param[in] int dy
+		*  @param[in] const Berkelium::Rect & scrollRect
+		*
+		*  @return
+		*    'true' if the texture was scrolled, 'false' if the scroll has to be done on the CPU
+		*/
+		bool BufferScrollOnGPU(int dx, int dy, const Berkelium::Rect &scrollRect);
+		
+		/**
+		*  @brief
+		*    Scrolls the content of a rectangle of a texture on the GPU, see BufferScrollOnGPU()
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*    texture at the render size of the window
+		*  @param[in] int dx
+		*  @param[in] int dy
+		*  @param[in] const Berkelium::Rect & scrollRect
+		*
+		*  @return
+		*    'true' if the texture was scrolled
+		*/
+		bool ScrollTextureOnGPU(PLRenderer::TextureBuffer *pTextureBuffer, int dx, int dy, const Berkelium::Rect &scrollRect);
+		
+		/**
+		*  @brief
+		*    Scrolls a pattern on the GPU, reads it back and compares it with the same scroll on the CPU
+		*
+		*  @return
+		*    'true' if both scrolls gave the same image
+		*/
+		bool VerifyScrollOnGPU();
+		
+		/**
+		*  @brief
+		*    Reads the texture back into the image buffer if the image buffer is outdated
+		*/
+		void SyncImageFromGPU() const;
 		
 		/**
 		*  @brief
@@ -774,6 +1180,223 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 		*/
 		void BufferUploadToGPU();
 		
+		/**
+		*  @brief
+		*    Uploads the whole image buffer or, in zero copy mode, the whole staging buffer to the given texture buffer
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*/
+		void BufferUploadFull(PLRenderer::TextureBuffer *pTextureBuffer);
+		
+		/**
+		*  @brief
+		*    Creates a window or widget texture, from the surface pool if there is one
+		*
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*
+		*  @return
+		*    texture that holds at least the given size, a null pointer on error
+		*/
+		PLRenderer::TextureBuffer *CreateSurfaceTexture(const int &nWidth, const int &nHeight);
+		
+		/**
+		*  @brief
+		*    Destroys a window or widget texture, gives it back to the surface pool if there is one
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*/
+		void DestroySurfaceTexture(PLRenderer::TextureBuffer *pTextureBuffer);
+		
+		/**
+		*  @brief
+		*    Returns whether or not a texture can hold a surface of the given size without being recreated
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*
+		*  @return
+		*    'true' if the texture has the size a new texture would get, else 'false'
+		*/
+		bool IsSurfaceTextureFitting(PLRenderer::TextureBuffer *pTextureBuffer, const int &nWidth, const int &nHeight) const;
+		
+		/**
+		*  @brief
+		*    Returns the buffer berkelium paints are copied into
+		*
+		*  @return
+		*    the mapped staging buffer in zero copy mode, else the image buffer
+		*/
+		PLCore::uint8 *GetPaintBuffer();
+		
+		/**
+		*  @brief
+		*    Marks the whole image buffer to be uploaded with the next flush
+		*/
+		void BufferQueueUpload();
+		
+		/**
+		*  @brief
+		*    Marks rectangles of the image buffer to be uploaded with the next flush
+		*
+		*  @remarks
+		*    Rectangles already covered by a pending rectangle are dropped, too many rectangles turn into a full upload.
+		*
+		*  @param[in] size_t numCopyRects
+		*  @param[in] const Berkelium::Rect * copyRects
+		*/
+		void BufferQueueUpload(size_t numCopyRects, const Berkelium::Rect *copyRects);
+		
+		/**
+		*  @brief
+		*    Uploads everything queued since the last flush in one go
+		*
+		*  @remarks
+		*    Berkelium can paint a window several times within one update, this is called right before the window is drawn.
+		*/
+		void BufferFlushUpload();
+
+		/**
+		*  @brief
+		*    Tells the compositor that a texture of the window or its widgets changed, its composite cache is outdated
+		*/
+		void InvalidateComposite() const;
+
+		/**
+		*  @brief
+		*    Tells the hit test index that the window or its widgets changed where they take the mouse
+		*/
+		void InvalidateHitTest() const;
+		
+		/**
+		*  @brief
+		*    Follows the visibility of the window, resyncs when the window is shown after paints were dropped
+		*/
+		void UpdateSuspension();
+		
+		/**
+		*  @brief
+		*    Updates the quad of the window to its displayed size and the used part of the texture
+		*
+		*  @remarks
+		*    The displayed size is the frame size, or the previewed size while a resize preview is pending.
+		*    The quad only sets the uniforms of the unit quad when drawn, no vertex buffer is touched.
+		*/
+		void UpdateWindowQuad();
+
+		/**
+		*  @brief
+		*    Returns the size berkelium renders a window size at
+		*
+		*  @param[in] const PLMath::Vector2i & vSize
+		*    window size in screen pixels
+		*
+		*  @return
+		*    render size, at least 1 x 1
+		*/
+		PLMath::Vector2i ToRenderSize(const PLMath::Vector2i &vSize) const;
+
+		/**
+		*  @brief
+		*    Returns the filtering the window and widget textures are drawn with
+		*
+		*  @return
+		*    no filtering at a render scale of 1, else linear
+		*/
+		PLRenderer::TextureFiltering::Enum GetTextureFiltering() const;
+
+		/**
+		*  @brief
+		*    Returns the texture coordinates that map a quad to the used part of a window or widget texture
+		*
+		*  @remarks
+		*    With linear filtering the coordinates are inset by half a texel, so the padding of a pooled texture
+		*    does not bleed into the edges.
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*  @param[in] const int & nWidth
+		*    used width
+		*  @param[in] const int & nHeight
+		*    used height
+		*  @param[out] PLMath::Vector2 & vScale
+		*    receives the texture coordinate scale
+		*  @param[out] PLMath::Vector2 & vOffset
+		*    receives the texture coordinate offset
+		*/
+		void GetTextureCoordinates(PLRenderer::TextureBuffer *pTextureBuffer, const int &nWidth, const int &nHeight, PLMath::Vector2 &vScale, PLMath::Vector2 &vOffset) const;
+
+		/**
+		*  @brief
+		*    Returns the size a widget is drawn at, its rendered size upscaled by the render scale
+		*
+		*  @param[in] const sWidget * psWidget
+		*
+		*  @return
+		*    size in screen pixels
+		*/
+		PLMath::Vector2 GetWidgetQuadSize(const sWidget *psWidget) const;
+		
+		/**
+		*  @brief
+		*    Applies the translation and scale of the window to a quad
+		*
+		*  @remarks
+		*    The quad is scaled around the center of the window quad and then moved by the translation, so the
+		*    widgets stay in place on the window.
+		*
+		*  @param[in] const PLMath::Vector2 & vPosition
+		*  @param[in] const PLMath::Vector2 & vSize
+		*  @param[out] PLMath::Vector2 & vDrawPosition
+		*  @param[out] PLMath::Vector2 & vDrawSize
+		*/
+		void TransformQuad(const PLMath::Vector2 &vPosition, const PLMath::Vector2 &vSize, PLMath::Vector2 &vDrawPosition, PLMath::Vector2 &vDrawSize) const;
+		
+		/**
+		*  @brief
+		*    Takes over the size berkelium was asked for, called with the first paint at that size
+		*
+		*  @remarks
+		*    The image and, unless the size stays within its bucket, the texture are recreated. The paint that
+		*    brought the size fills them and is uploaded before the next draw.
+		*/
+		void ApplyResize();
+		
+		/**
+		*  @brief
+		*    Uploads the dirty rectangles of the image buffer data to the GPU
+		*
+		*  @remarks
+		*    Falls back to a full upload when the dirty area passes the full upload threshold of the window.
+		*
+		*  @param[in] size_t numCopyRects
+		*  @param[in] const Berkelium::Rect * copyRects
+		*/
+		void BufferUploadToGPU(size_t numCopyRects, const Berkelium::Rect *copyRects);
+		
+		/**
+		*  @brief
+		*    Uploads the image buffer data of a widget to the GPU
+		*
+		*  @param[in] sWidget * psWidget
+		*/
+		void WidgetUploadToGPU(sWidget *psWidget);
+		
+		/**
+		*  @brief
+		*    Uploads the dirty rectangles of the image buffer data of a widget to the GPU
+		*
+		*  @remarks
+		*    The dirty rectangles are coalesced with the upload call cost of the window first.
+		*    Falls back to a full upload when the dirty area passes the full upload threshold of the window.
+		*
+		*  @param[in] sWidget * psWidget
+		*  @param[in] size_t numCopyRects
+		*  @param[in] const Berkelium::Rect * copyRects
+		*  @param[in] const Berkelium::Rect * pScrollRect
+		*/
+		void WidgetUploadToGPU(sWidget *psWidget, size_t numCopyRects, const Berkelium::Rect *copyRects, const Berkelium::Rect *pScrollRect = nullptr);
+		
 		/**
 		*  @brief
 		*    Destroys this berkelium window and recreates it
@@ -838,8 +1461,7 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 		PLRenderer::FragmentShader *m_pFragmentShader;
 		PLRenderer::ProgramWrapper *m_pProgramWrapper;
 		PLRenderer::TextureBuffer *m_pTextureBuffer;
-		PLRenderer::TextureBuffer *m_pTextureBufferNew;
-		PLGraphics::Image m_cImage;
+		mutable PLGraphics::Image m_cImage;
 		sWindowsData *m_psWindowsData;
 		bool m_bInitialized;
 		bool m_bReadyToDraw;
@@ -849,8 +1471,30 @@ class SRPWindow : public PLScene::SceneRendererPass, public Berkelium::WindowDel
 		bool m_bToolTipEnabled;
 		PLCore::HashMap<PLCore::String, sCallBack*> *m_pmapDefaultCallBacks;
 		PLCore::HashMap<PLCore::String, PLCore::DynFuncPtr> *m_pmapCallBackFunctions;
-		bool m_bIgnoreBufferUpdate;
 		PLCore::HashMap<Berkelium::Widget*, sWidget*> *m_pmapWidgets;
+		TextureUploader *m_pTextureUploader;
+		PLRenderer::SurfaceTextureBuffer *m_pScrollSurface;
+		bool m_bScrollOnGPUChecked;					/**< Whether or not the scroll on the GPU was compared with the CPU scroll */
+		bool m_bScrollOnGPUWorks;					/**< Whether or not the scroll on the GPU gave the same image as the CPU scroll */
+		mutable bool m_bImageOutdated;
+		bool m_bSuspended;
+		bool m_bPaintsDropped;
+		DamageRegion m_cPendingDamage;
+		sWindowStats m_sStats;
+		CopyWorkerPool *m_pCopyWorkerPool;
+		SurfacePool *m_pSurfacePool;
+		PLMath::Vector2i m_vPreviewSize;
+		PLCore::uint64 m_nPreviewTime;
+		PLMath::Vector2i m_vResizeSize;
+		SRPCompositor *m_pCompositor;
+		ProgramCache *m_pProgramCache;
+		PLMath::Vector2 m_vQuadSize;
+		PLMath::Vector2 m_vQuadTextureCoordinateScale;
+		PLMath::Vector2 m_vQuadTextureCoordinateOffset;
+		WindowAnimator *m_pWindowAnimator;
+		PLMath::Vector2i m_vRenderSize;		/**< Size berkelium renders at, the frame size scaled by the render scale */
+		HitTestIndex *m_pHitTestIndex;
+		AlphaMask m_cAlphaMask;
 
 
 };
@@ -0,0 +1,208 @@
+#ifndef __PLBERKELIUM_SURFACEPOOL_H__
+#define __PLBERKELIUM_SURFACEPOOL_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+#include <PLMath/Vector2.h>
+#include <PLMath/Vector2i.h>
+#include <PLRenderer/Renderer/Renderer.h>
+#include <PLRenderer/Renderer/TextureBuffer.h>
+
+#include "PLBerkelium.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Defines                                               ]
+//[-------------------------------------------------------]
+#define SURFACEBUCKETSIZE 64		/**< Width and height of pooled textures are rounded up to a multiple of this */
+#define MAXPOOLEDSURFACES 32		/**< Free textures a surface pool keeps at most */
+
+
+//[-------------------------------------------------------]
+//[ Structures                                            ]
+//[-------------------------------------------------------]
+struct sPooledSurface
+{
+	PLRenderer::TextureBuffer *pTextureBuffer;	/**< Free texture, owned by the pool */
+	PLMath::Vector2i vSize;						/**< Bucket size of the texture */
+	PLCore::uint64 nReleaseTime;				/**< Millisecond the texture was given back to the pool */
+};
+
+
+struct sSurfacePoolStats
+{
+	PLCore::uint32 nCreated;		/**< Textures created because no free texture of the bucket size was in the pool */
+	PLCore::uint32 nReused;			/**< Textures handed out again from the pool */
+	PLCore::uint32 nDestroyed;		/**< Free textures destroyed when the pool was trimmed */
+};
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Pool of window and widget textures, shared by all windows of a Gui
+*
+*  @remarks
+*    Textures are created at a bucket size, so a window resized within one bucket keeps its texture and a window
+*    resized back and forth reuses the textures it gave back. The content sits in the top left corner of the
+*    texture, the texture coordinates of the quad are scaled to the used part (see GetTextureCoordinateScale()).
+*    Free textures are kept up to a memory budget, the oldest ones are destroyed first.
+*/
+class SurfacePool {
+
+
+	public:
+		PLBERKELIUM_API SurfacePool();
+		PLBERKELIUM_API ~SurfacePool();
+
+		/**
+		*  @brief
+		*    Returns a texture that holds at least the given size
+		*
+		*  @param[in] PLRenderer::Renderer & cRenderer
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*
+		*  @return
+		*    texture at bucket size, a null pointer on error, give it back with Release()
+		*/
+		PLBERKELIUM_API PLRenderer::TextureBuffer *Acquire(PLRenderer::Renderer &cRenderer, const int &nWidth, const int &nHeight);
+
+		/**
+		*  @brief
+		*    Gives a texture back to the pool
+		*
+		*  @remarks
+		*    Textures of other sizes than the bucket sizes are destroyed right away.
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*/
+		PLBERKELIUM_API void Release(PLRenderer::TextureBuffer *pTextureBuffer);
+
+		/**
+		*  @brief
+		*    Destroys free textures, oldest first, until they take no more than the given memory
+		*
+		*  @remarks
+		*    Call this with 0 under memory pressure to drop all free textures.
+		*
+		*  @param[in] PLCore::uint64 nMaxFreeBytes
+		*/
+		PLBERKELIUM_API void Trim(PLCore::uint64 nMaxFreeBytes = 0);
+
+		/**
+		*  @brief
+		*    Sets the memory free textures may take before the pool trims itself
+		*
+		*  @param[in] PLCore::uint64 nMaxFreeBytes
+		*/
+		PLBERKELIUM_API void SetMaxFreeBytes(PLCore::uint64 nMaxFreeBytes);
+
+		/**
+		*  @brief
+		*    Returns the memory free textures may take before the pool trims itself
+		*
+		*  @return
+		*    memory budget in bytes
+		*/
+		PLBERKELIUM_API PLCore::uint64 GetMaxFreeBytes() const;
+
+		/**
+		*  @brief
+		*    Returns the memory the free textures take
+		*
+		*  @return
+		*    memory in bytes
+		*/
+		PLBERKELIUM_API PLCore::uint64 GetFreeBytes() const;
+
+		/**
+		*  @brief
+		*    Returns the number of free textures
+		*
+		*  @return
+		*    number of free textures
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfFreeTextures() const;
+
+		/**
+		*  @brief
+		*    Returns the pool statistics
+		*
+		*  @return
+		*    statistics since creation
+		*/
+		PLBERKELIUM_API const sSurfacePoolStats &GetStats() const;
+
+		/**
+		*  @brief
+		*    Returns the bucket size for a surface size
+		*
+		*  @param[in] const PLMath::Vector2i & vSize
+		*
+		*  @return
+		*    size rounded up to the next multiple of SURFACEBUCKETSIZE
+		*/
+		PLBERKELIUM_API static PLMath::Vector2i GetBucketSize(const PLMath::Vector2i &vSize);
+
+		/**
+		*  @brief
+		*    Returns the size of a 2D texture
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*
+		*  @return
+		*    size of the texture, zero if there is no 2D texture
+		*/
+		PLBERKELIUM_API static PLMath::Vector2i GetTextureSize(PLRenderer::TextureBuffer *pTextureBuffer);
+
+		/**
+		*  @brief
+		*    Returns the texture coordinate scale that maps a quad to the used part of a texture
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*
+		*  @return
+		*    used size divided by the texture size, one if there is no texture
+		*/
+		PLBERKELIUM_API static PLMath::Vector2 GetTextureCoordinateScale(PLRenderer::TextureBuffer *pTextureBuffer, const int &nWidth, const int &nHeight);
+
+	protected:
+
+	private:
+		/**
+		*  @brief
+		*    Destroys the free texture at the given index
+		*
+		*  @param[in] PLCore::uint32 nIndex
+		*/
+		void DestroyFree(PLCore::uint32 nIndex);
+
+		sPooledSurface m_sFree[MAXPOOLEDSURFACES];
+		PLCore::uint32 m_nNumOfFree;
+		PLCore::uint64 m_nFreeBytes;
+		PLCore::uint64 m_nMaxFreeBytes;
+		sSurfacePoolStats m_sStats;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_SURFACEPOOL_H__
@@ -0,0 +1,312 @@
+#ifndef __PLBERKELIUM_TEXTUREUPLOADER_H__
+#define __PLBERKELIUM_TEXTUREUPLOADER_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+#include <PLRenderer/Renderer/Renderer.h>
+#include <PLRenderer/Renderer/TextureBuffer.h>
+
+#include "berkelium/Rect.hpp"
+
+#include "PLBerkelium.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Structures                                            ]
+//[-------------------------------------------------------]
+struct sUploadStats
+{
+	PLCore::uint32 nUploads;				/**< Uploads written straight to the texture */
+	PLCore::uint64 nUploadedBytes;			/**< Bytes uploaded straight to the texture */
+	PLCore::uint64 nUploadTime;				/**< Microseconds the render thread spent in uploads straight to the texture */
+	PLCore::uint32 nPixelBufferUploads;		/**< Uploads streamed through the pixel buffer ring */
+	PLCore::uint64 nPixelBufferBytes;		/**< Bytes streamed through the pixel buffer ring */
+	PLCore::uint64 nPixelBufferTime;		/**< Microseconds the render thread spent in uploads through the pixel buffer ring */
+};
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Uploads (parts of) an RGBA image buffer into a texture buffer
+*
+*  @remarks
+*    PLRenderer only offers a full texture upload, the partial upload is done with
+*    glTexSubImage2D on the texture buffer that was bound through the renderer.
+*    Optionally the data is streamed through a ring of pixel unpack buffers, the texture update is then
+*    queued on the GPU and the render thread does not wait for the driver to release the texture.
+*/
+class TextureUploader {
+
+
+	public:
+		PLBERKELIUM_API TextureUploader(PLRenderer::Renderer *pRenderer);
+		PLBERKELIUM_API ~TextureUploader();
+
+		/**
+		*  @brief
+		*    Sets the number of pixel unpack buffers in the upload ring
+		*
+		*  @remarks
+		*    0 uploads straight to the texture, 2 or 3 are sensible ring sizes.
+		*    Without pixel buffer object support (e.g. OpenGL ES 2.0) the uploader stays with the straight upload.
+		*
+		*  @param[in] PLCore::uint32 nNumOfBuffers
+		*
+		*  @return
+		*    'true' if the pixel buffer ring is in use, else 'false'
+		*/
+		PLBERKELIUM_API bool SetNumOfPixelBuffers(PLCore::uint32 nNumOfBuffers);
+
+		/**
+		*  @brief
+		*    Returns the number of pixel unpack buffers in the upload ring
+		*
+		*  @return
+		*    number of buffers, 0 if uploads go straight to the texture
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfPixelBuffers() const;
+
+		/**
+		*  @brief
+		*    Maps a staging buffer the size of the image, paint data can be written straight into it
+		*
+		*  @remarks
+		*    Staging buffers are pixel unpack buffers laid out like the image (4 bytes per pixel, rows tightly packed).
+		*    The buffer stays mapped until UploadStaging(), calling this again in between returns the same memory.
+		*    Two staging buffers are used in turns and the storage is respecified on every map, so only the
+		*    rectangles written since the map hold valid data and the map never waits for the GPU.
+		*
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*
+		*  @return
+		*    pointer to the mapped memory, a null pointer if there is no pixel buffer object support
+		*/
+		PLBERKELIUM_API PLCore::uint8 *MapStaging(const int &nWidth, const int &nHeight);
+
+		/**
+		*  @brief
+		*    Unmaps the staging buffer and uploads the given rectangles of it to the texture buffer
+		*
+		*  @remarks
+		*    Only rectangles written since MapStaging() are valid. Can be called several times after one
+		*    map, as long as MapStaging() is not called in between.
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*  @param[in] size_t nNumOfRects
+		*  @param[in] const Berkelium::Rect * pRects
+		*
+		*  @return
+		*    'true' if the upload was successful, else 'false'
+		*/
+		PLBERKELIUM_API bool UploadStaging(PLRenderer::TextureBuffer *pTextureBuffer, const int &nWidth, const int &nHeight, size_t nNumOfRects, const Berkelium::Rect *pRects);
+
+		/**
+		*  @brief
+		*    Returns whether or not the staging buffers are available
+		*
+		*  @return
+		*    'true' if pixel buffer objects are supported, else 'false'
+		*/
+		PLBERKELIUM_API bool IsStagingSupported() const;
+
+		/**
+		*  @brief
+		*    Returns the upload statistics
+		*
+		*  @return
+		*    statistics since creation or the last ResetStats()
+		*/
+		PLBERKELIUM_API const sUploadStats &GetStats() const;
+
+		/**
+		*  @brief
+		*    Resets the upload statistics
+		*/
+		PLBERKELIUM_API void ResetStats();
+
+		/**
+		*  @brief
+		*    Uploads the complete image buffer to the texture buffer
+		*
+		*  @remarks
+		*    The texture buffer may be larger than the image (pooled textures), the image then goes into its top left corner.
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*  @param[in] const PLCore::uint8 * pImageBuffer
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*
+		*  @return
+		*    'true' if the upload was successful, else 'false'
+		*/
+		PLBERKELIUM_API bool UploadFull(PLRenderer::TextureBuffer *pTextureBuffer, const PLCore::uint8 *pImageBuffer, const int &nWidth, const int &nHeight);
+
+		/**
+		*  @brief
+		*    Reads the texture buffer back into an image buffer
+		*
+		*  @remarks
+		*    The texture buffer may be larger than the image (pooled textures), only its top left corner is read then.
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*  @param[out] PLCore::uint8 * pImageBuffer
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*
+		*  @return
+		*    'true' if the read back was successful, else 'false'
+		*/
+		PLBERKELIUM_API bool DownloadFull(PLRenderer::TextureBuffer *pTextureBuffer, PLCore::uint8 *pImageBuffer, const int &nWidth, const int &nHeight);
+
+		/**
+		*  @brief
+		*    Uploads the given rectangles of the image buffer to the texture buffer
+		*
+		*  @remarks
+		*    Rectangles are clipped against the image size, rectangles outside the image are ignored.
+		*    On OpenGL ES 2.0 there is no unpack row length, so each rectangle is widened to full rows.
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*  @param[in] const PLCore::uint8 * pImageBuffer
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*  @param[in] size_t nNumOfRects
+		*  @param[in] const Berkelium::Rect * pRects
+		*
+		*  @return
+		*    'true' if the upload was successful, else 'false'
+		*/
+		PLBERKELIUM_API bool UploadRects(PLRenderer::TextureBuffer *pTextureBuffer, const PLCore::uint8 *pImageBuffer, const int &nWidth, const int &nHeight, size_t nNumOfRects, const Berkelium::Rect *pRects);
+
+		/**
+		*  @brief
+		*    Copies a rectangle of the current render target into the texture buffer
+		*
+		*  @remarks
+		*    This is a GPU only copy, the pixels never pass the bus. The render target must not be the texture buffer itself.
+		*
+		*  @param[in] PLRenderer::TextureBuffer * pTextureBuffer
+		*  @param[in] const int & nX
+		*  @param[in] const int & nY
+		*  @param[in] const int & nSourceX
+		*  @param[in] const int & nSourceY
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*
+		*  @return
+		*    'true' if the copy was successful, else 'false'
+		*/
+		PLBERKELIUM_API bool CopyFromRenderTarget(PLRenderer::TextureBuffer *pTextureBuffer, const int &nX, const int &nY, const int &nSourceX, const int &nSourceY, const int &nWidth, const int &nHeight);
+
+		/**
+		*  @brief
+		*    Returns the fraction of the surface covered by the given rectangles
+		*
+		*  @note
+		*    Overlapping rectangles are counted twice, so the result can be larger than 1.
+		*
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*  @param[in] size_t nNumOfRects
+		*  @param[in] const Berkelium::Rect * pRects
+		*
+		*  @return
+		*    covered fraction of the surface
+		*/
+		PLBERKELIUM_API static float GetCoveredFraction(const int &nWidth, const int &nHeight, size_t nNumOfRects, const Berkelium::Rect *pRects);
+
+		/**
+		*  @brief
+		*    Clips a rectangle against a surface
+		*
+		*  @param[in] const Berkelium::Rect & cRect
+		*  @param[in] const int & nWidth
+		*  @param[in] const int & nHeight
+		*
+		*  @return
+		*    clipped rectangle (width and height are 0 if the rectangle is outside the surface)
+		*/
+		PLBERKELIUM_API static Berkelium::Rect ClipRect(const Berkelium::Rect &cRect, const int &nWidth, const int &nHeight);
+
+	protected:
+
+	private:
+		/**
+		*  @brief
+		*    Loads the pixel buffer object entry points
+		*
+		*  @note
+		*    The entry points are shared by all uploaders, they are only looked up once. Pixel buffer objects are only
+		*    used when the context is OpenGL 2.1 or has GL_ARB_pixel_buffer_object, not as soon as the entry points exist.
+		*
+		*  @return
+		*    'true' if pixel buffer objects are supported, else 'false'
+		*/
+		static bool LoadPixelBufferFunctions();
+
+		/**
+		*  @brief
+		*    Destroys the pixel buffer ring
+		*/
+		void DestroyPixelBuffers();
+
+		/**
+		*  @brief
+		*    Destroys the staging buffers
+		*/
+		void DestroyStagingBuffers();
+
+		/**
+		*  @brief
+		*    Streams the given rectangles through the next buffer of the pixel buffer ring
+		*
+		*  @remarks
+		*    The texture buffer has to be bound, rectangles have to be clipped already.
+		*    Every rectangle is packed tightly into the buffer, so no unpack row length is needed.
+		*
+		*  @param[in] const PLCore::uint8 * pImageBuffer
+		*  @param[in] const int & nWidth
+		*  @param[in] size_t nNumOfRects
+		*  @param[in] const Berkelium::Rect * pRects
+		*
+		*  @return
+		*    number of bytes streamed, 0 if the pixel buffer could not be used
+		*/
+		PLCore::uint64 UploadThroughPixelBuffer(const PLCore::uint8 *pImageBuffer, const int &nWidth, size_t nNumOfRects, const Berkelium::Rect *pRects);
+
+		PLRenderer::Renderer *m_pCurrentRenderer;
+		bool m_bIsOpenGLES;
+		PLCore::uint32 m_nNumOfPixelBuffers;
+		PLCore::uint32 m_nPixelBuffers[4];
+		PLCore::uint64 m_nPixelBufferSize[4];
+		PLCore::uint32 m_nCurrentPixelBuffer;
+		PLCore::uint32 m_nStagingBuffers[2];
+		PLCore::uint32 m_nCurrentStagingBuffer;
+		PLCore::uint8 *m_pStagingData;
+		PLCore::uint64 m_nStagingBytes;
+		sUploadStats m_sStats;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_TEXTUREUPLOADER_H__
@@ -0,0 +1,234 @@
+#ifndef __PLBERKELIUM_WINDOWANIMATOR_H__
+#define __PLBERKELIUM_WINDOWANIMATOR_H__
+#pragma once
+
+
+//[-------------------------------------------------------]
+//[ Includes                                              ]
+//[-------------------------------------------------------]
+#include <PLCore/PLCore.h>
+#include <PLMath/Vector2.h>
+
+#include "PLBerkelium.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Forward declarations                                  ]
+//[-------------------------------------------------------]
+class SRPWindow;
+
+
+//[-------------------------------------------------------]
+//[ Defines                                               ]
+//[-------------------------------------------------------]
+#define MAXWINDOWTWEENS 64		/**< Tweens a window animator runs at the same time */
+
+
+//[-------------------------------------------------------]
+//[ Definitions                                           ]
+//[-------------------------------------------------------]
+enum EWindowTweenProperty
+{
+	TweenOpacity = 0,		/**< sWindowsData::fOpacity, the value is in x */
+	TweenTranslation,		/**< sWindowsData::vTranslation */
+	TweenScale,				/**< sWindowsData::fScale, the value is in x */
+	NumOfTweenProperties
+};
+
+
+enum EWindowTweenEasing
+{
+	EasingLinear = 0,		/**< Constant speed */
+	EasingSmooth,			/**< Slow start and end */
+	EasingOut				/**< Fast start, slow end */
+};
+
+
+//[-------------------------------------------------------]
+//[ Structures                                            ]
+//[-------------------------------------------------------]
+struct sWindowTween
+{
+	SRPWindow *pSRPWindow;			/**< Animated window, not owned */
+	EWindowTweenProperty nProperty;	/**< Animated property */
+	EWindowTweenEasing nEasing;		/**< Easing of the progress */
+	PLMath::Vector2 vFrom;			/**< Value at the start */
+	PLMath::Vector2 vTo;			/**< Value at the end */
+	PLCore::uint64 nStartTime;		/**< Millisecond the tween started */
+	PLCore::uint32 nDuration;		/**< Milliseconds the tween runs */
+	bool bHideOnEnd;				/**< Hide the window when the tween ends */
+};
+
+
+struct sWindowAnimatorStats
+{
+	PLCore::uint32 nStarted;		/**< Tweens started */
+	PLCore::uint32 nFinished;		/**< Tweens that ran to their end */
+	PLCore::uint32 nInterrupted;	/**< Tweens replaced by a new tween of the same property or stopped */
+	PLCore::uint32 nSkipped;		/**< Tweens set to their end right away because all slots were taken */
+};
+
+
+//[-------------------------------------------------------]
+//[ Classes                                               ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Small tween scheduler for the opacity, translation and scale of the windows of a Gui
+*
+*  @remarks
+*    The animated values are draw parameters of the window (see sWindowsData::fOpacity, sWindowsData::vTranslation
+*    and sWindowsData::fScale), the program applies them when the quad is drawn, so fades, slides and zooms never
+*    repaint the page. The Gui advances the tweens once per update (see Update()), a window runs at most one tween
+*    per property, a new one starts at the current value and replaces the running one.
+*/
+class WindowAnimator {
+
+
+	public:
+		PLBERKELIUM_API WindowAnimator();
+		PLBERKELIUM_API ~WindowAnimator();
+
+		/**
+		*  @brief
+		*    Animates a property of a window from its current value to the given value
+		*
+		*  @remarks
+		*    With a duration of 0 the value is set right away. A running tween of the same property is replaced,
+		*    so a window that was about to be hidden on end stays visible. Showing a hidden window is up to the caller.
+		*
+		*  @param[in] SRPWindow * pSRPWindow
+		*  @param[in] const EWindowTweenProperty & nProperty
+		*  @param[in] const PLMath::Vector2 & vTo
+		*    value at the end, opacity and scale take x
+		*  @param[in] const PLCore::uint32 & nDuration
+		*    milliseconds
+		*  @param[in] const EWindowTweenEasing & nEasing
+		*  @param[in] const bool & bHideOnEnd
+		*
+		*  @return
+		*    'true' if the tween is running, 'false' if the value was set right away
+		*/
+		PLBERKELIUM_API bool Animate(SRPWindow *pSRPWindow, const EWindowTweenProperty &nProperty, const PLMath::Vector2 &vTo, const PLCore::uint32 &nDuration, const EWindowTweenEasing &nEasing = EasingSmooth, const bool &bHideOnEnd = false);
+
+		/**
+		*  @brief
+		*    Stops all tweens of a window
+		*
+		*  @param[in] SRPWindow * pSRPWindow
+		*  @param[in] const bool & bFinish
+		*    'true' to set the values at the end (and hide the window if a tween would), 'false' to keep the current values
+		*/
+		PLBERKELIUM_API void Stop(SRPWindow *pSRPWindow, const bool &bFinish = false);
+
+		/**
+		*  @brief
+		*    Returns whether or not a window is animated
+		*
+		*  @param[in] const SRPWindow * pSRPWindow
+		*
+		*  @return
+		*    'true' if a tween of the window is running, else 'false'
+		*/
+		PLBERKELIUM_API bool IsAnimating(const SRPWindow *pSRPWindow) const;
+
+		/**
+		*  @brief
+		*    Advances all tweens to the current time, ended tweens are removed
+		*
+		*  @return
+		*    number of tweens still running
+		*/
+		PLBERKELIUM_API PLCore::uint32 Update();
+
+		/**
+		*  @brief
+		*    Returns the number of running tweens
+		*
+		*  @return
+		*    number of tweens
+		*/
+		PLBERKELIUM_API PLCore::uint32 GetNumOfTweens() const;
+
+		/**
+		*  @brief
+		*    Returns the animator statistics
+		*
+		*  @return
+		*    statistics since creation
+		*/
+		PLBERKELIUM_API const sWindowAnimatorStats &GetStats() const;
+
+		/**
+		*  @brief
+		*    Returns the eased progress
+		*
+		*  @param[in] const EWindowTweenEasing & nEasing
+		*  @param[in] const float & fProgress
+		*    linear progress from 0 to 1
+		*
+		*  @return
+		*    eased progress from 0 to 1
+		*/
+		PLBERKELIUM_API static float Ease(const EWindowTweenEasing &nEasing, const float &fProgress);
+
+		/**
+		*  @brief
+		*    Returns the current value of a property of a window
+		*
+		*  @param[in] const SRPWindow * pSRPWindow
+		*  @param[in] const EWindowTweenProperty & nProperty
+		*
+		*  @return
+		*    value, opacity and scale are in x
+		*/
+		PLBERKELIUM_API static PLMath::Vector2 GetValue(const SRPWindow *pSRPWindow, const EWindowTweenProperty &nProperty);
+
+		/**
+		*  @brief
+		*    Sets a property of a window
+		*
+		*  @param[in] SRPWindow * pSRPWindow
+		*  @param[in] const EWindowTweenProperty & nProperty
+		*  @param[in] const PLMath::Vector2 & vValue
+		*    value, opacity and scale take x
+		*/
+		PLBERKELIUM_API static void SetValue(SRPWindow *pSRPWindow, const EWindowTweenProperty &nProperty, const PLMath::Vector2 &vValue);
+
+	protected:
+
+	private:
+		/**
+		*  @brief
+		*    Ends a tween, sets its end value and hides the window if asked for
+		*
+		*  @param[in] const sWindowTween & sTween
+		*/
+		void Finish(const sWindowTween &sTween);
+
+		/**
+		*  @brief
+		*    Removes the tween at the given index, the last tween takes its slot
+		*
+		*  @param[in] PLCore::uint32 nIndex
+		*/
+		void RemoveTween(PLCore::uint32 nIndex);
+
+		sWindowTween m_sTweens[MAXWINDOWTWEENS];
+		PLCore::uint32 m_nNumOfTweens;
+		sWindowAnimatorStats m_sStats;
+
+
+};
+
+
+};
+
+
+#endif // __PLBERKELIUM_WINDOWANIMATOR_H__
@@ -11,23 +11,28 @@
 static const PLCore::String sBerkeliumVertexShaderSourceCodeGLSL = STRINGIFY(
 // Attributes
 attribute highp vec2 VertexPosition;	// Object space vertex position input
-attribute lowp  vec2 VertexTexCoord;	// Vertex texture coordinate input
-varying   lowp  vec2 VertexTexCoordVS;	// Vertex texture coordinate output
+attribute highp vec2 VertexTexCoord;	// Vertex texture coordinate input
+varying   highp vec2 VertexTexCoordVS;	// Vertex texture coordinate output, the offset and scale of a large pooled texture need the precision
 
 // Uniforms
 uniform highp mat4 ObjectSpaceToClipSpaceMatrix;	// Object space to clip space matrix
+uniform highp vec4 QuadRect;						// Position (xy) and size (zw) of the quad in object space
+uniform highp vec4 TextureRect;						// Texture coordinate offset (xy) and size (zw) the quad samples
+uniform highp float QuadDepth;						// Clip space depth of the quad, only the depth ordered compositor sets it
 
 // Programs
 void main()
 {
-	// Calculate the clip space vertex position, lower/left is (-1,-1) and upper/right is (1,1)
-	gl_Position = ObjectSpaceToClipSpaceMatrix*vec4(VertexPosition, 0.0, 1.0);
+	// The vertices are the corners of the unit quad, place it in object space and calculate the clip space vertex position,
+	// lower/left is (-1,-1) and upper/right is (1,1)
+	gl_Position = ObjectSpaceToClipSpaceMatrix*vec4(QuadRect.xy + VertexPosition*QuadRect.zw, 0.0, 1.0);
+	gl_Position.z = QuadDepth*gl_Position.w;
 
 	// In case you want to have a fullscreen quad in here, replace the line above by
 //	gl_Position = vec4(VertexPosition, 1);
 
-	// Pass through the vertex texture coordinate
-	VertexTexCoordVS = VertexTexCoord;
+	// Map the unit texture coordinate to the sampled part of the texture
+	VertexTexCoordVS = TextureRect.xy + VertexTexCoord*TextureRect.zw;
 }
 );	// STRINGIFY
 
@@ -36,19 +41,45 @@ void main()
 //[ Fragment shader source code                           ]
 //[-------------------------------------------------------]
 // GLSL (OpenGL 2.0 ("#version 110") and OpenGL ES 2.0 ("#version 100")) fragment shader source code, "#version" is added by hand
+// The texture holds canonical RGBA, the copy kernel swizzled the berkelium BGRA data already
 static const PLCore::String sBerkeliumFragmentShaderSourceCodeGLSL = STRINGIFY(
 // Attributes
-varying lowp vec2 VertexTexCoordVS;	// Interpolated vertex texture coordinate input from vertex shader
+varying mediump vec2 VertexTexCoordVS;	// Interpolated vertex texture coordinate input from vertex shader, highp is optional in fragment shaders
 
 // Uniforms
 uniform lowp sampler2D TextureMap;	// Texture map
+uniform lowp float     Opacity;		// Factor the texel alpha is multiplied with
+uniform lowp float     Premultiply;	// 1 to multiply the color with the alpha, the composite cache holds premultiplied colors
 
 // Programs
 void main()
 {
-	// Fragment color = fetched interpolated texel color
-	gl_FragColor = texture2D(TextureMap, VertexTexCoordVS).bgra; // thanks to Phosfor
+	// Fragment color = fetched interpolated texel color, faded by the opacity and premultiplied if asked for
+	lowp vec4 vColor = texture2D(TextureMap, VertexTexCoordVS);
+	lowp float fAlpha = vColor.a*Opacity;
+	gl_FragColor = vec4(vColor.rgb*mix(1.0, fAlpha, Premultiply), fAlpha);
+}
+);	// STRINGIFY
+
+// GLSL (OpenGL 2.0 ("#version 110") and OpenGL ES 2.0 ("#version 100")) fragment shader source code, "#version" is added by hand
+// The texture holds the berkelium BGRA data as is, so the channels are swizzled per fragment
+static const PLCore::String sBerkeliumFragmentShaderSwizzleSourceCodeGLSL = STRINGIFY(
+// Attributes
+varying mediump vec2 VertexTexCoordVS;	// Interpolated vertex texture coordinate input from vertex shader, highp is optional in fragment shaders
+
+// Uniforms
+uniform lowp sampler2D TextureMap;	// Texture map
+uniform lowp float     Opacity;		// Factor the texel alpha is multiplied with
+uniform lowp float     Premultiply;	// 1 to multiply the color with the alpha, the composite cache holds premultiplied colors
+
+// Programs
+void main()
+{
+	// Fragment color = fetched interpolated texel color, faded by the opacity and premultiplied if asked for
+	lowp vec4 vColor = texture2D(TextureMap, VertexTexCoordVS).bgra; // thanks to Phosfor
 	// i know it says BGRA it seems to be working only this way
+	lowp float fAlpha = vColor.a*Opacity;
+	gl_FragColor = vec4(vColor.rgb*mix(1.0, fAlpha, Premultiply), fAlpha);
 }
 );	// STRINGIFY
 
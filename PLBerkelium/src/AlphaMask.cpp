@@ -0,0 +1,264 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/AlphaMask.h"
+
+#include <PLCore/Core/MemoryManager.h>
+
+#include "PLBerkelium/TextureUploader.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+AlphaMask::AlphaMask() :
+	m_pnBits(nullptr),
+	m_pnScrollBits(nullptr),
+	m_nWidth(0),
+	m_nHeight(0),
+	m_nWordsPerRow(0),
+	m_nNumOfWords(0),
+	m_bValid(false)
+{
+}
+
+
+AlphaMask::~AlphaMask()
+{
+	if (nullptr != m_pnBits)
+	{
+		delete [] m_pnBits;
+	}
+	if (nullptr != m_pnScrollBits)
+	{
+		delete [] m_pnScrollBits;
+	}
+}
+
+
+void AlphaMask::SetSize(const int &nWidth, const int &nHeight)
+{
+	if (nWidth == m_nWidth && nHeight == m_nHeight)
+	{
+		return;
+	}
+
+	if (nullptr != m_pnBits)
+	{
+		delete [] m_pnBits;
+		m_pnBits = nullptr;
+	}
+	if (nullptr != m_pnScrollBits)
+	{
+		delete [] m_pnScrollBits;
+		m_pnScrollBits = nullptr;
+	}
+
+	m_nWidth = (nWidth > 0 && nHeight > 0) ? nWidth : 0;
+	m_nHeight = (nWidth > 0 && nHeight > 0) ? nHeight : 0;
+	const uint32 nBlocksX = uint32(m_nWidth + (1 << ALPHAMASKSHIFT) - 1) >> ALPHAMASKSHIFT;
+	const uint32 nBlocksY = uint32(m_nHeight + (1 << ALPHAMASKSHIFT) - 1) >> ALPHAMASKSHIFT;
+	m_nWordsPerRow = (nBlocksX + 31) >> 5;
+	m_nNumOfWords = m_nWordsPerRow*nBlocksY;
+	if (m_nNumOfWords)
+	{
+		m_pnBits = new uint32[m_nNumOfWords];
+		m_pnScrollBits = new uint32[m_nNumOfWords];
+	}
+	Clear();
+}
+
+
+void AlphaMask::Clear()
+{
+	if (nullptr != m_pnBits)
+	{
+		MemoryManager::Set(m_pnBits, 0, sizeof(uint32)*m_nNumOfWords);
+	}
+	m_bValid = false;
+}
+
+
+bool AlphaMask::IsValid() const
+{
+	return m_bValid;
+}
+
+
+void AlphaMask::Update(const uint8 *pBuffer, const Berkelium::Rect &cBufferRect, size_t nNumOfRects, const Berkelium::Rect *pRects)
+{
+	if (nullptr == m_pnBits || nullptr == pBuffer)
+	{
+		return;
+	}
+
+	const size_t nPitch = size_t(cBufferRect.width()) * 4;
+	for (size_t i = 0; i < nNumOfRects; i++)
+	{
+		// only the part the buffer holds, clipped against the surface
+		const Berkelium::Rect cRect = TextureUploader::ClipRect(pRects[i].intersect(cBufferRect), m_nWidth, m_nHeight);
+		if (cRect.width() <= 0 || cRect.height() <= 0)
+		{
+			continue;
+		}
+
+		const uint32 nFirstBlockX = uint32(cRect.left()) >> ALPHAMASKSHIFT;
+		const uint32 nLastBlockX  = uint32(cRect.right() - 1) >> ALPHAMASKSHIFT;
+		const uint32 nFirstBlockY = uint32(cRect.top()) >> ALPHAMASKSHIFT;
+		const uint32 nLastBlockY  = uint32(cRect.bottom() - 1) >> ALPHAMASKSHIFT;
+		for (uint32 nBlockY = nFirstBlockY; nBlockY <= nLastBlockY; nBlockY++)
+		{
+			const int nBlockTop    = int(nBlockY << ALPHAMASKSHIFT);
+			const int nBlockBottom = (nBlockTop + (1 << ALPHAMASKSHIFT) < m_nHeight) ? nBlockTop + (1 << ALPHAMASKSHIFT) : m_nHeight;
+			const int nTop    = (nBlockTop > cRect.top()) ? nBlockTop : cRect.top();
+			const int nBottom = (nBlockBottom < cRect.bottom()) ? nBlockBottom : cRect.bottom();
+			for (uint32 nBlockX = nFirstBlockX; nBlockX <= nLastBlockX; nBlockX++)
+			{
+				const int nBlockLeft  = int(nBlockX << ALPHAMASKSHIFT);
+				const int nBlockRight = (nBlockLeft + (1 << ALPHAMASKSHIFT) < m_nWidth) ? nBlockLeft + (1 << ALPHAMASKSHIFT) : m_nWidth;
+				const int nLeft  = (nBlockLeft > cRect.left()) ? nBlockLeft : cRect.left();
+				const int nRight = (nBlockRight < cRect.right()) ? nBlockRight : cRect.right();
+
+				// the alpha is the fourth byte in BGRA and RGBA
+				bool bVisible = false;
+				for (int y = nTop; y < nBottom && !bVisible; y++)
+				{
+					const uint8 *pAlpha = pBuffer + size_t(y - cBufferRect.top()) * nPitch + size_t(nLeft - cBufferRect.left()) * 4 + 3;
+					for (int x = nLeft; x < nRight; x++, pAlpha += 4)
+					{
+						if (*pAlpha > CLICKTHROUGHALPHA)
+						{
+							bVisible = true;
+							break;
+						}
+					}
+				}
+
+				if (nTop == nBlockTop && nBottom == nBlockBottom && nLeft == nBlockLeft && nRight == nBlockRight)
+				{
+					// the whole block was painted
+					SetBlock(nBlockX, nBlockY, bVisible);
+				}
+				else if (bVisible)
+				{
+					// the rest of the block is not known here, a visible block stays visible
+					SetBlock(nBlockX, nBlockY, true);
+				}
+			}
+		}
+
+		if (cRect.left() == 0 && cRect.top() == 0 && cRect.right() == m_nWidth && cRect.bottom() == m_nHeight)
+		{
+			m_bValid = true;
+		}
+	}
+}
+
+
+void AlphaMask::Scroll(int dx, int dy, const Berkelium::Rect &cScrollRect)
+{
+	if (nullptr == m_pnBits || (dx == 0 && dy == 0))
+	{
+		return;
+	}
+
+	// the same region BufferCopy::ScrollRect() moves, as destination
+	const int nLeft   = cScrollRect.left()   < 0         ? 0         : cScrollRect.left();
+	const int nTop    = cScrollRect.top()    < 0         ? 0         : cScrollRect.top();
+	const int nRight  = cScrollRect.right()  > m_nWidth  ? m_nWidth  : cScrollRect.right();
+	const int nBottom = cScrollRect.bottom() > m_nHeight ? m_nHeight : cScrollRect.bottom();
+	const int nDestinationLeft   = (dx > 0) ? nLeft + dx : nLeft;
+	const int nDestinationRight  = (dx > 0) ? nRight : nRight + dx;
+	const int nDestinationTop    = (dy > 0) ? nTop + dy : nTop;
+	const int nDestinationBottom = (dy > 0) ? nBottom : nBottom + dy;
+	if (nDestinationRight <= nDestinationLeft || nDestinationBottom <= nDestinationTop)
+	{
+		// nothing is shared, the exposed rects are painted
+		return;
+	}
+
+	MemoryManager::Copy(m_pnScrollBits, m_pnBits, sizeof(uint32)*m_nNumOfWords);
+	const uint32 nFirstBlockX = uint32(nDestinationLeft) >> ALPHAMASKSHIFT;
+	const uint32 nLastBlockX  = uint32(nDestinationRight - 1) >> ALPHAMASKSHIFT;
+	const uint32 nFirstBlockY = uint32(nDestinationTop) >> ALPHAMASKSHIFT;
+	const uint32 nLastBlockY  = uint32(nDestinationBottom - 1) >> ALPHAMASKSHIFT;
+	for (uint32 nBlockY = nFirstBlockY; nBlockY <= nLastBlockY; nBlockY++)
+	{
+		const int nBlockTop    = int(nBlockY << ALPHAMASKSHIFT);
+		const int nBlockBottom = (nBlockTop + (1 << ALPHAMASKSHIFT) < m_nHeight) ? nBlockTop + (1 << ALPHAMASKSHIFT) : m_nHeight;
+		const int nRowTop    = (nBlockTop > nDestinationTop) ? nBlockTop : nDestinationTop;
+		const int nRowBottom = (nBlockBottom < nDestinationBottom) ? nBlockBottom : nDestinationBottom;
+		const uint32 nFirstSourceY = uint32(nRowTop - dy) >> ALPHAMASKSHIFT;
+		const uint32 nLastSourceY  = uint32(nRowBottom - 1 - dy) >> ALPHAMASKSHIFT;
+		for (uint32 nBlockX = nFirstBlockX; nBlockX <= nLastBlockX; nBlockX++)
+		{
+			const int nBlockLeft  = int(nBlockX << ALPHAMASKSHIFT);
+			const int nBlockRight = (nBlockLeft + (1 << ALPHAMASKSHIFT) < m_nWidth) ? nBlockLeft + (1 << ALPHAMASKSHIFT) : m_nWidth;
+			const int nColumnLeft  = (nBlockLeft > nDestinationLeft) ? nBlockLeft : nDestinationLeft;
+			const int nColumnRight = (nBlockRight < nDestinationRight) ? nBlockRight : nDestinationRight;
+			const uint32 nFirstSourceX = uint32(nColumnLeft - dx) >> ALPHAMASKSHIFT;
+			const uint32 nLastSourceX  = uint32(nColumnRight - 1 - dx) >> ALPHAMASKSHIFT;
+
+			// the moved pixels come from up to four blocks
+			bool bVisible = false;
+			for (uint32 nSourceY = nFirstSourceY; nSourceY <= nLastSourceY && !bVisible; nSourceY++)
+			{
+				for (uint32 nSourceX = nFirstSourceX; nSourceX <= nLastSourceX; nSourceX++)
+				{
+					if (GetBlock(m_pnScrollBits, nSourceX, nSourceY))
+					{
+						bVisible = true;
+						break;
+					}
+				}
+			}
+
+			if (nRowTop == nBlockTop && nRowBottom == nBlockBottom && nColumnLeft == nBlockLeft && nColumnRight == nBlockRight)
+			{
+				SetBlock(nBlockX, nBlockY, bVisible);
+			}
+			else if (bVisible)
+			{
+				SetBlock(nBlockX, nBlockY, true);
+			}
+		}
+	}
+}
+
+
+bool AlphaMask::IsHit(const int &nX, const int &nY) const
+{
+	if (!m_bValid || nX < 0 || nY < 0 || nX >= m_nWidth || nY >= m_nHeight)
+	{
+		// nothing known, the window takes the mouse like without mask
+		return true;
+	}
+	return GetBlock(m_pnBits, uint32(nX) >> ALPHAMASKSHIFT, uint32(nY) >> ALPHAMASKSHIFT);
+}
+
+
+void AlphaMask::SetBlock(uint32 nBlockX, uint32 nBlockY, bool bVisible)
+{
+	uint32 &nWord = m_pnBits[nBlockY*m_nWordsPerRow + (nBlockX >> 5)];
+	if (bVisible)
+		nWord |= (1u << (nBlockX & 31));
+	else
+		nWord &= ~(1u << (nBlockX & 31));
+}
+
+
+bool AlphaMask::GetBlock(const uint32 *pnBits, uint32 nBlockX, uint32 nBlockY) const
+{
+	return (pnBits[nBlockY*m_nWordsPerRow + (nBlockX >> 5)] & (1u << (nBlockX & 31))) != 0;
+}
+
+
+};
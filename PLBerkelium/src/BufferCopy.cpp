@@ -0,0 +1,327 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/BufferCopy.h"
+
+#include <PLCore/Core/MemoryManager.h>
+#include <string.h>
+
+// the instruction sets available to this compiler and target
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define PLBERKELIUM_BUFFERCOPY_SSE2
+	#include <emmintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		// the AVX2 intrinsics need Visual Studio 2012 or later
+		#if _MSC_VER >= 1700
+			#define PLBERKELIUM_BUFFERCOPY_AVX2
+			#define PLBERKELIUM_TARGET_AVX2
+			#include <immintrin.h>
+		#endif
+	#elif defined(__GNUC__)
+		#define PLBERKELIUM_BUFFERCOPY_AVX2
+		#define PLBERKELIUM_TARGET_AVX2 __attribute__((target("avx2")))
+		#include <immintrin.h>
+	#endif
+#endif
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Internal helpers                                      ]
+//[-------------------------------------------------------]
+namespace {
+
+typedef void (*CopyRowFunc)(uint8 *pDestination, const uint8 *pSource, uint32 nNumOfPixels);
+
+enum EInstructionSet
+{
+	InstructionSetScalar,
+	InstructionSetSSE2,
+	InstructionSetAVX2
+};
+
+
+template <bool bSwizzle>
+void CopyRowScalar(uint8 *pDestination, const uint8 *pSource, uint32 nNumOfPixels)
+{
+	if (bSwizzle)
+	{
+		// BGRA -> RGBA, read the pixel first so that this also works in place
+		for (uint32 i = 0; i < nNumOfPixels; i++, pDestination += 4, pSource += 4)
+		{
+			const uint8 nBlue = pSource[0];
+			const uint8 nRed  = pSource[2];
+			pDestination[0] = nRed;
+			pDestination[1] = pSource[1];
+			pDestination[2] = nBlue;
+			pDestination[3] = pSource[3];
+		}
+	}
+	else
+	{
+		MemoryManager::Copy(pDestination, pSource, nNumOfPixels * 4);
+	}
+}
+
+
+#ifdef PLBERKELIUM_BUFFERCOPY_SSE2
+template <bool bSwizzle>
+void CopyRowSSE2(uint8 *pDestination, const uint8 *pSource, uint32 nNumOfPixels)
+{
+	if (bSwizzle)
+	{
+		// swap the first and third byte of every pixel, 4 pixels at a time
+		const __m128i mAlphaGreen = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+		const __m128i mLowByte    = _mm_set1_epi32(0x000000FF);
+		uint32 i = 0;
+		for (; i + 4 <= nNumOfPixels; i += 4)
+		{
+			const __m128i mPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i * 4));
+			const __m128i mRed    = _mm_and_si128(_mm_srli_epi32(mPixels, 16), mLowByte);
+			const __m128i mBlue   = _mm_slli_epi32(_mm_and_si128(mPixels, mLowByte), 16);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i * 4), _mm_or_si128(_mm_and_si128(mPixels, mAlphaGreen), _mm_or_si128(mRed, mBlue)));
+		}
+		// the remaining pixels
+		CopyRowScalar<true>(pDestination + i * 4, pSource + i * 4, nNumOfPixels - i);
+	}
+	else
+	{
+		MemoryManager::Copy(pDestination, pSource, nNumOfPixels * 4);
+	}
+}
+#endif
+
+
+#ifdef PLBERKELIUM_BUFFERCOPY_AVX2
+template <bool bSwizzle>
+PLBERKELIUM_TARGET_AVX2 void CopyRowAVX2(uint8 *pDestination, const uint8 *pSource, uint32 nNumOfPixels)
+{
+	if (bSwizzle)
+	{
+		// swap the first and third byte of every pixel, 8 pixels at a time
+		const __m256i mShuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+												  2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+		uint32 i = 0;
+		for (; i + 8 <= nNumOfPixels; i += 8)
+		{
+			const __m256i mPixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSource + i * 4));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDestination + i * 4), _mm256_shuffle_epi8(mPixels, mShuffle));
+		}
+		// the remaining pixels
+		CopyRowSSE2<true>(pDestination + i * 4, pSource + i * 4, nNumOfPixels - i);
+	}
+	else
+	{
+		MemoryManager::Copy(pDestination, pSource, nNumOfPixels * 4);
+	}
+}
+#endif
+
+
+EInstructionSet DetectInstructionSet()
+{
+	#if defined(_MSC_VER) && defined(PLBERKELIUM_BUFFERCOPY_SSE2)
+		int nInfo[4];
+		#ifdef PLBERKELIUM_BUFFERCOPY_AVX2
+			__cpuid(nInfo, 0);
+			const int nNumOfIds = nInfo[0];
+		#endif
+		__cpuid(nInfo, 1);
+		const bool bSSE2 = (nInfo[3] & (1 << 26)) != 0;
+		#ifdef PLBERKELIUM_BUFFERCOPY_AVX2
+			// AVX2 needs the OS to save the YMM registers
+			const bool bOSXSAVE = (nInfo[2] & (1 << 27)) != 0;
+			const bool bAVX     = (nInfo[2] & (1 << 28)) != 0;
+			if (nNumOfIds >= 7 && bOSXSAVE && bAVX && (_xgetbv(0) & 6) == 6)
+			{
+				__cpuidex(nInfo, 7, 0);
+				if (nInfo[1] & (1 << 5))
+					return InstructionSetAVX2;
+			}
+		#endif
+		return bSSE2 ? InstructionSetSSE2 : InstructionSetScalar;
+	#elif defined(__GNUC__) && defined(PLBERKELIUM_BUFFERCOPY_SSE2)
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+			return InstructionSetAVX2;
+		return __builtin_cpu_supports("sse2") ? InstructionSetSSE2 : InstructionSetScalar;
+	#else
+		return InstructionSetScalar;
+	#endif
+}
+
+
+struct sKernel
+{
+	EInstructionSet nInstructionSet;
+	CopyRowFunc pCopyRow[2];	/**< Indexed by swizzle */
+};
+
+
+sKernel SelectKernel()
+{
+	sKernel sResult;
+	sResult.nInstructionSet = DetectInstructionSet();
+	sResult.pCopyRow[0] = &CopyRowScalar<false>;
+	sResult.pCopyRow[1] = &CopyRowScalar<true>;
+	#ifdef PLBERKELIUM_BUFFERCOPY_SSE2
+		if (sResult.nInstructionSet == InstructionSetSSE2)
+		{
+			sResult.pCopyRow[0] = &CopyRowSSE2<false>;
+			sResult.pCopyRow[1] = &CopyRowSSE2<true>;
+		}
+	#endif
+	#ifdef PLBERKELIUM_BUFFERCOPY_AVX2
+		if (sResult.nInstructionSet == InstructionSetAVX2)
+		{
+			sResult.pCopyRow[0] = &CopyRowAVX2<false>;
+			sResult.pCopyRow[1] = &CopyRowAVX2<true>;
+		}
+	#endif
+	return sResult;
+}
+
+
+// selected once when the module is loaded
+const sKernel g_sKernel = SelectKernel();
+
+}
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+void BufferCopy::CopyRect(uint8 *pDestination, const int &nDestinationWidth, const int &nDestinationHeight, const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, const Berkelium::Rect &copyRect, const bool &bSwizzle)
+{
+	// clip the copy rect against the source buffer and the destination image
+	int nLeft   = copyRect.left()   > sourceBufferRect.left()   ? copyRect.left()   : sourceBufferRect.left();
+	int nTop    = copyRect.top()    > sourceBufferRect.top()    ? copyRect.top()    : sourceBufferRect.top();
+	int nRight  = copyRect.right()  < sourceBufferRect.right()  ? copyRect.right()  : sourceBufferRect.right();
+	int nBottom = copyRect.bottom() < sourceBufferRect.bottom() ? copyRect.bottom() : sourceBufferRect.bottom();
+	if (nLeft < 0)
+		nLeft = 0;
+	if (nTop < 0)
+		nTop = 0;
+	if (nRight > nDestinationWidth)
+		nRight = nDestinationWidth;
+	if (nBottom > nDestinationHeight)
+		nBottom = nDestinationHeight;
+	if (nRight <= nLeft || nBottom <= nTop)
+	{
+		// nothing left to copy
+		return;
+	}
+
+	const size_t nSourcePitch      = size_t(sourceBufferRect.width()) * 4;
+	const size_t nDestinationPitch = size_t(nDestinationWidth) * 4;
+	const uint32 nNumOfPixels      = uint32(nRight - nLeft);
+	const uint8 *pSource = sourceBuffer + size_t(nTop - sourceBufferRect.top()) * nSourcePitch + size_t(nLeft - sourceBufferRect.left()) * 4;
+	uint8 *pDestinationRow = pDestination + size_t(nTop) * nDestinationPitch + size_t(nLeft) * 4;
+
+	if (!bSwizzle && nSourcePitch == nDestinationPitch && nNumOfPixels == uint32(nDestinationWidth))
+	{
+		// full rows on both sides are one contiguous block
+		MemoryManager::Copy(pDestinationRow, pSource, nDestinationPitch * size_t(nBottom - nTop));
+	}
+	else
+	{
+		const CopyRowFunc pCopyRow = g_sKernel.pCopyRow[bSwizzle ? 1 : 0];
+		for (int nRow = nTop; nRow < nBottom; nRow++)
+		{
+			pCopyRow(pDestinationRow, pSource, nNumOfPixels);
+			pDestinationRow += nDestinationPitch;
+			pSource += nSourcePitch;
+		}
+	}
+}
+
+
+void BufferCopy::CopyRects(uint8 *pDestination, const int &nDestinationWidth, const int &nDestinationHeight, const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, size_t numCopyRects, const Berkelium::Rect *copyRects, const bool &bSwizzle)
+{
+	for (size_t i = 0; i < numCopyRects; i++)
+	{
+		CopyRect(pDestination, nDestinationWidth, nDestinationHeight, sourceBuffer, sourceBufferRect, copyRects[i], bSwizzle);
+	}
+}
+
+
+void BufferCopy::ScrollRect(uint8 *pImageBuffer, const int &nWidth, const int &nHeight, int dx, int dy, const Berkelium::Rect &scrollRect)
+{
+	// clip the scroll rect against the image
+	const int nLeft   = scrollRect.left()   < 0       ? 0       : scrollRect.left();
+	const int nTop    = scrollRect.top()    < 0       ? 0       : scrollRect.top();
+	const int nRight  = scrollRect.right()  > nWidth  ? nWidth  : scrollRect.right();
+	const int nBottom = scrollRect.bottom() > nHeight ? nHeight : scrollRect.bottom();
+
+	// the region whose content stays inside the scroll rect after moving, given as source
+	const int nSourceLeft   = (dx > 0) ? nLeft : nLeft - dx;
+	const int nSourceRight  = (dx > 0) ? nRight - dx : nRight;
+	const int nSourceTop    = (dy > 0) ? nTop : nTop - dy;
+	const int nSourceBottom = (dy > 0) ? nBottom - dy : nBottom;
+	if (nSourceRight <= nSourceLeft || nSourceBottom <= nSourceTop || (dx == 0 && dy == 0))
+	{
+		// nothing is shared, everything is exposed
+		return;
+	}
+
+	const size_t nPitch       = size_t(nWidth) * 4;
+	const size_t nRowSize     = size_t(nSourceRight - nSourceLeft) * 4;
+	const int    nNumOfRows   = nSourceBottom - nSourceTop;
+	const uint8 *pSourceRow   = pImageBuffer + size_t(nSourceTop) * nPitch + size_t(nSourceLeft) * 4;
+	uint8 *pDestinationRow    = pImageBuffer + size_t(nSourceTop + dy) * nPitch + size_t(nSourceLeft + dx) * 4;
+
+	if (dy > 0)
+	{
+		// moving down, start with the last row so that no row is overwritten before it was read
+		pSourceRow      += size_t(nNumOfRows - 1) * nPitch;
+		pDestinationRow += size_t(nNumOfRows - 1) * nPitch;
+		for (int nRow = 0; nRow < nNumOfRows; nRow++, pSourceRow -= nPitch, pDestinationRow -= nPitch)
+		{
+			memmove(pDestinationRow, pSourceRow, nRowSize);
+		}
+	}
+	else
+	{
+		// moving up or only horizontally, start with the first row, memmove takes care of overlap within a row
+		for (int nRow = 0; nRow < nNumOfRows; nRow++, pSourceRow += nPitch, pDestinationRow += nPitch)
+		{
+			memmove(pDestinationRow, pSourceRow, nRowSize);
+		}
+	}
+}
+
+
+void BufferCopy::CopyRow(uint8 *pDestination, const uint8 *pSource, uint32 nNumOfPixels, const bool &bSwizzle)
+{
+	g_sKernel.pCopyRow[bSwizzle ? 1 : 0](pDestination, pSource, nNumOfPixels);
+}
+
+
+String BufferCopy::GetInstructionSet()
+{
+	switch (g_sKernel.nInstructionSet)
+	{
+		case InstructionSetAVX2:
+			return "AVX2";
+
+		case InstructionSetSSE2:
+			return "SSE2";
+
+		default:
+			return "Scalar";
+	}
+}
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+} // PLBerkelium
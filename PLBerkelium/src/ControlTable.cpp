@@ -0,0 +1,258 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/ControlTable.h"
+
+#include <PLCore/Container/List.h>
+
+#include "berkelium/Window.hpp"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLInput;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Structures                                            ]
+//[-------------------------------------------------------]
+struct sControlDefinition
+{
+	const char *pszName;	/**< Name of the control in PLInput::VirtualStandardController */
+	EControlKind nKind;
+	int nCode;
+	char nText;
+	char nShiftText;
+	int nModifier;
+	bool bKeypad;
+};
+
+
+//[-------------------------------------------------------]
+//[ Definitions                                           ]
+//[-------------------------------------------------------]
+// the index of a definition is the ID of the control, the shift characters follow the US layout where PLInput cannot tell
+static const sControlDefinition g_sControlDefinitions[] =
+{
+	{ "MouseX",						ControlKindMouseMove,	0,		0,		0,		0,							false },
+	{ "MouseY",						ControlKindMouseMove,	0,		0,		0,		0,							false },
+	{ "MouseLeft",					ControlKindMouseButton,	0,		0,		0,		0,							false },
+	{ "MouseMiddle",				ControlKindMouseButton,	1,		0,		0,		0,							false },
+	{ "MouseRight",					ControlKindMouseButton,	2,		0,		0,		0,							false },
+	{ "MouseWheel",					ControlKindMouseWheel,	0,		0,		0,		0,							false },
+	{ "KeyboardBackspace",			ControlKindKey,			0x08,	0,		0,		0,							false },
+	{ "KeyboardTab",				ControlKindKey,			0x09,	0,		0,		0,							false },
+	{ "KeyboardClear",				ControlKindKey,			0x0C,	0,		0,		0,							false },
+	{ "KeyboardReturn",				ControlKindKey,			0x0D,	'\r',	0,		0,							false },
+	{ "KeyboardShift",				ControlKindKey,			0x10,	0,		0,		Berkelium::SHIFT_MOD,		false },
+	{ "KeyboardControl",			ControlKindKey,			0x11,	0,		0,		Berkelium::CONTROL_MOD,		false },
+	{ "KeyboardAlt",				ControlKindKey,			0x12,	0,		0,		Berkelium::ALT_MOD,			false },
+	{ "KeyboardPause",				ControlKindKey,			0x13,	0,		0,		0,							false },
+	{ "KeyboardCapsLock",			ControlKindKey,			0x14,	0,		0,		0,							false },
+	{ "KeyboardEscape",				ControlKindKey,			0x1B,	0,		0,		0,							false },
+	{ "KeyboardSpace",				ControlKindKey,			0x20,	' ',	0,		0,							false },
+	{ "KeyboardPageUp",				ControlKindKey,			0x21,	0,		0,		0,							false },
+	{ "KeyboardPageDown",			ControlKindKey,			0x22,	0,		0,		0,							false },
+	{ "KeyboardEnd",				ControlKindKey,			0x23,	0,		0,		0,							false },
+	{ "KeyboardHome",				ControlKindKey,			0x24,	0,		0,		0,							false },
+	{ "KeyboardLeft",				ControlKindKey,			0x25,	0,		0,		0,							false },
+	{ "KeyboardUp",					ControlKindKey,			0x26,	0,		0,		0,							false },
+	{ "KeyboardRight",				ControlKindKey,			0x27,	0,		0,		0,							false },
+	{ "KeyboardDown",				ControlKindKey,			0x28,	0,		0,		0,							false },
+	{ "KeyboardSelect",				ControlKindKey,			0x29,	0,		0,		0,							false },
+	{ "KeyboardPrint",				ControlKindKey,			0x2A,	0,		0,		0,							false },
+	{ "KeyboardExecute",			ControlKindKey,			0x2B,	0,		0,		0,							false },
+	{ "KeyboardInsert",				ControlKindKey,			0x2D,	0,		0,		0,							false },
+	{ "KeyboardDelete",				ControlKindKey,			0x2E,	0,		0,		0,							false },
+	{ "KeyboardHelp",				ControlKindKey,			0x2F,	0,		0,		0,							false },
+	{ "Keyboard0",					ControlKindKey,			0x30,	'0',	')',	0,							false },
+	{ "Keyboard1",					ControlKindKey,			0x31,	'1',	'!',	0,							false },
+	{ "Keyboard2",					ControlKindKey,			0x32,	'2',	'@',	0,							false },
+	{ "Keyboard3",					ControlKindKey,			0x33,	'3',	'#',	0,							false },
+	{ "Keyboard4",					ControlKindKey,			0x34,	'4',	'$',	0,							false },
+	{ "Keyboard5",					ControlKindKey,			0x35,	'5',	'%',	0,							false },
+	{ "Keyboard6",					ControlKindKey,			0x36,	'6',	'^',	0,							false },
+	{ "Keyboard7",					ControlKindKey,			0x37,	'7',	'&',	0,							false },
+	{ "Keyboard8",					ControlKindKey,			0x38,	'8',	'*',	0,							false },
+	{ "Keyboard9",					ControlKindKey,			0x39,	'9',	'(',	0,							false },
+	{ "KeyboardA",					ControlKindKey,			0x41,	'a',	'A',	0,							false },
+	{ "KeyboardB",					ControlKindKey,			0x42,	'b',	'B',	0,							false },
+	{ "KeyboardC",					ControlKindKey,			0x43,	'c',	'C',	0,							false },
+	{ "KeyboardD",					ControlKindKey,			0x44,	'd',	'D',	0,							false },
+	{ "KeyboardE",					ControlKindKey,			0x45,	'e',	'E',	0,							false },
+	{ "KeyboardF",					ControlKindKey,			0x46,	'f',	'F',	0,							false },
+	{ "KeyboardG",					ControlKindKey,			0x47,	'g',	'G',	0,							false },
+	{ "KeyboardH",					ControlKindKey,			0x48,	'h',	'H',	0,							false },
+	{ "KeyboardI",					ControlKindKey,			0x49,	'i',	'I',	0,							false },
+	{ "KeyboardJ",					ControlKindKey,			0x4A,	'j',	'J',	0,							false },
+	{ "KeyboardK",					ControlKindKey,			0x4B,	'k',	'K',	0,							false },
+	{ "KeyboardL",					ControlKindKey,			0x4C,	'l',	'L',	0,							false },
+	{ "KeyboardM",					ControlKindKey,			0x4D,	'm',	'M',	0,							false },
+	{ "KeyboardN",					ControlKindKey,			0x4E,	'n',	'N',	0,							false },
+	{ "KeyboardO",					ControlKindKey,			0x4F,	'o',	'O',	0,							false },
+	{ "KeyboardP",					ControlKindKey,			0x50,	'p',	'P',	0,							false },
+	{ "KeyboardQ",					ControlKindKey,			0x51,	'q',	'Q',	0,							false },
+	{ "KeyboardR",					ControlKindKey,			0x52,	'r',	'R',	0,							false },
+	{ "KeyboardS",					ControlKindKey,			0x53,	's',	'S',	0,							false },
+	{ "KeyboardT",					ControlKindKey,			0x54,	't',	'T',	0,							false },
+	{ "KeyboardU",					ControlKindKey,			0x55,	'u',	'U',	0,							false },
+	{ "KeyboardV",					ControlKindKey,			0x56,	'v',	'V',	0,							false },
+	{ "KeyboardW",					ControlKindKey,			0x57,	'w',	'W',	0,							false },
+	{ "KeyboardX",					ControlKindKey,			0x58,	'x',	'X',	0,							false },
+	{ "KeyboardY",					ControlKindKey,			0x59,	'y',	'Y',	0,							false },
+	{ "KeyboardZ",					ControlKindKey,			0x5A,	'z',	'Z',	0,							false },
+	{ "KeyboardLeftWindows",		ControlKindKey,			0x5B,	0,		0,		Berkelium::META_MOD,		false },
+	{ "KeyboardRightWindows",		ControlKindKey,			0x5C,	0,		0,		Berkelium::META_MOD,		false },
+	{ "KeyboardNumpad0",			ControlKindKey,			0x60,	'0',	0,		0,							true },
+	{ "KeyboardNumpad1",			ControlKindKey,			0x61,	'1',	0,		0,							true },
+	{ "KeyboardNumpad2",			ControlKindKey,			0x62,	'2',	0,		0,							true },
+	{ "KeyboardNumpad3",			ControlKindKey,			0x63,	'3',	0,		0,							true },
+	{ "KeyboardNumpad4",			ControlKindKey,			0x64,	'4',	0,		0,							true },
+	{ "KeyboardNumpad5",			ControlKindKey,			0x65,	'5',	0,		0,							true },
+	{ "KeyboardNumpad6",			ControlKindKey,			0x66,	'6',	0,		0,							true },
+	{ "KeyboardNumpad7",			ControlKindKey,			0x67,	'7',	0,		0,							true },
+	{ "KeyboardNumpad8",			ControlKindKey,			0x68,	'8',	0,		0,							true },
+	{ "KeyboardNumpad9",			ControlKindKey,			0x69,	'9',	0,		0,							true },
+	{ "KeyboardNumpadMultiply",		ControlKindKey,			0x6A,	'*',	0,		0,							true },
+	{ "KeyboardNumpadAdd",			ControlKindKey,			0x6B,	'+',	0,		0,							true },
+	{ "KeyboardNumpadSeparator",	ControlKindKey,			0x6C,	0,		0,		0,							true },
+	{ "KeyboardNumpadSubtract",		ControlKindKey,			0x6D,	'-',	0,		0,							true },
+	{ "KeyboardNumpadDecimal",		ControlKindKey,			0x6E,	'.',	0,		0,							true },
+	{ "KeyboardNumpadDivide",		ControlKindKey,			0x6F,	'/',	0,		0,							true },
+	{ "KeyboardF1",					ControlKindKey,			0x70,	0,		0,		0,							false },
+	{ "KeyboardF2",					ControlKindKey,			0x71,	0,		0,		0,							false },
+	{ "KeyboardF3",					ControlKindKey,			0x72,	0,		0,		0,							false },
+	{ "KeyboardF4",					ControlKindKey,			0x73,	0,		0,		0,							false },
+	{ "KeyboardF5",					ControlKindKey,			0x74,	0,		0,		0,							false },
+	{ "KeyboardF6",					ControlKindKey,			0x75,	0,		0,		0,							false },
+	{ "KeyboardF7",					ControlKindKey,			0x76,	0,		0,		0,							false },
+	{ "KeyboardF8",					ControlKindKey,			0x77,	0,		0,		0,							false },
+	{ "KeyboardF9",					ControlKindKey,			0x78,	0,		0,		0,							false },
+	{ "KeyboardF10",				ControlKindKey,			0x79,	0,		0,		0,							false },
+	{ "KeyboardF11",				ControlKindKey,			0x7A,	0,		0,		0,							false },
+	{ "KeyboardF12",				ControlKindKey,			0x7B,	0,		0,		0,							false },
+	{ "KeyboardNumLock",			ControlKindKey,			0x90,	0,		0,		0,							false },
+	{ "KeyboardScrollLock",			ControlKindKey,			0x91,	0,		0,		0,							false },
+	{ "KeyboardCircumflex",			ControlKindKey,			0xDC,	'^',	0,		0,							false }
+};
+static const uint32 g_nNumOfControlDefinitions = sizeof(g_sControlDefinitions)/sizeof(sControlDefinition);
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+ControlTable::ControlTable() :
+	m_psBindings(nullptr),
+	m_nNumOfBindings(0)
+{
+}
+
+
+ControlTable::~ControlTable()
+{
+	Clear();
+}
+
+
+uint32 ControlTable::Resolve(const Controller &cController)
+{
+	Clear();
+
+	const List<Control*> &lstControls = cController.GetControls();
+	if (!lstControls.GetNumOfElements())
+	{
+		return 0;
+	}
+	m_psBindings = new sControlBinding[lstControls.GetNumOfElements()];
+
+	for (uint32 i = 0; i < lstControls.GetNumOfElements(); i++)
+	{
+		const Control *pControl = lstControls.Get(i);
+		if (!pControl)
+		{
+			continue;
+		}
+
+		// the only string compares, an event never compares a name again
+		const String &sName = pControl->GetName();
+		for (uint32 nID = 0; nID < g_nNumOfControlDefinitions; nID++)
+		{
+			const sControlDefinition &sDefinition = g_sControlDefinitions[nID];
+			if (sName == sDefinition.pszName)
+			{
+				sControlBinding sBinding;
+				sBinding.pControl = pControl;
+				sBinding.sInfo.nID = nID;
+				sBinding.sInfo.nKind = sDefinition.nKind;
+				sBinding.sInfo.nCode = sDefinition.nCode;
+				sBinding.sInfo.nText = sDefinition.nText;
+				sBinding.sInfo.nShiftText = sDefinition.nShiftText;
+				sBinding.sInfo.nModifier = sDefinition.nModifier;
+				sBinding.sInfo.bKeypad = sDefinition.bKeypad;
+
+				// sorted in by the control address, a controller has a few hundred controls at most
+				uint32 nIndex = m_nNumOfBindings;
+				while (nIndex > 0 && m_psBindings[nIndex - 1].pControl > pControl)
+				{
+					m_psBindings[nIndex] = m_psBindings[nIndex - 1];
+					nIndex--;
+				}
+				m_psBindings[nIndex] = sBinding;
+				m_nNumOfBindings++;
+				break;
+			}
+		}
+	}
+
+	return m_nNumOfBindings;
+}
+
+
+void ControlTable::Clear()
+{
+	if (m_psBindings)
+	{
+		delete [] m_psBindings;
+		m_psBindings = nullptr;
+	}
+	m_nNumOfBindings = 0;
+}
+
+
+const sControlInfo *ControlTable::Get(const Control &cControl) const
+{
+	// binary search on the control address
+	uint32 nFirst = 0;
+	uint32 nLast = m_nNumOfBindings;
+	while (nFirst < nLast)
+	{
+		const uint32 nMiddle = (nFirst + nLast) / 2;
+		const Control *pControl = m_psBindings[nMiddle].pControl;
+		if (pControl == &cControl)
+		{
+			return &m_psBindings[nMiddle].sInfo;
+		}
+		if (pControl < &cControl)
+		{
+			nFirst = nMiddle + 1;
+		}
+		else
+		{
+			nLast = nMiddle;
+		}
+	}
+	return nullptr;
+}
+
+
+uint32 ControlTable::GetNumOfBindings() const
+{
+	return m_nNumOfBindings;
+}
+
+
+};
@@ -0,0 +1,321 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/CopyWorkerPool.h"
+
+#include <PLCore/System/System.h>
+
+#include "PLBerkelium/BufferCopy.h"
+
+#ifdef WIN32
+	#include <PLCore/PLCoreWindowsIncludes.h>
+#else
+	#include <unistd.h>
+#endif
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Internal helpers                                      ]
+//[-------------------------------------------------------]
+// bands are never smaller than this, so a worker always gets a worthwhile amount of rows
+static const int MinBandRows = 16;
+
+// default number of pixels a copy needs before it is shared with the workers (a 256x256 rect)
+static const uint32 DefaultThreshold = 256 * 256;
+
+// workers never exceed this, the copies are bound by memory bandwidth long before
+static const uint32 MaxWorkers = 8;
+
+
+/**
+*  @brief
+*    Returns the number of workers to use, one less than there are processors
+*/
+static uint32 GetDefaultNumOfWorkers()
+{
+	#ifdef WIN32
+		SYSTEM_INFO sSystemInfo;
+		GetSystemInfo(&sSystemInfo);
+		const uint32 nNumOfProcessors = uint32(sSystemInfo.dwNumberOfProcessors);
+	#else
+		const long nOnline = sysconf(_SC_NPROCESSORS_ONLN);
+		const uint32 nNumOfProcessors = (nOnline > 0) ? uint32(nOnline) : 1;
+	#endif
+	return (nNumOfProcessors > 1) ? nNumOfProcessors - 1 : 0;
+}
+
+
+/**
+*  @brief
+*    Worker thread of the copy worker pool, runs tasks whenever the pool has work
+*/
+class CopyWorker : public Thread {
+
+
+	public:
+		CopyWorker(CopyWorkerPool *pPool) :
+			m_pPool(pPool)
+		{
+		}
+
+		virtual int Run() override
+		{
+			for (;;)
+			{
+				// wait for work
+				m_pPool->m_cWorkSemaphore.Lock();
+				if (m_pPool->m_bShutdown)
+				{
+					break;
+				}
+
+				// take tasks until there are none left and report back
+				m_pPool->RunTasks();
+				m_pPool->m_cDoneSemaphore.Unlock();
+			}
+			return 0;
+		}
+
+	private:
+		CopyWorkerPool *m_pPool;
+
+
+};
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+CopyWorkerPool::CopyWorkerPool(uint32 nNumOfWorkers) :
+	m_ppWorkers(nullptr),
+	m_nNumOfWorkers(0),
+	m_nThreshold(DefaultThreshold),
+	m_cWorkSemaphore(0, MaxWorkers),
+	m_cDoneSemaphore(0, MaxWorkers),
+	m_bShutdown(false),
+	m_pTasks(nullptr),
+	m_nMaxTasks(0),
+	m_nNumOfTasks(0),
+	m_nNextTask(0),
+	m_pDestination(nullptr),
+	m_nDestinationWidth(0),
+	m_nDestinationHeight(0),
+	m_pSourceBuffer(nullptr),
+	m_bSwizzle(false),
+	m_nFrameCopyTime(0),
+	m_nLastFrameCopyTime(0),
+	m_nNumOfSharedCopies(0)
+{
+	if (nNumOfWorkers == 0)
+	{
+		nNumOfWorkers = GetDefaultNumOfWorkers();
+	}
+	if (nNumOfWorkers > MaxWorkers)
+	{
+		nNumOfWorkers = MaxWorkers;
+	}
+
+	if (nNumOfWorkers > 0)
+	{
+		// start the workers, they wait for work right away
+		m_ppWorkers = new CopyWorker*[nNumOfWorkers];
+		for (uint32 i = 0; i < nNumOfWorkers; i++)
+		{
+			m_ppWorkers[i] = new CopyWorker(this);
+			if (!m_ppWorkers[i]->Start())
+			{
+				// could not start the thread, go on with the workers we have
+				delete m_ppWorkers[i];
+				break;
+			}
+			m_nNumOfWorkers++;
+		}
+	}
+}
+
+
+CopyWorkerPool::~CopyWorkerPool()
+{
+	// wake all workers up to let them leave
+	m_bShutdown = true;
+	for (uint32 i = 0; i < m_nNumOfWorkers; i++)
+	{
+		m_cWorkSemaphore.Unlock();
+	}
+	for (uint32 i = 0; i < m_nNumOfWorkers; i++)
+	{
+		m_ppWorkers[i]->Join();
+		delete m_ppWorkers[i];
+	}
+	delete [] m_ppWorkers;
+	delete [] m_pTasks;
+}
+
+
+uint32 CopyWorkerPool::GetNumOfWorkers() const
+{
+	return m_nNumOfWorkers;
+}
+
+
+void CopyWorkerPool::SetThreshold(uint32 nNumOfPixels)
+{
+	m_nThreshold = nNumOfPixels;
+}
+
+
+uint32 CopyWorkerPool::GetThreshold() const
+{
+	return m_nThreshold;
+}
+
+
+void CopyWorkerPool::CopyRects(uint8 *pDestination, const int &nDestinationWidth, const int &nDestinationHeight, const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, size_t numCopyRects, const Berkelium::Rect *copyRects, const bool &bSwizzle)
+{
+	const uint64 nStart = System::GetInstance()->GetMicroseconds();
+
+	// the part of the copy that actually lands in the destination image
+	Berkelium::Rect cImageRect;
+	cImageRect.mLeft = 0;
+	cImageRect.mTop = 0;
+	cImageRect.mWidth = nDestinationWidth;
+	cImageRect.mHeight = nDestinationHeight;
+	uint64 nNumOfPixels = 0;
+	for (size_t i = 0; i < numCopyRects; i++)
+	{
+		const Berkelium::Rect cRect = copyRects[i].intersect(sourceBufferRect).intersect(cImageRect);
+		nNumOfPixels += uint64(cRect.width()) * uint64(cRect.height());
+	}
+
+	if (m_nNumOfWorkers == 0 || nNumOfPixels < m_nThreshold)
+	{
+		// not worth waking anybody up
+		BufferCopy::CopyRects(pDestination, nDestinationWidth, nDestinationHeight, sourceBuffer, sourceBufferRect, numCopyRects, copyRects, bSwizzle);
+	}
+	else
+	{
+		// split large rects into row bands, one band per thread, every rect is at least one task
+		const int nNumOfThreads = int(m_nNumOfWorkers + 1);
+		m_nNumOfTasks = 0;
+		for (size_t i = 0; i < numCopyRects; i++)
+		{
+			const Berkelium::Rect cRect = copyRects[i].intersect(sourceBufferRect).intersect(cImageRect);
+			if (cRect.width() > 0 && cRect.height() > 0)
+			{
+				int nBandRows = (cRect.height() + nNumOfThreads - 1) / nNumOfThreads;
+				if (nBandRows < MinBandRows)
+				{
+					nBandRows = MinBandRows;
+				}
+				for (int nTop = cRect.top(); nTop < cRect.bottom(); nTop += nBandRows)
+				{
+					Berkelium::Rect cBand = cRect;
+					cBand.mTop = nTop;
+					cBand.mHeight = (cRect.bottom() - nTop < nBandRows) ? cRect.bottom() - nTop : nBandRows;
+					AddTask(cBand);
+				}
+			}
+		}
+
+		// the workers only read the job while it is running, so it can be set up without locking
+		m_pDestination = pDestination;
+		m_nDestinationWidth = nDestinationWidth;
+		m_nDestinationHeight = nDestinationHeight;
+		m_pSourceBuffer = sourceBuffer;
+		m_cSourceBufferRect = sourceBufferRect;
+		m_bSwizzle = bSwizzle;
+		m_nNextTask = 0;
+
+		// wake as many workers as there are tasks left for them, then help out
+		const uint32 nNumOfHelpers = (m_nNumOfTasks - 1 < m_nNumOfWorkers) ? m_nNumOfTasks - 1 : m_nNumOfWorkers;
+		for (uint32 i = 0; i < nNumOfHelpers; i++)
+		{
+			m_cWorkSemaphore.Unlock();
+		}
+		RunTasks();
+
+		// join, the image buffer has to be complete before it is uploaded
+		for (uint32 i = 0; i < nNumOfHelpers; i++)
+		{
+			m_cDoneSemaphore.Lock();
+		}
+		m_nNumOfSharedCopies++;
+	}
+
+	m_nFrameCopyTime += System::GetInstance()->GetMicroseconds() - nStart;
+}
+
+
+void CopyWorkerPool::EndFrame()
+{
+	m_nLastFrameCopyTime = m_nFrameCopyTime;
+	m_nFrameCopyTime = 0;
+}
+
+
+uint64 CopyWorkerPool::GetLastFrameCopyTime() const
+{
+	return m_nLastFrameCopyTime;
+}
+
+
+uint32 CopyWorkerPool::GetNumOfSharedCopies() const
+{
+	return m_nNumOfSharedCopies;
+}
+
+
+void CopyWorkerPool::AddTask(const Berkelium::Rect &cRect)
+{
+	if (m_nNumOfTasks == m_nMaxTasks)
+	{
+		// grow the task list, it is kept for later copies
+		const uint32 nMaxTasks = (m_nMaxTasks > 0) ? m_nMaxTasks * 2 : 64;
+		Berkelium::Rect *pTasks = new Berkelium::Rect[nMaxTasks];
+		for (uint32 i = 0; i < m_nNumOfTasks; i++)
+		{
+			pTasks[i] = m_pTasks[i];
+		}
+		delete [] m_pTasks;
+		m_pTasks = pTasks;
+		m_nMaxTasks = nMaxTasks;
+	}
+	m_pTasks[m_nNumOfTasks] = cRect;
+	m_nNumOfTasks++;
+}
+
+
+void CopyWorkerPool::RunTasks()
+{
+	for (;;)
+	{
+		// take the next open task
+		m_cTaskMutex.Lock();
+		const uint32 nTask = m_nNextTask;
+		if (nTask < m_nNumOfTasks)
+		{
+			m_nNextTask++;
+		}
+		m_cTaskMutex.Unlock();
+
+		if (nTask >= m_nNumOfTasks)
+		{
+			// all tasks are taken
+			break;
+		}
+
+		// bands never overlap and overlapping rects write the same pixels, so tasks can be copied at the same time
+		BufferCopy::CopyRect(m_pDestination, m_nDestinationWidth, m_nDestinationHeight, m_pSourceBuffer, m_cSourceBufferRect, m_pTasks[nTask], m_bSwizzle);
+	}
+}
+
+
+};
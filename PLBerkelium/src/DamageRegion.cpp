@@ -0,0 +1,281 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/DamageRegion.h"
+
+#include <PLCore/Core/MemoryManager.h>
+
+#include "PLBerkelium/TextureUploader.h"
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Internal helpers                                      ]
+//[-------------------------------------------------------]
+static inline uint64 GetRectArea(const Berkelium::Rect &cRect)
+{
+	return uint64(cRect.width()) * uint64(cRect.height());
+}
+
+
+static inline Berkelium::Rect GetBoundingRect(const Berkelium::Rect &cFirst, const Berkelium::Rect &cSecond)
+{
+	Berkelium::Rect cBounds;
+	cBounds.mLeft   = (cFirst.left() < cSecond.left()) ? cFirst.left() : cSecond.left();
+	cBounds.mTop    = (cFirst.top() < cSecond.top()) ? cFirst.top() : cSecond.top();
+	cBounds.mWidth  = ((cFirst.right() > cSecond.right()) ? cFirst.right() : cSecond.right()) - cBounds.mLeft;
+	cBounds.mHeight = ((cFirst.bottom() > cSecond.bottom()) ? cFirst.bottom() : cSecond.bottom()) - cBounds.mTop;
+	return cBounds;
+}
+
+
+static inline uint64 GetIntersectionArea(const Berkelium::Rect &cFirst, const Berkelium::Rect &cSecond)
+{
+	const int nLeft   = (cFirst.left() > cSecond.left()) ? cFirst.left() : cSecond.left();
+	const int nTop    = (cFirst.top() > cSecond.top()) ? cFirst.top() : cSecond.top();
+	const int nRight  = (cFirst.right() < cSecond.right()) ? cFirst.right() : cSecond.right();
+	const int nBottom = (cFirst.bottom() < cSecond.bottom()) ? cFirst.bottom() : cSecond.bottom();
+	return (nRight > nLeft && nBottom > nTop) ? uint64(nRight - nLeft) * uint64(nBottom - nTop) : 0;
+}
+
+
+static inline Berkelium::Rect MakeRect(int nLeft, int nTop, int nWidth, int nHeight)
+{
+	Berkelium::Rect cRect;
+	cRect.mLeft   = nLeft;
+	cRect.mTop    = nTop;
+	cRect.mWidth  = nWidth;
+	cRect.mHeight = nHeight;
+	return cRect;
+}
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+DamageRegion::DamageRegion() :
+	m_nWidth(0),
+	m_nHeight(0),
+	m_nCallCost(4096),
+	m_bExact(false),
+	m_bFull(false),
+	m_nNumOfRects(0)
+{
+}
+
+
+void DamageRegion::SetSize(const int &nWidth, const int &nHeight)
+{
+	if (m_nWidth != nWidth || m_nHeight != nHeight)
+	{
+		m_nWidth = nWidth;
+		m_nHeight = nHeight;
+		Clear();
+	}
+}
+
+
+void DamageRegion::SetCallCost(uint32 nNumOfPixels)
+{
+	m_nCallCost = nNumOfPixels;
+}
+
+
+uint32 DamageRegion::GetCallCost() const
+{
+	return m_nCallCost;
+}
+
+
+void DamageRegion::SetExact(const bool &bExact)
+{
+	m_bExact = bExact;
+}
+
+
+bool DamageRegion::IsExact() const
+{
+	return m_bExact;
+}
+
+
+void DamageRegion::Clear()
+{
+	m_bFull = false;
+	m_nNumOfRects = 0;
+}
+
+
+void DamageRegion::AddFull()
+{
+	m_bFull = true;
+	m_cRects[0] = MakeRect(0, 0, m_nWidth, m_nHeight);
+	m_nNumOfRects = (m_nWidth > 0 && m_nHeight > 0) ? 1 : 0;
+}
+
+
+bool DamageRegion::Add(const Berkelium::Rect &cRect)
+{
+	if (m_bFull)
+	{
+		// already covered
+		return true;
+	}
+
+	const Berkelium::Rect cClippedRect = TextureUploader::ClipRect(cRect, m_nWidth, m_nHeight);
+	if (cClippedRect.width() <= 0 || cClippedRect.height() <= 0)
+	{
+		// nothing to add
+		return true;
+	}
+	return Insert(cClippedRect);
+}
+
+
+size_t DamageRegion::Add(size_t nNumOfRects, const Berkelium::Rect *pRects)
+{
+	for (size_t i = 0; i < nNumOfRects; i++)
+	{
+		if (!Add(pRects[i]))
+		{
+			return i;
+		}
+	}
+	return nNumOfRects;
+}
+
+
+bool DamageRegion::IsEmpty() const
+{
+	return (m_nNumOfRects == 0);
+}
+
+
+bool DamageRegion::IsFull() const
+{
+	return m_bFull;
+}
+
+
+uint32 DamageRegion::GetNumOfRects() const
+{
+	return m_nNumOfRects;
+}
+
+
+const Berkelium::Rect *DamageRegion::GetRects() const
+{
+	return m_cRects;
+}
+
+
+uint64 DamageRegion::GetArea() const
+{
+	uint64 nArea = 0;
+	for (uint32 i = 0; i < m_nNumOfRects; i++)
+		nArea += GetRectArea(m_cRects[i]);
+	return nArea;
+}
+
+
+uint64 DamageRegion::GetCost() const
+{
+	return GetArea() + uint64(m_nNumOfRects) * m_nCallCost;
+}
+
+
+float DamageRegion::GetCoveredFraction() const
+{
+	if (m_nWidth <= 0 || m_nHeight <= 0)
+		return 0.0f;
+	return float(double(GetArea()) / (double(m_nWidth) * double(m_nHeight)));
+}
+
+
+bool DamageRegion::Insert(Berkelium::Rect cRect)
+{
+	// merge with every rect that is worth it, the bounding rect may then be worth merging with others
+	for (uint32 i = 0; i < m_nNumOfRects;)
+	{
+		if (IsWorthMerging(cRect, m_cRects[i]))
+		{
+			cRect = GetBoundingRect(cRect, m_cRects[i]);
+			m_nNumOfRects--;
+			m_cRects[i] = m_cRects[m_nNumOfRects];
+			i = 0;
+		}
+		else
+		{
+			i++;
+		}
+	}
+
+	if (m_nNumOfRects == MAXDAMAGERECTS)
+	{
+		if (m_bExact)
+		{
+			// nothing was merged, so the region is unchanged
+			return false;
+		}
+
+		// take the rect in and merge the pair that wastes the least pixels
+		m_cRects[m_nNumOfRects] = cRect;
+		m_nNumOfRects++;
+		uint32 nFirst  = 0;
+		uint32 nSecond = 1;
+		uint64 nLeastWaste = ~uint64(0);
+		for (uint32 i = 0; i < m_nNumOfRects; i++)
+		{
+			for (uint32 j = i + 1; j < m_nNumOfRects; j++)
+			{
+				const uint64 nBounds = GetRectArea(GetBoundingRect(m_cRects[i], m_cRects[j]));
+				const uint64 nBoth   = GetRectArea(m_cRects[i]) + GetRectArea(m_cRects[j]);
+				const uint64 nWaste  = (nBounds > nBoth) ? nBounds - nBoth : 0;
+				if (nWaste < nLeastWaste)
+				{
+					nLeastWaste = nWaste;
+					nFirst  = i;
+					nSecond = j;
+				}
+			}
+		}
+		const Berkelium::Rect cMerged = GetBoundingRect(m_cRects[nFirst], m_cRects[nSecond]);
+
+		// remove the second first, it has the higher index
+		m_nNumOfRects--;
+		m_cRects[nSecond] = m_cRects[m_nNumOfRects];
+		m_nNumOfRects--;
+		m_cRects[nFirst] = m_cRects[m_nNumOfRects];
+		return Insert(cMerged);
+	}
+
+	m_cRects[m_nNumOfRects] = cRect;
+	m_nNumOfRects++;
+	return true;
+}
+
+
+bool DamageRegion::IsWorthMerging(const Berkelium::Rect &cFirst, const Berkelium::Rect &cSecond) const
+{
+	const uint64 nBounds = GetRectArea(GetBoundingRect(cFirst, cSecond));
+	const uint64 nFirst  = GetRectArea(cFirst);
+	const uint64 nSecond = GetRectArea(cSecond);
+	if (m_bExact)
+	{
+		// the bounding rect has to be exactly the union of both
+		return (nBounds == nFirst + nSecond - GetIntersectionArea(cFirst, cSecond));
+	}
+
+	// one upload of the bounding rect against two uploads of both rects
+	return (nBounds <= nFirst + nSecond + m_nCallCost);
+}
+
+
+};
@@ -35,6 +35,7 @@ Gui::Gui() :
 	m_pCurrentSceneRenderer(nullptr),
 	m_pCurrentRenderer(nullptr),
 	m_pSRPMousePointer(nullptr),
+	m_pCompositor(nullptr),
 	m_pFocusedWindow(nullptr),
 	m_bControlsEnabled(true),
 	m_bIsUpdateConnected(false),
@@ -48,13 +49,27 @@ Gui::Gui() :
 	m_pResizeWindow(nullptr),
 	m_bMouseMoved(false),
 	m_vLockMousePos(Vector2i::Zero),
-	m_pmapTextButtonHandler(new HashMap<String, sButton*>),
-	m_pmapKeyButtonHandler(new HashMap<String, sButton*>),
-	m_nLastTextKeySendTime(0),
-	m_nLastKeySendTime(0),
-	m_nTextKeyHitCount(0),
-	m_nKeyHitCount(0)
+	m_pCopyWorkerPool(new CopyWorkerPool),
+	m_pSurfacePool(new SurfacePool),
+	m_pProgramCache(new ProgramCache),
+	m_pWindowAnimator(new WindowAnimator),
+	m_pHitTestIndex(new HitTestIndex),
+	m_pInputQueue(new InputQueue),
+	m_pControlTable(new ControlTable),
+	m_pKeyboardState(new KeyboardState),
+	m_pLastMoveWindow(nullptr),
+	m_vLastMovePos(Vector2i::Zero)
 {
+	// no frame yet
+	MemoryManager::Set(&m_sFrameStages, 0, sizeof(sFrameStages));
+
+	// the handler of each control kind, the controls are resolved to their kind when the controller is connected
+	m_cControlHandlers[ControlKindIgnored] = nullptr;
+	m_cControlHandlers[ControlKindMouseMove] = &Gui::MouseEvents;
+	m_cControlHandlers[ControlKindMouseButton] = &Gui::MouseEvents;
+	m_cControlHandlers[ControlKindMouseWheel] = &Gui::MouseEvents;
+	m_cControlHandlers[ControlKindKey] = &Gui::KeyboardEvents;
+
 	// initialize everything need to run berkelium
 	Initialize();
 }
@@ -64,14 +79,26 @@ Gui::~Gui()
 {
 	// we should destroy all windows
 	DestroyWindows();
+	// the windows are gone, so is the compositor that drew them
+	DestroyCompositor();
 	// we should destroy the mouse pointer
 	DestroyMousePointer();
 	// we should stop berkelium from doing anything else
 	StopBerkelium();
 	// cleanup
 	delete m_pmapWindows;
-	delete m_pmapTextButtonHandler;
-	delete m_pmapKeyButtonHandler;
+	delete m_pCopyWorkerPool;
+	// the windows gave their textures back, so the pool goes last
+	delete m_pSurfacePool;
+	// nothing uses the programs anymore
+	delete m_pProgramCache;
+	// the windows stopped their tweens
+	delete m_pWindowAnimator;
+	// the windows are gone, nothing is hit anymore
+	delete m_pHitTestIndex;
+	delete m_pInputQueue;
+	delete m_pControlTable;
+	delete m_pKeyboardState;
 }
 
 
@@ -119,6 +146,19 @@ bool Gui::AddWindow(const String &sName, const bool &pVisible, const String &sUr
 		pSRPWindow->GetData()->bNeedsFullUpdate = true;
 		pSRPWindow->GetData()->bLoaded = false;
 
+		// paint copies are shared by the worker pool
+		pSRPWindow->SetCopyWorkerPool(m_pCopyWorkerPool);
+		// textures are taken from the shared pool
+		pSRPWindow->SetSurfacePool(m_pSurfacePool);
+		// all windows are drawn in one pass
+		pSRPWindow->SetCompositor(m_pCompositor);
+		// programs are shared by all windows
+		pSRPWindow->SetProgramCache(m_pProgramCache);
+		// fades, slides and zooms are run by the shared animator
+		pSRPWindow->SetWindowAnimator(m_pWindowAnimator);
+		// the mouse events are routed by the shared hit test index
+		pSRPWindow->SetHitTestIndex(m_pHitTestIndex);
+
 		// we initialize the window
 		if (pSRPWindow->Initialize(m_pCurrentRenderer, Vector2(float(nX), float(nY)), Vector2(float(nWidth), float(nHeight))))
 		{
@@ -213,6 +253,85 @@ void Gui::UpdateBerkelium()
 {
 	// update berkelium
 	Berkelium::update();
+
+	// paints are copied during the update, so this was one frame of copies
+	m_pCopyWorkerPool->EndFrame();
+}
+
+
+void Gui::UploadWindows()
+{
+	Iterator<SRPWindow*> cIterator = m_pmapWindows->GetIterator();
+	while (cIterator.HasNext())
+	{
+		cIterator.Next()->Upload();
+	}
+}
+
+
+const sFrameStages &Gui::GetLastFrameStages() const
+{
+	return m_sFrameStages;
+}
+
+
+uint32 Gui::GetNumOfCopyWorkers() const
+{
+	return m_pCopyWorkerPool->GetNumOfWorkers();
+}
+
+
+uint64 Gui::GetLastFrameCopyTime() const
+{
+	return m_pCopyWorkerPool->GetLastFrameCopyTime();
+}
+
+
+SurfacePool *Gui::GetSurfacePool() const
+{
+	return m_pSurfacePool;
+}
+
+
+void Gui::TrimSurfacePool()
+{
+	m_pSurfacePool->Trim(0);
+}
+
+
+ProgramCache *Gui::GetProgramCache() const
+{
+	return m_pProgramCache;
+}
+
+
+WindowAnimator *Gui::GetWindowAnimator() const
+{
+	return m_pWindowAnimator;
+}
+
+
+HitTestIndex *Gui::GetHitTestIndex() const
+{
+	return m_pHitTestIndex;
+}
+
+
+InputQueue *Gui::GetInputQueue() const
+{
+	return m_pInputQueue;
+}
+
+
+ControlTable *Gui::GetControlTable() const
+{
+	return m_pControlTable;
+}
+
+
+KeyboardState *Gui::GetKeyboardState() const
+{
+	return m_pKeyboardState;
 }
 
 
@@ -237,6 +356,8 @@ void Gui::SetRenderers(Renderer *pRenderer, SceneRenderer *pSceneRenderer)
 				m_bRenderersInitialized = true;
 
 				//hack: [10-07-2012 Icefire] perhaps the following can be moved somewhere else
+				// create the compositor before the mouse pointer, so the pointer is drawn on top of the windows
+				CreateCompositor();
 				// create the mouse pointer
 				CreateMousePointer();
 			}
@@ -311,6 +432,11 @@ bool Gui::RemoveWindow(const String &sName)
 		{
 			m_pLastMouseWindow = nullptr;
 		}
+		// the next queued move has to reach the window under the mouse again
+		if (pSRPWindow == m_pLastMoveWindow)
+		{
+			m_pLastMoveWindow = nullptr;
+		}
 		
 		// remove the scene render pass from the renderer
 		pSRPWindow->RemoveSceneRenderPass();
@@ -362,6 +488,40 @@ SRPMousePointer *Gui::GetMousePointer() const
 }
 
 
+SRPCompositor *Gui::GetCompositor() const
+{
+	return m_pCompositor;
+}
+
+
+void Gui::CreateCompositor()
+{
+	// we create the compositor, it adds its scene render pass itself
+	m_pCompositor = new SRPCompositor(m_pCurrentRenderer, m_pCurrentSceneRenderer);
+	if (m_pCompositor->IsInitialized())
+	{
+		// it draws with the programs of the windows
+		m_pCompositor->SetProgramCache(m_pProgramCache);
+	}
+	else
+	{
+		// windows draw themselves without a compositor
+		m_pCompositor->DestroyInstance();
+		m_pCompositor = nullptr;
+	}
+}
+
+
+void Gui::DestroyCompositor() const
+{
+	if (m_pCompositor)
+	{
+		// the windows are destroyed before, they remove themselves from the compositor
+		m_pCompositor->DestroyInstance();
+	}
+}
+
+
 HashMap<String, SRPWindow*> *Gui::GetWindowsMap() const
 {
 	return m_pmapWindows;
@@ -385,6 +545,8 @@ void Gui::UnFocusAllWindows()
 {
 	// focused window needs to be a nullptr
 	m_pFocusedWindow = nullptr;
+	// held keys do not repeat into the next focused window
+	m_pKeyboardState->StopRepeats();
 	// get the iterator for all the windows
 	Iterator<SRPWindow*> cIterator = m_pmapWindows->GetIterator();
 	// loop trough the windows
@@ -396,10 +558,9 @@ void Gui::UnFocusAllWindows()
 }
 
 
-List<SRPWindow*> *Gui::GetMouseEnabledWindows()
+void Gui::UpdateHitTestIndex()
 {
-	// create an empty list
-	List<SRPWindow*> *plstMouseEnabledWindows = new List<SRPWindow*>;
+	m_pHitTestIndex->Clear();
 
 	// get the iterator for all the windows
 	Iterator<SRPWindow*> cIterator = m_pmapWindows->GetIterator();
@@ -407,25 +568,23 @@ List<SRPWindow*> *Gui::GetMouseEnabledWindows()
 	while (cIterator.HasNext())
 	{
 		SRPWindow *pSRPWindow = cIterator.Next();
-		if (pSRPWindow->GetData()->bIsVisable && pSRPWindow->GetData()->bMouseEnabled)
+		const sWindowsData *psWindowsData = pSRPWindow->GetData();
+		if (psWindowsData->bIsVisable && psWindowsData->bMouseEnabled)
 		{
-			// if the window is visible and the mouse for the window is enabled then add the window to the list
-			plstMouseEnabledWindows->Add(pSRPWindow);
+			// the z-order is the index of the window within the compositor or the scene renderer
+			const int nZ = pSRPWindow->GetSceneRenderPassIndex();
+			const Vector2i vSize = pSRPWindow->GetSize();
+			m_pHitTestIndex->Add(pSRPWindow, nZ, psWindowsData->nXPos, psWindowsData->nYPos, vSize.x, vSize.y, pSRPWindow->GetAlphaMask(), psWindowsData->fRenderScale);
+
+			// the widgets take the mouse for their window, they are rendered at its render scale
+			Iterator<sWidget*> cWidgetIterator = pSRPWindow->GetWidgets()->GetIterator();
+			while (cWidgetIterator.HasNext())
+			{
+				const sWidget *psWidget = cWidgetIterator.Next();
+				m_pHitTestIndex->Add(pSRPWindow, nZ, psWidget->nXPos, psWidget->nYPos, int(float(psWidget->nWidth)/psWindowsData->fRenderScale), int(float(psWidget->nHeight)/psWindowsData->fRenderScale));
+			}
 		}
 	}
-
-	if (plstMouseEnabledWindows->GetNumOfElements() > 0)
-	{
-		// list has items so return the list
-		return plstMouseEnabledWindows;
-	}
-	else
-	{
-		// we do not need the list any more
-		delete plstMouseEnabledWindows;
-		// return nothing because the list is empty
-		return nullptr;
-	}
 }
 
 
@@ -449,72 +608,6 @@ void Gui::FocusWindow(SRPWindow *pSRPWindow)
 }
 
 
-List<SRPWindow*> *Gui::GetMouseOverWindows(const List<SRPWindow*> *plstEnabledWindows, const Vector2i &vMousePos)
-{
-	if (!plstEnabledWindows)
-	{
-		// return nothing because the enabled windows list is not valid
-		return nullptr;
-	}
-
-	// create an empty list
-	List<SRPWindow*> *plstMouseOverWindows = new List<SRPWindow*>;
-
-	// get the iterator for the enabled windows
-	Iterator<SRPWindow*> cIterator = plstEnabledWindows->GetIterator();
-	// loop trough the enabled windows
-	while (cIterator.HasNext())
-	{
-		SRPWindow *pSRPWindow = cIterator.Next();
-
-		// get the relative mouse position for the window
-		Vector2i vRelativeMousePos = pSRPWindow->GetRelativeMousePosition(vMousePos);
-
-		if (vRelativeMousePos.x > 0 && vRelativeMousePos.y > 0 && vRelativeMousePos.x < pSRPWindow->GetSize().x && vRelativeMousePos.y < pSRPWindow->GetSize().y)
-		{
-			// the mouse is currently over the window, so we add the window to the list
-			plstMouseOverWindows->Add(pSRPWindow);
-		}
-		else
-		{
-			// check if any widgets are drawn for the window
-			if (pSRPWindow->GetWidgets()->GetNumOfElements() > 0)
-			{
-				// get the iterator for the widgets
-				Iterator<sWidget*> cWidgetIterator = pSRPWindow->GetWidgets()->GetIterator();
-				// loop trough the widgets
-				while (cWidgetIterator.HasNext())
-				{
-					sWidget *psWidget = cWidgetIterator.Next();
-
-					// get the relative mouse position for the widget
-					Vector2i vRelativeMousePosWidget = pSRPWindow->GetRelativeMousePositionWidget(psWidget, vMousePos);
-
-					if (vRelativeMousePosWidget.x > 0 && vRelativeMousePosWidget.y > 0 && vRelativeMousePosWidget.x < psWidget->nWidth && vRelativeMousePosWidget.y < psWidget->nHeight)
-					{
-						// the mouse is currently over the widget, so we add the window to the list
-						plstMouseOverWindows->Add(pSRPWindow);
-					}
-				}
-			}
-		}
-	}
-
-	if (plstMouseOverWindows->GetNumOfElements() > 0)
-	{
-		// list has items so return the list
-		return plstMouseOverWindows;
-	}
-	else
-	{
-		// we do not need the list any more
-		delete plstMouseOverWindows;
-		// return nothing because the list is empty
-		return nullptr;
-	}
-}
-
-
 SRPWindow *Gui::GetFocusedWindow() const
 {
 	return m_pFocusedWindow;
@@ -525,6 +618,8 @@ bool Gui::ConnectController(Controller *pController)
 {
 	if (pController && !m_bIsControllerConnected)
 	{
+		// the control names are compared once here and never again on an event
+		m_pControlTable->Resolve(*pController);
 		// connect the controller to the handler
 		pController->SignalOnControl.Connect(SlotOnControl);
 		m_bIsControllerConnected = true;
@@ -536,13 +631,32 @@ bool Gui::ConnectController(Controller *pController)
 
 void Gui::OnUpdate()
 {
+	// the stages run in a fixed order, so a window is never drawn with a texture that is not uploaded yet
+	const uint64 nStart = System::GetInstance()->GetMicroseconds();
+
+	// berkelium paints are copied, a resize is taken over with the first paint at the new size
 	UpdateBerkelium();
+	const uint64 nUpdated = System::GetInstance()->GetMicroseconds();
+
+	// the mouse events since the last update go out as one batch
+	DispatchInput();
 	// mouse handler?
 	KeyboardHandler();
 	DefaultCallBackHandler();
 	DragWindowHandler();
+	// resizes are previewed or sent to berkelium, the texture follows with the next paint
 	ResizeWindowHandler();
-	// resize window handler
+	// fades, slides and zooms only change draw parameters, nothing is repainted
+	m_pWindowAnimator->Update();
+	const uint64 nHandled = System::GetInstance()->GetMicroseconds();
+
+	// the paints go to the textures, the window passes draw them afterwards
+	UploadWindows();
+	const uint64 nUploaded = System::GetInstance()->GetMicroseconds();
+
+	m_sFrameStages.nUpdateTime = nUpdated - nStart;
+	m_sFrameStages.nHandlerTime = nHandled - nUpdated;
+	m_sFrameStages.nUploadTime = nUploaded - nHandled;
 }
 
 
@@ -559,7 +673,7 @@ bool Gui::ConnectEventUpdate(SceneContext *pSceneContext)
 }
 
 
-void Gui::MouseEvents(Control &cControl)
+void Gui::MouseEvents(Control &cControl, const sControlInfo &sInfo)
 {
 	// get the frontend
 	Frontend &cFrontend = static_cast<FrontendApplication*>(CoreApplication::GetApplication())->GetFrontend();
@@ -567,45 +681,121 @@ void Gui::MouseEvents(Control &cControl)
 	if (cFrontend.IsRunning() && cFrontend.IsMouseOver())
 	{
 		// get the mouse position
-		Vector2i vMousePos(cFrontend.GetMousePositionX(), cFrontend.GetMousePositionY());
-		// set the last known mouse position
-		m_vLastKnownMousePos = vMousePos;
-		
-		// check if mouse pointer is visible
-		if (GetMousePointer()->IsVisible() && GetMousePointer()->IsInitialized())
+		const Vector2i vMousePos(cFrontend.GetMousePositionX(), cFrontend.GetMousePositionY());
+		const uint64 nTime = Timing::GetInstance()->GetPastTime();
+		m_pInputQueue->Receive();
+
+		// the mouse supposedly has moved, consecutive moves are merged
+		if (!m_pInputQueue->AddMove(vMousePos, nTime))
 		{
-			// hide the native mouse pointer
-			// this should be a setting so that the user can decide if they want to hide the native mouse pointer
-			cFrontend.SetMouseVisible(false);
-
-			// set the position of the mouse pointer
-			GetMousePointer()->SetPosition(vMousePos.x, vMousePos.y);
-			// move the mouse pointer to front so that its always visible
-			GetMousePointer()->MoveToFront();
+			// the queue is full, so it does not wait for the update
+			m_pInputQueue->AddOverflow();
+			DispatchInput();
+			m_pInputQueue->AddMove(vMousePos, nTime);
 		}
-		else
+
+		if (sInfo.nKind == ControlKindMouseButton)
 		{
-			// show the native mouse pointer
-			// this should be a setting so that the user can decide if they want to show the native mouse pointer
-			cFrontend.SetMouseVisible(true);
+			const bool bPressed = static_cast<Button&>(cControl).IsPressed();
+			if (!m_pInputQueue->AddButton(vMousePos, sInfo.nCode, bPressed, nTime))
+			{
+				m_pInputQueue->AddOverflow();
+				DispatchInput();
+				m_pInputQueue->AddButton(vMousePos, sInfo.nCode, bPressed, nTime);
+			}
 		}
+		else if (sInfo.nKind == ControlKindMouseWheel)
+		{
+			const float fDelta = static_cast<Axis&>(cControl).GetValue();
+			if (!m_pInputQueue->AddWheel(vMousePos, fDelta, nTime))
+			{
+				m_pInputQueue->AddOverflow();
+				DispatchInput();
+				m_pInputQueue->AddWheel(vMousePos, fDelta, nTime);
+			}
+		}
+	}
+}
+
+
+void Gui::DispatchInput()
+{
+	const uint32 nNumOfEvents = m_pInputQueue->GetNumOfEvents();
+	if (!nNumOfEvents)
+	{
+		// the mouse did not do anything since the last update
+		return;
+	}
+
+	// get the frontend
+	Frontend &cFrontend = static_cast<FrontendApplication*>(CoreApplication::GetApplication())->GetFrontend();
+
+	// the pointer only has to be where the mouse was last
+	const Vector2i &vLastMousePos = m_pInputQueue->GetEvent(nNumOfEvents - 1).vPosition;
+	// check if mouse pointer is visible
+	if (GetMousePointer()->IsVisible() && GetMousePointer()->IsInitialized())
+	{
+		// hide the native mouse pointer
+		// this should be a setting so that the user can decide if they want to hide the native mouse pointer
+		cFrontend.SetMouseVisible(false);
+
+		// set the position of the mouse pointer
+		GetMousePointer()->SetPosition(vLastMousePos.x, vLastMousePos.y);
+		// move the mouse pointer to front so that its always visible
+		GetMousePointer()->MoveToFront();
+	}
+	else
+	{
+		// show the native mouse pointer
+		// this should be a setting so that the user can decide if they want to show the native mouse pointer
+		cFrontend.SetMouseVisible(true);
+	}
+
+	for (uint32 i = 0; i < nNumOfEvents; i++)
+	{
+		const sInputEvent &sEvent = m_pInputQueue->GetEvent(i);
+
+		// set the last known mouse position
+		m_vLastKnownMousePos = sEvent.vPosition;
 
 		// get the window that the mouse is over
 		// if there are more window under the mouse then it will return the top most
-		SRPWindow *pSRPWindow = GetTopMostWindow(GetMouseOverWindows(GetMouseEnabledWindows(), vMousePos));
+		if (m_pHitTestIndex->IsDirty())
+		{
+			// a window was moved, resized, shown, hidden or moved to front since the last mouse event
+			UpdateHitTestIndex();
+		}
+		SRPWindow *pSRPWindow = static_cast<SRPWindow*>(m_pHitTestIndex->Get(sEvent.vPosition));
 		if (pSRPWindow)
 		{
-			// move the mouse on the window
-			MouseMove(pSRPWindow, vMousePos);
-			// process mouse clicks on the window
-			MouseClicks(pSRPWindow, cControl);
-			// process mouse scrolls on the window
-			MouseScrolls(pSRPWindow, cControl);
+			if (pSRPWindow != m_pLastMoveWindow || sEvent.vPosition != m_vLastMovePos)
+			{
+				// move the mouse on the window, a button or wheel event at the same position needs no move
+				MouseMove(pSRPWindow, sEvent.vPosition);
+				m_pInputQueue->AddForwarded();
+				m_pLastMoveWindow = pSRPWindow;
+				m_vLastMovePos = sEvent.vPosition;
+			}
+			if (sEvent.nType == InputMouseButton)
+			{
+				// process mouse clicks on the window
+				MouseClicks(pSRPWindow, sEvent.nButton, sEvent.bPressed, sEvent.nTime);
+				m_pInputQueue->AddForwarded();
+			}
+			else if (sEvent.nType == InputMouseWheel)
+			{
+				// process mouse scrolls on the window
+				MouseScrolls(pSRPWindow, sEvent.fWheelDelta);
+				m_pInputQueue->AddForwarded();
+			}
 			// set the window that the mouse last had contact with
 			m_pLastMouseWindow = pSRPWindow;
 		}
 		else
 		{
+			// the mouse is outside, the next move on a window has to be sent
+			m_pLastMoveWindow = nullptr;
+
 			if (m_pLastMouseWindow)
 			{
 				// the mouse has left the window so the tooltip should be empty
@@ -615,10 +805,14 @@ void Gui::MouseEvents(Control &cControl)
 
 			if (m_pFocusedWindow)
 			{
-				// process mouse scrolls for the focused window
-				MouseScrolls(m_pFocusedWindow, cControl);
+				if (sEvent.nType == InputMouseWheel)
+				{
+					// process mouse scrolls for the focused window
+					MouseScrolls(m_pFocusedWindow, sEvent.fWheelDelta);
+					m_pInputQueue->AddForwarded();
+				}
 
-				if (cControl.GetName() == "MouseLeft")
+				if (sEvent.nType == InputMouseButton && sEvent.nButton == 0)
 				{
 					// we clicked outside a window so we need to unfocus it
 					//undone: [10-07-2012 Icefire] this should only happen on mouse down, also allow for more mouse buttons to unfocus a window (right, middle, etc)
@@ -626,43 +820,45 @@ void Gui::MouseEvents(Control &cControl)
 				}
 			}
 
-			if (cControl.GetName() == "MouseLeft")
+			if (sEvent.nType == InputMouseButton && sEvent.nButton == 0)
 			{
 				// set the state for the left mouse button
-				m_bMouseLeftDown = reinterpret_cast<Button&>(cControl).IsPressed();
+				m_bMouseLeftDown = sEvent.bPressed;
 			}
 		}
-
-		// the mouse supposedly has moved so we wanna know about it
-		//question: [10-07-2012 Icefire] perhaps a better check for this
-		m_bMouseMoved = true;
 	}
+	m_pInputQueue->Clear();
+
+	// the mouse supposedly has moved so we wanna know about it
+	//question: [10-07-2012 Icefire] perhaps a better check for this
+	m_bMouseMoved = true;
 }
 
 
-void Gui::MouseClicks(SRPWindow *pSRPWindow, Control &cControl)
+void Gui::MouseClicks(SRPWindow *pSRPWindow, const int &nButton, const bool &bPressed, const uint64 &nTime)
 {
-	if (cControl.GetName() == "MouseLeft")
+	if (nButton == 0)
 	{
 		// mouse clicked on a window so we need to focus it
 		//todo: [10-07-2012 Icefire] have this happen on mouse down only
 		FocusWindow(pSRPWindow);
 
-		if ((Timing::GetInstance()->GetPastTime() - m_nLastMouseLeftReleaseTime) > 0 && (Timing::GetInstance()->GetPastTime() - m_nLastMouseLeftReleaseTime) < 250)
+		// the time the event came in, not the time of the update, decides the double click
+		if ((nTime - m_nLastMouseLeftReleaseTime) > 0 && (nTime - m_nLastMouseLeftReleaseTime) < 250)
 		{
 			// we should send a double click
-			pSRPWindow->GetBerkeliumWindow()->mouseButton(0, reinterpret_cast<Button&>(cControl).IsPressed(), 2);
+			pSRPWindow->GetBerkeliumWindow()->mouseButton(0, bPressed, 2);
 			m_nLastMouseLeftReleaseTime = 0;
 		}
 		else
 		{
 			// send a single click
-			pSRPWindow->GetBerkeliumWindow()->mouseButton(0, reinterpret_cast<Button&>(cControl).IsPressed());
-			if (!reinterpret_cast<Button&>(cControl).IsPressed())
+			pSRPWindow->GetBerkeliumWindow()->mouseButton(0, bPressed);
+			if (!bPressed)
 			{
 				// mouse button has been released
 				m_bMouseLeftDown = false;
-				m_nLastMouseLeftReleaseTime = Timing::GetInstance()->GetPastTime();
+				m_nLastMouseLeftReleaseTime = nTime;
 			}
 			else
 			{
@@ -672,32 +868,26 @@ void Gui::MouseClicks(SRPWindow *pSRPWindow, Control &cControl)
 			}
 		}
 	}
-	if (cControl.GetName() == "MouseRight")
+	else
 	{
 		// mouse clicked on a window so we need to focus it
 		//todo: [10-07-2012 Icefire] have this happen on mouse down only
 		FocusWindow(pSRPWindow);
 
-		// send a right mouse click
-		pSRPWindow->GetBerkeliumWindow()->mouseButton(2, reinterpret_cast<Button&>(cControl).IsPressed());
+		// send a middle or right mouse click
+		pSRPWindow->GetBerkeliumWindow()->mouseButton(nButton, bPressed);
 	}
 }
 
 
-void Gui::MouseScrolls(SRPWindow *pSRPWindow, Control &cControl)
+void Gui::MouseScrolls(SRPWindow *pSRPWindow, const float &fDelta)
 {
 	if (pSRPWindow)
 	{
 		if (pSRPWindow->GetData()->bIsVisable && pSRPWindow->GetData()->bMouseEnabled)
 		{
-			if (cControl.GetType() == ControlAxis)
-			{
-				if (cControl.GetName() == "MouseWheel")
-				{
-					// if all of the above is true, send mouse scroll
-					pSRPWindow->GetBerkeliumWindow()->mouseWheel(0, int(static_cast<Axis&>(cControl).GetValue()));
-				}
-			}
+			// if all of the above is true, send mouse scroll
+			pSRPWindow->GetBerkeliumWindow()->mouseWheel(0, int(fDelta));
 		}
 	}
 }
@@ -705,56 +895,11 @@ void Gui::MouseScrolls(SRPWindow *pSRPWindow, Control &cControl)
 
 void Gui::OnControl(Control &cControl)
 {
+	// controls that were not resolved are neither mouse nor keyboard controls
+	const sControlInfo *psInfo = m_pControlTable->Get(cControl);
+	if (psInfo && m_cControlHandlers[psInfo->nKind])
 	{
-		//undone: [10-07-2012 Icefire] filter out anything but mouse events
-		MouseEvents(cControl);
-	}
-
-	{
-		//undone: [10-07-2012 Icefire] filter out anything but keyboard events
-		KeyboardEvents(cControl);
-	}
-}
-
-
-SRPWindow *Gui::GetTopMostWindow(List<SRPWindow*> *plstWindows)
-{
-	if (plstWindows)
-	{
-		if (plstWindows->GetNumOfElements() == 1)
-		{
-			// if the list has only one item return it
-			return plstWindows->Get(0);
-		}
-		else
-		{
-			// prepare for the current topmost window
-			SRPWindow *pTopMostWindow = nullptr;
-
-			int nHigherIndex = -1;
-
-			// get the iterator for the windows in the list
-			Iterator<SRPWindow*> cIterator = plstWindows->GetIterator();
-			// loop trough the windows
-			while (cIterator.HasNext())
-			{
-				SRPWindow *pSRPWindow = cIterator.Next();
-				if (pSRPWindow->GetSceneRenderPassIndex() > nHigherIndex)
-				{
-					// if the window is top most, keep it
-					nHigherIndex = pSRPWindow->GetSceneRenderPassIndex();
-					pTopMostWindow = pSRPWindow;
-				}
-			}
-
-			// return the top most window, can be a nullptr
-			return pTopMostWindow;
-		}
-	}
-	else
-	{
-		// return nothing
-		return nullptr;
+		(this->*m_cControlHandlers[psInfo->nKind])(cControl, *psInfo);
 	}
 }
 
@@ -794,7 +939,16 @@ void Gui::DefaultCallBackHandler()
 			}
 			else if (pSRPWindow->GetCallBack(HIDEWINDOW))
 			{
-				pSRPWindow->GetData()->bIsVisable = false;
+				// HideWindow(ms) fades the window out first
+				const double fDuration = GetCallBackNumber(pSRPWindow->GetCallBack(HIDEWINDOW), 0, 0.0);
+				if (fDuration > 0.0)
+				{
+					SetWindowVisibleAnimated(pSRPWindow->GetName(), false, uint32(fDuration));
+				}
+				else
+				{
+					pSRPWindow->SetVisible(false);
+				}
 				// call back is processed so we clear them
 				pSRPWindow->RemoveCallBacks();
 			}
@@ -809,70 +963,64 @@ void Gui::DefaultCallBackHandler()
 				// call back is processed so we clear them
 				pSRPWindow->RemoveCallBacks();
 			}
+			else if (pSRPWindow->GetCallBack(FADEWINDOW))
+			{
+				// FadeWindow(opacity, ms)
+				const sCallBack *psCallBack = pSRPWindow->GetCallBack(FADEWINDOW);
+				FadeWindow(pSRPWindow->GetName(), float(GetCallBackNumber(psCallBack, 0, 1.0)), uint32(GetCallBackNumber(psCallBack, 1, DEFAULTANIMATIONTIME)));
+				// call back is processed so we clear them
+				pSRPWindow->RemoveCallBacks();
+			}
+			else if (pSRPWindow->GetCallBack(SLIDEWINDOW))
+			{
+				// SlideWindow(x, y, ms)
+				const sCallBack *psCallBack = pSRPWindow->GetCallBack(SLIDEWINDOW);
+				const Vector2i vPosition = pSRPWindow->GetPosition();
+				SlideWindow(pSRPWindow->GetName(), int(GetCallBackNumber(psCallBack, 0, vPosition.x)), int(GetCallBackNumber(psCallBack, 1, vPosition.y)), uint32(GetCallBackNumber(psCallBack, 2, DEFAULTANIMATIONTIME)));
+				// call back is processed so we clear them
+				pSRPWindow->RemoveCallBacks();
+			}
+			else if (pSRPWindow->GetCallBack(SCALEWINDOW))
+			{
+				// ScaleWindow(scale, ms)
+				const sCallBack *psCallBack = pSRPWindow->GetCallBack(SCALEWINDOW);
+				ScaleWindow(pSRPWindow->GetName(), float(GetCallBackNumber(psCallBack, 0, 1.0)), uint32(GetCallBackNumber(psCallBack, 1, DEFAULTANIMATIONTIME)));
+				// call back is processed so we clear them
+				pSRPWindow->RemoveCallBacks();
+			}
 		}
 	}
 }
 
 
-void Gui::KeyboardEvents(Control &cControl)
+void Gui::KeyboardEvents(Control &cControl, const sControlInfo &sInfo)
 {
-	//hack: [10-07-2012 Icefire] i am not yet satisfied with this method, so expect this to change
+	// get the button class
+	Button &cButton = static_cast<Button&>(cControl);
+	// the keys go to the focused window, without one only the state is kept
+	Berkelium::Window *pWindow = GetKeyboardWindow();
 
-	if (m_pFocusedWindow)
+	if (cButton.IsPressed())
 	{
-		// check if the focused window allows for key events
-		if (m_pFocusedWindow->GetData()->bKeyboardEnabled)
+		// the character is decided with the modifiers held before this key and kept for its repeats
+		const int nModifiers = m_pKeyboardState->GetModifiers();
+		char nText = 0;
+		if (sInfo.nText && !(nModifiers & (Berkelium::CONTROL_MOD | Berkelium::ALT_MOD)))
 		{
-			// check if the event is for the keyboard
-			if (cControl.GetName().GetSubstring(0, 8) == "Keyboard")
-			{
-				// get the button class
-				Button &cButton = reinterpret_cast<Button&>(cControl);
-
-				if (cButton.IsPressed())
-				{
-					sButton *psButton = new sButton;
-
-					if (String(cButton.GetCharacter()).IsAlphaNumeric())
-					{
-						AddTextKey(cButton.GetName(), cButton.GetCharacter(), psButton);
-					}
-					else if (cButton.GetName() == "KeyboardSpace")
-					{
-						AddTextKey(cButton.GetName(), cButton.GetCharacter(), psButton);
-					}
-					else if (cButton.GetName() == "KeyboardBackspace")
-					{
-						AddKey(cButton.GetName(), cButton.GetCharacter(), psButton);
-					}
-					else if (cButton.GetName() == "KeyboardTab")
-					{
-						AddKey(cButton.GetName(), cButton.GetCharacter(), psButton);
-					}
-					else if (cButton.GetName() == "KeyboardReturn")
-					{
-						AddTextKey(cButton.GetName(), cButton.GetCharacter(), psButton);
-					}
-					else
-					{
-						psButton->bValid = false;
-					}
-				}
-				else
-				{
-					if (m_pmapTextButtonHandler->GetNumOfElements() == 1)
-					{
-						m_nTextKeyHitCount = 0;
-					}
-					m_pmapTextButtonHandler->Remove(cButton.GetName());
+			nText = ((nModifiers & Berkelium::SHIFT_MOD) && sInfo.nShiftText) ? sInfo.nShiftText : sInfo.nText;
+		}
 
-					if (m_pmapKeyButtonHandler->GetNumOfElements() == 1)
-					{
-						m_nKeyHitCount = 0;
-					}
-					m_pmapKeyButtonHandler->Remove(cButton.GetName());
-				}
-			}
+		if (m_pKeyboardState->Press(sInfo.nCode, sInfo.nModifier, nText, sInfo.bKeypad, Timing::GetInstance()->GetPastTime()) && pWindow)
+		{
+			SendKey(pWindow, sInfo.nCode, false);
+		}
+	}
+	else
+	{
+		if (m_pKeyboardState->Release(sInfo.nCode) && pWindow)
+		{
+			// the modifier of a released modifier key is not held anymore
+			pWindow->keyEvent(false, m_pKeyboardState->GetModifiers() | (sInfo.bKeypad ? Berkelium::KEYPAD_KEY : 0), sInfo.nCode, 0);
 		}
 	}
 }
@@ -899,13 +1047,129 @@ bool Gui::SetWindowVisible(const String &sName, const bool &bVisible)
 			UnFocusAllWindows();
 		}
 
-		// set the visibility of the window
-		m_pmapWindows->Get(sName)->GetData()->bIsVisable = bVisible;
+		// set the visibility of the window, a window that is shown again resyncs its texture
+		m_pmapWindows->Get(sName)->SetVisible(bVisible);
 		return true;
 	}
 }
 
 
+bool Gui::SetWindowClickThrough(const String &sName, const bool &bClickThrough)
+{
+	if (sName == BERKELIUMDUMMYWINDOW)
+	{
+		// we should not do this on the dummy window
+		return false;
+	}
+	SRPWindow *pSRPWindow = m_pmapWindows->Get(sName);
+	if (!pSRPWindow)
+	{
+		// we cannot find the window
+		return false;
+	}
+
+	// the hit test index takes the mask with its next rebuild
+	pSRPWindow->SetClickThrough(bClickThrough);
+	return true;
+}
+
+
+void Gui::SetKeyRepeat(const uint32 &nDelay, const uint32 &nInterval)
+{
+	m_pKeyboardState->SetRepeat(nDelay, nInterval);
+}
+
+
+SRPWindow *Gui::GetAnimatableWindow(const String &sName)
+{
+	if (sName == BERKELIUMDUMMYWINDOW)
+	{
+		// we should not do this on the dummy window
+		return nullptr;
+	}
+	// a null pointer if the window cannot be found
+	return m_pmapWindows->Get(sName);
+}
+
+
+double Gui::GetCallBackNumber(const sCallBack *psCallBack, const uint32 &nIndex, const double &fDefault)
+{
+	return (psCallBack && nIndex < psCallBack->nNumOfNumbers) ? psCallBack->fNumbers[nIndex] : fDefault;
+}
+
+
+bool Gui::SetWindowVisibleAnimated(const String &sName, const bool &bVisible, const uint32 &nDuration)
+{
+	SRPWindow *pSRPWindow = GetAnimatableWindow(sName);
+	if (!pSRPWindow)
+	{
+		return false;
+	}
+
+	if (bVisible)
+	{
+		// a hidden window fades in from nothing, one that is fading out fades back in from where it is
+		if (!pSRPWindow->GetData()->bIsVisable)
+		{
+			pSRPWindow->GetData()->fOpacity = 0.0f;
+			pSRPWindow->SetVisible(true);
+		}
+		m_pWindowAnimator->Animate(pSRPWindow, TweenOpacity, Vector2(1.0f, 0.0f), nDuration);
+	}
+	else if (pSRPWindow->GetData()->bIsVisable)
+	{
+		// unfocus the window right away, it is hidden when it faded out
+		if (pSRPWindow == m_pFocusedWindow)
+		{
+			UnFocusAllWindows();
+		}
+		m_pWindowAnimator->Animate(pSRPWindow, TweenOpacity, Vector2::Zero, nDuration, EasingSmooth, true);
+	}
+	return true;
+}
+
+
+bool Gui::FadeWindow(const String &sName, const float &fOpacity, const uint32 &nDuration)
+{
+	SRPWindow *pSRPWindow = GetAnimatableWindow(sName);
+	if (!pSRPWindow)
+	{
+		return false;
+	}
+	m_pWindowAnimator->Animate(pSRPWindow, TweenOpacity, Vector2(fOpacity, 0.0f), nDuration);
+	return true;
+}
+
+
+bool Gui::SlideWindow(const String &sName, const int &nX, const int &nY, const uint32 &nDuration)
+{
+	SRPWindow *pSRPWindow = GetAnimatableWindow(sName);
+	if (!pSRPWindow)
+	{
+		return false;
+	}
+
+	// the window moves right away, the translation starts where the window is drawn now and slides back to zero
+	const Vector2i vPosition = pSRPWindow->GetPosition();
+	pSRPWindow->MoveWindow(nX, nY);
+	pSRPWindow->GetData()->vTranslation += Vector2(float(vPosition.x - nX), float(vPosition.y - nY));
+	m_pWindowAnimator->Animate(pSRPWindow, TweenTranslation, Vector2::Zero, nDuration, EasingOut);
+	return true;
+}
+
+
+bool Gui::ScaleWindow(const String &sName, const float &fScale, const uint32 &nDuration)
+{
+	SRPWindow *pSRPWindow = GetAnimatableWindow(sName);
+	if (!pSRPWindow)
+	{
+		return false;
+	}
+	m_pWindowAnimator->Animate(pSRPWindow, TweenScale, Vector2(fScale, 0.0f), nDuration);
+	return true;
+}
+
+
 void Gui::DragWindowHandler()
 {
 	if (m_pDragWindow)
@@ -921,7 +1185,7 @@ void Gui::DragWindowHandler()
 					//undone: [10-07-2012 Icefire] deprecate
 					m_pDragWindow->SetToolTip("");
 					// we need to lock the mouse position relative to the dragging window
-					m_vLockMousePos = m_pDragWindow->GetRelativeMousePosition(m_vLastKnownMousePos);
+					m_vLockMousePos = m_pDragWindow->GetRelativeMousePositionOnScreen(m_vLastKnownMousePos);
 				}
 				// we move the window
 				m_pDragWindow->MoveWindow(m_vLastKnownMousePos.x - m_vLockMousePos.x, m_vLastKnownMousePos.y - m_vLockMousePos.y);
@@ -941,113 +1205,43 @@ void Gui::DragWindowHandler()
 
 void Gui::KeyboardHandler()
 {
-	//hack: [10-07-2012 Icefire] i am not yet satisfied with this method, so expect this to change
-
-	if (m_pFocusedWindow)
+	// the repeats come due whether or not a window takes them
+	const uint32 nNumOfRepeats = m_pKeyboardState->Update(Timing::GetInstance()->GetPastTime());
+	if (nNumOfRepeats)
 	{
-		if (m_pFocusedWindow->GetData()->bKeyboardEnabled)
+		Berkelium::Window *pWindow = GetKeyboardWindow();
+		if (pWindow)
 		{
-			if (m_pmapTextButtonHandler->GetNumOfElements() > 0)
+			for (uint32 i = 0; i < nNumOfRepeats; i++)
 			{
-				Iterator<sButton*> cIterator = m_pmapTextButtonHandler->GetIterator();
-				while (cIterator.HasNext())
-				{
-					sButton *psButton = cIterator.Next();
-					if (psButton->bValid)
-					{
-						if (m_nTextKeyHitCount == 0)
-						{
-							m_pFocusedWindow->GetBerkeliumWindow()->textEvent(psButton->sKey.GetUnicode(), psButton->sKey.GetLength());
-							m_nLastTextKeySendTime = Timing::GetInstance()->GetPastTime();
-							m_nTextKeyHitCount++;
-						}
-						else
-						{
-							if (m_nTextKeyHitCount == 1)
-							{
-								if ((Timing::GetInstance()->GetPastTime() - m_nLastTextKeySendTime) > 400)
-								{
-									m_pFocusedWindow->GetBerkeliumWindow()->textEvent(psButton->sKey.GetUnicode(), psButton->sKey.GetLength());
-									m_nLastTextKeySendTime = Timing::GetInstance()->GetPastTime();
-									m_nTextKeyHitCount++;
-								}
-							}
-							else
-							{
-								if ((Timing::GetInstance()->GetPastTime() - m_nLastTextKeySendTime) > 50)
-								{
-									m_pFocusedWindow->GetBerkeliumWindow()->textEvent(psButton->sKey.GetUnicode(), psButton->sKey.GetLength());
-									m_nLastTextKeySendTime = Timing::GetInstance()->GetPastTime();
-									m_nTextKeyHitCount++;
-								}
-							}
-						}
-					}
-				}
-			}
-			if (m_pmapKeyButtonHandler->GetNumOfElements() > 0)
-			{
-				Iterator<sButton*> cIterator = m_pmapKeyButtonHandler->GetIterator();
-				while (cIterator.HasNext())
-				{
-					sButton *psButton = cIterator.Next();
-					if (psButton->bValid)
-					{
-						if (m_nKeyHitCount == 0)
-						{
-							m_pFocusedWindow->GetBerkeliumWindow()->keyEvent(true, 0, psButton->nKey, 0);
-							m_nLastKeySendTime = Timing::GetInstance()->GetPastTime();
-							m_nKeyHitCount++;
-						}
-						else
-						{
-							if (m_nKeyHitCount == 1)
-							{
-								if ((Timing::GetInstance()->GetPastTime() - m_nLastKeySendTime) > 400)
-								{
-									m_pFocusedWindow->GetBerkeliumWindow()->keyEvent(true, 0, psButton->nKey, 0);
-									m_nLastKeySendTime = Timing::GetInstance()->GetPastTime();
-									m_nKeyHitCount++;
-								}
-							}
-							else
-							{
-								if ((Timing::GetInstance()->GetPastTime() - m_nLastKeySendTime) > 50)
-								{
-									m_pFocusedWindow->GetBerkeliumWindow()->keyEvent(true, 0, psButton->nKey, 0);
-									m_nLastKeySendTime = Timing::GetInstance()->GetPastTime();
-									m_nKeyHitCount++;
-								}
-							}
-						}
-					}
-				}
+				SendKey(pWindow, m_pKeyboardState->GetRepeat(i), true);
 			}
 		}
 	}
 }
 
 
-void Gui::AddTextKey(const String &sName, const String &sKey, sButton *psButton)
+Berkelium::Window *Gui::GetKeyboardWindow() const
 {
-	//hack: [10-07-2012 Icefire] i am not yet satisfied with this method
-
-	m_pmapTextButtonHandler->Clear();
-	psButton->bValid = true;
-	psButton->sKey = sKey;
-	m_pmapTextButtonHandler->Add(sName, psButton);
-	m_nTextKeyHitCount = 0;
+	if (m_pFocusedWindow && m_pFocusedWindow->GetData()->bKeyboardEnabled)
+	{
+		return m_pFocusedWindow->GetBerkeliumWindow();
+	}
+	return nullptr;
 }
 
 
-void Gui::AddKey(const PLCore::String &sName, const char &nKey, sButton *psButton)
+void Gui::SendKey(Berkelium::Window *pWindow, const int &nCode, const bool &bRepeat) const
 {
-	//hack: [10-07-2012 Icefire] i am not yet satisfied with this method
+	const sKeyState &sKey = m_pKeyboardState->GetKey(nCode);
 
-	psButton->bValid = true;
-	psButton->nKey = nKey;
-	m_pmapKeyButtonHandler->Add(sName, psButton);
-	m_nKeyHitCount = 0;
+	// a key down first, then the character like a native keyboard sends it
+	pWindow->keyEvent(true, m_pKeyboardState->GetModifiers() | (sKey.bKeypad ? Berkelium::KEYPAD_KEY : 0) | (bRepeat ? Berkelium::AUTOREPEAT_KEY : 0), nCode, 0);
+	if (sKey.nText)
+	{
+		const wchar_t szText[2] = { wchar_t(uint8(sKey.nText)), 0 };
+		pWindow->textEvent(szText, 1);
+	}
 }
 
 
@@ -1066,6 +1260,7 @@ void Gui::DebugNamesOfWindows()
 				DebugToConsole("Window name: '" + pSRPWindow->GetName() + "'\n");
 				DebugToConsole("\t- Visible?: " + String(pSRPWindow->GetData()->bIsVisable ? "True" : "False") + "\n");
 				DebugToConsole("\t- Size: " + pSRPWindow->GetSize().ToString() + "\n");
+				DebugToConsole("\t- Render size: " + pSRPWindow->GetRenderSize().ToString() + " (scale " + String(pSRPWindow->GetRenderScale()) + ")\n");
 				DebugToConsole("\t- Position: " + pSRPWindow->GetPosition().ToString() + "\n");
 				DebugToConsole("\t- Loaded?: " + String(pSRPWindow->GetData()->bLoaded ? "True" : "False") + "\n\n");
 			}
@@ -1074,6 +1269,82 @@ void Gui::DebugNamesOfWindows()
 }
 
 
+void Gui::DebugStatsOfWindows(const bool &bReset)
+{
+	uint32 nPaints = 0;
+	uint32 nPaintsMerged = 0;
+	uint32 nUploads = 0;
+	sUploadStats sTotal = { 0, 0, 0, 0, 0, 0 };
+
+	Iterator<SRPWindow*> cIterator = m_pmapWindows->GetIterator();
+	while (cIterator.HasNext())
+	{
+		SRPWindow *pSRPWindow = cIterator.Next();
+		if (pSRPWindow->GetName() != BERKELIUMDUMMYWINDOW)
+		{
+			const sWindowStats &sStats = pSRPWindow->GetStats();
+			DebugToConsole("Window name: '" + pSRPWindow->GetName() + "'\n");
+			DebugToConsole("\t- Paints: " + String(sStats.nPaints) + " (merged: " + String(sStats.nPaintsMerged) + ")\n");
+			DebugToConsole("\t- Uploads: " + String(sStats.nUploads) + "\n");
+			DebugToConsole("\t- Paints while hidden: " + String(sStats.nPaintsHidden) + " (resyncs on show: " + String(sStats.nResyncs) + ")\n");
+			DebugToConsole("\t- Resizes: " + String(sStats.nResizes) + " (previewed steps: " + String(sStats.nResizePreviews) + ")\n");
+			const sUploadStats &sUpload = pSRPWindow->GetUploadStats();
+			DebugToConsole("\t- Straight uploads: " + String(sUpload.nUploads) + ", " + String(sUpload.nUploadedBytes / 1024) + " KiB in " + String(sUpload.nUploadTime) + " us\n");
+			DebugToConsole("\t- Pixel buffer uploads (" + String(pSRPWindow->GetData()->nNumOfPixelBuffers) + " buffers): " + String(sUpload.nPixelBufferUploads) + ", " + String(sUpload.nPixelBufferBytes / 1024) + " KiB in " + String(sUpload.nPixelBufferTime) + " us\n");
+			nPaints += sStats.nPaints;
+			nPaintsMerged += sStats.nPaintsMerged;
+			nUploads += sStats.nUploads;
+			sTotal.nUploads += sUpload.nUploads;
+			sTotal.nUploadedBytes += sUpload.nUploadedBytes;
+			sTotal.nUploadTime += sUpload.nUploadTime;
+			sTotal.nPixelBufferUploads += sUpload.nPixelBufferUploads;
+			sTotal.nPixelBufferBytes += sUpload.nPixelBufferBytes;
+			sTotal.nPixelBufferTime += sUpload.nPixelBufferTime;
+			if (bReset)
+			{
+				pSRPWindow->ResetStats();
+			}
+		}
+	}
+
+	DebugToConsole("All windows: " + String(nPaints) + " paints, " + String(nPaintsMerged) + " merged, " + String(nUploads) + " uploads\n");
+	DebugToConsole("Copy workers: " + String(m_pCopyWorkerPool->GetNumOfWorkers()) + ", " + String(m_pCopyWorkerPool->GetNumOfSharedCopies()) + " shared copies, last frame copy time " + String(m_pCopyWorkerPool->GetLastFrameCopyTime()) + " us\n");
+	DebugToConsole("Last frame stages: update " + String(m_sFrameStages.nUpdateTime) + " us, handlers " + String(m_sFrameStages.nHandlerTime) + " us, upload " + String(m_sFrameStages.nUploadTime) + " us\n");
+	const sSurfacePoolStats &sPool = m_pSurfacePool->GetStats();
+	DebugToConsole("Surface pool: " + String(sPool.nCreated) + " created, " + String(sPool.nReused) + " reused, " + String(sPool.nDestroyed) + " destroyed, " + String(m_pSurfacePool->GetNumOfFreeTextures()) + " free (" + String(m_pSurfacePool->GetFreeBytes() / 1024) + " KiB)\n");
+	const sProgramCacheStats &sPrograms = m_pProgramCache->GetStats();
+	DebugToConsole("Program cache: " + String(m_pProgramCache->GetNumOfPrograms()) + " programs, " + String(sPrograms.nCompiled) + " compiled, " + String(sPrograms.nReused) + " reused\n");
+	const sWindowAnimatorStats &sAnimator = m_pWindowAnimator->GetStats();
+	DebugToConsole("Window animator: " + String(m_pWindowAnimator->GetNumOfTweens()) + " running, " + String(sAnimator.nStarted) + " started, " + String(sAnimator.nFinished) + " finished, " + String(sAnimator.nInterrupted) + " interrupted, " + String(sAnimator.nSkipped) + " skipped\n");
+	const sHitTestIndexStats &sHitTest = m_pHitTestIndex->GetStats();
+	DebugToConsole("Hit test index: " + String(m_pHitTestIndex->GetNumOfRects()) + " rects, " + String(sHitTest.nQueries) + " hit tests, " + String(sHitTest.nRebuilds) + " rebuilds\n");
+	DebugToConsole("Control table: " + String(m_pControlTable->GetNumOfBindings()) + " controls resolved\n");
+	const sKeyboardStateStats &sKeyboard = m_pKeyboardState->GetStats();
+	DebugToConsole("Keyboard state: " + String(m_pKeyboardState->GetNumOfHeldKeys()) + " held, " + String(sKeyboard.nPresses) + " presses, " + String(sKeyboard.nRepeats) + " repeats, " + String(sKeyboard.nVisits) + " keys visited\n");
+	const sInputQueueStats &sInput = m_pInputQueue->GetStats();
+	DebugToConsole("Input queue: " + String(sInput.nReceived) + " received, " + String(sInput.nQueued) + " queued, " + String(sInput.nForwarded) + " forwarded, " + String(sInput.nOverflows) + " overflows\n");
+	if (m_pCompositor)
+	{
+		const sCompositorStats &sCompositor = m_pCompositor->GetStats();
+		DebugToConsole("Compositor: " + String(m_pCompositor->GetNumOfWindows()) + " windows, last frame " + String(sCompositor.nQuads) + " quads (" + String(sCompositor.nOpaque) + " opaque, " + String(sCompositor.nCulled) + " culled) in " + String(sCompositor.nDrawCalls) + " draw calls, " + String(sCompositor.nProgramChanges) + " program and " + String(sCompositor.nTextureChanges) + " texture changes\n");
+		if (m_pCompositor->IsCached())
+		{
+			const sCompositeCacheStats &sCache = m_pCompositor->GetCacheStats();
+			DebugToConsole("Composite cache: " + String(sCache.nRecomposites) + " recomposites, " + String(sCache.nPresents) + " presents, dirty by " + String(sCache.nDirtyReasons[CompositeDirtyUpload]) + " uploads, " + String(sCache.nDirtyReasons[CompositeDirtyMove]) + " moves, " + String(sCache.nDirtyReasons[CompositeDirtyOrder]) + " z-order changes, " + String(sCache.nDirtyReasons[CompositeDirtyVisibility]) + " visibility changes, " + String(sCache.nDirtyReasons[CompositeDirtyViewport]) + " viewport changes, " + String(sCache.nDirtyReasons[CompositeDirtyInvalidated]) + " invalidations\n");
+		}
+	}
+
+	// the render thread time per MiB of both paths, the difference is the stall time the pixel buffers avoid
+	if (sTotal.nUploadedBytes > 0 && sTotal.nPixelBufferBytes > 0)
+	{
+		const double fStraight = double(sTotal.nUploadTime) * 1048576.0 / double(sTotal.nUploadedBytes);
+		const double fPixelBuffer = double(sTotal.nPixelBufferTime) * 1048576.0 / double(sTotal.nPixelBufferBytes);
+		const double fAvoided = (fStraight > fPixelBuffer) ? (fStraight - fPixelBuffer) * double(sTotal.nPixelBufferBytes) / 1048576.0 : 0.0;
+		DebugToConsole("Render thread time per MiB: " + String(uint32(fStraight)) + " us straight, " + String(uint32(fPixelBuffer)) + " us through pixel buffers, " + String(uint32(fAvoided)) + " us avoided\n");
+	}
+}
+
+
 void Gui::ResizeWindowHandler()
 {
 	//todo: [06-07-2012 Icefire] this resizing handler works for now, however the way we resize the buffer now is still not acceptable.
@@ -1092,27 +1363,27 @@ void Gui::ResizeWindowHandler()
 					//undone: [10-07-2012 Icefire] deprecate
 					m_pResizeWindow->SetToolTip("");
 					// we need to lock the mouse position relative to the resizing window
-					m_vLockMousePos = m_pResizeWindow->GetRelativeMousePosition(m_vLastKnownMousePos);
+					m_vLockMousePos = m_pResizeWindow->GetRelativeMousePositionOnScreen(m_vLastKnownMousePos);
 				}
 
-				if (m_vLockMousePos.x == (m_pResizeWindow->GetRelativeMousePosition(m_vLastKnownMousePos)).x &&
-					m_vLockMousePos.y == (m_pResizeWindow->GetRelativeMousePosition(m_vLastKnownMousePos)).y)
+				if (m_vLockMousePos.x == (m_pResizeWindow->GetRelativeMousePositionOnScreen(m_vLastKnownMousePos)).x &&
+					m_vLockMousePos.y == (m_pResizeWindow->GetRelativeMousePositionOnScreen(m_vLastKnownMousePos)).y)
 				{
 					// locked mouse has not moved so we do nothing
 				}
-				else if (m_vLockMousePos.x <= m_pResizeWindow->GetRelativeMousePosition(m_vLastKnownMousePos).x &&
-					m_vLockMousePos.y <= m_pResizeWindow->GetRelativeMousePosition(m_vLastKnownMousePos).y)
+				else if (m_vLockMousePos.x <= m_pResizeWindow->GetRelativeMousePositionOnScreen(m_vLastKnownMousePos).x &&
+					m_vLockMousePos.y <= m_pResizeWindow->GetRelativeMousePositionOnScreen(m_vLastKnownMousePos).y)
 				{
 					// we should make the window bigger
-					Vector2i vNewSize = m_pResizeWindow->GetSize() - (m_vLockMousePos - m_pResizeWindow->GetRelativeMousePosition(m_vLastKnownMousePos));
+					Vector2i vNewSize = m_pResizeWindow->GetSize() - (m_vLockMousePos - m_pResizeWindow->GetRelativeMousePositionOnScreen(m_vLastKnownMousePos));
 					// check if the new size difference is bigger than 1px in any direction so to not call to many resize updates
 					if ((vNewSize - m_pResizeWindow->GetSize()).x > 1 || (vNewSize - m_pResizeWindow->GetSize()).y > 1)
 					{
 						// check if new window size is at least 4 x 4 pixels, if you need smaller windows than that you should switch your field to nanotechnology
 						if (vNewSize.x >= 4 && vNewSize.y >= 4)
 						{
-							// we resize the window
-							m_pResizeWindow->ResizeWindow(vNewSize.x, vNewSize.y);
+							// we preview the new size, the page follows when the mouse rests or is released
+							m_pResizeWindow->PreviewResize(vNewSize.x, vNewSize.y);
 							// we should reset the locked mouse position since the window has been resized
 							m_vLockMousePos = Vector2i::Zero;
 						}
@@ -1121,7 +1392,7 @@ void Gui::ResizeWindowHandler()
 				else
 				{
 					// we should make the window smaller
-					Vector2i vNewSize = m_pResizeWindow->GetSize() - (m_vLockMousePos - m_pResizeWindow->GetRelativeMousePosition(m_vLastKnownMousePos));
+					Vector2i vNewSize = m_pResizeWindow->GetSize() - (m_vLockMousePos - m_pResizeWindow->GetRelativeMousePositionOnScreen(m_vLastKnownMousePos));
 					// check if the new size difference is bigger than 2px in any direction so to not call to many resize updates
 					if ((m_pResizeWindow->GetSize() - vNewSize).x > 2 ||
 						(m_pResizeWindow->GetSize() - vNewSize).y > 2 ||
@@ -1131,8 +1402,8 @@ void Gui::ResizeWindowHandler()
 						// check if new window size is at least 4 x 4 pixels, if you need smaller windows than that you should switch your field to nanotechnology
 						if (vNewSize.x >= 4 && vNewSize.y >= 4)
 						{
-							// we resize the window
-							m_pResizeWindow->ResizeWindow(vNewSize.x, vNewSize.y);
+							// we preview the new size, the page follows when the mouse rests or is released
+							m_pResizeWindow->PreviewResize(vNewSize.x, vNewSize.y);
 							// we should reset the locked mouse position since the window has been resized
 							m_vLockMousePos = Vector2i::Zero;
 						}
@@ -1142,9 +1413,14 @@ void Gui::ResizeWindowHandler()
 				// after its all done we reset the mouse moved status so that we do not keep doing this repeatedly
 				m_bMouseMoved = false;
 			}
+
+			// resize the page once the mouse rests
+			m_pResizeWindow->UpdateResize();
 		}
 		else
 		{
+			// the drag is over, the page gets the final size
+			m_pResizeWindow->CommitResize();
 			// the left mouse is not pressed anymore so we can reset the following
 			m_vLockMousePos = Vector2i::Zero;
 			m_pResizeWindow = nullptr;
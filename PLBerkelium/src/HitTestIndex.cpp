@@ -0,0 +1,130 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/HitTestIndex.h"
+#include "PLBerkelium/AlphaMask.h"
+
+#include <PLCore/Core/MemoryManager.h>
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLMath;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+HitTestIndex::HitTestIndex() :
+	m_psRects(new sHitTestRect[MINHITTESTRECTS]),
+	m_nNumOfRects(0),
+	m_nMaxRects(MINHITTESTRECTS),
+	m_bDirty(true)
+{
+	MemoryManager::Set(&m_sStats, 0, sizeof(sHitTestIndexStats));
+}
+
+
+HitTestIndex::~HitTestIndex()
+{
+	// the windows are not owned
+	delete [] m_psRects;
+}
+
+
+void HitTestIndex::Invalidate()
+{
+	m_bDirty = true;
+}
+
+
+bool HitTestIndex::IsDirty() const
+{
+	return m_bDirty;
+}
+
+
+void HitTestIndex::Clear()
+{
+	m_nNumOfRects = 0;
+	m_bDirty = false;
+	m_sStats.nRebuilds++;
+}
+
+
+void HitTestIndex::Add(void *pKey, const int &nZ, const int &nX, const int &nY, const int &nWidth, const int &nHeight, const AlphaMask *pAlphaMask, const float &fMaskScale)
+{
+	if (nWidth <= 0 || nHeight <= 0)
+	{
+		return;
+	}
+
+	if (m_nNumOfRects == m_nMaxRects)
+	{
+		// only a rebuild grows the array, hit tests never allocate
+		sHitTestRect *psRects = new sHitTestRect[m_nMaxRects*2];
+		MemoryManager::Copy(psRects, m_psRects, sizeof(sHitTestRect)*m_nNumOfRects);
+		delete [] m_psRects;
+		m_psRects = psRects;
+		m_nMaxRects *= 2;
+	}
+
+	// front last, in front of all rects of the same or a lower z-order, so adding back to front never moves a rect
+	uint32 nIndex = m_nNumOfRects;
+	while (nIndex > 0 && m_psRects[nIndex - 1].nZ > nZ)
+	{
+		m_psRects[nIndex] = m_psRects[nIndex - 1];
+		nIndex--;
+	}
+
+	sHitTestRect &sRect = m_psRects[nIndex];
+	sRect.pKey = pKey;
+	sRect.nZ = nZ;
+	sRect.nLeft = nX;
+	sRect.nTop = nY;
+	sRect.nRight = nX + nWidth;
+	sRect.nBottom = nY + nHeight;
+	sRect.pAlphaMask = pAlphaMask;
+	sRect.fMaskScale = fMaskScale;
+	m_nNumOfRects++;
+}
+
+
+void *HitTestIndex::Get(const Vector2i &vPosition)
+{
+	m_sStats.nQueries++;
+
+	// walk front to back, the first hit is the top most
+	for (uint32 i = m_nNumOfRects; i > 0; i--)
+	{
+		const sHitTestRect &sRect = m_psRects[i - 1];
+		if (vPosition.x > sRect.nLeft && vPosition.y > sRect.nTop && vPosition.x < sRect.nRight && vPosition.y < sRect.nBottom)
+		{
+			// a transparent pixel lets the mouse through to the rects behind
+			if (!sRect.pAlphaMask || sRect.pAlphaMask->IsHit(int(float(vPosition.x - sRect.nLeft)*sRect.fMaskScale), int(float(vPosition.y - sRect.nTop)*sRect.fMaskScale)))
+			{
+				return sRect.pKey;
+			}
+		}
+	}
+	return nullptr;
+}
+
+
+uint32 HitTestIndex::GetNumOfRects() const
+{
+	return m_nNumOfRects;
+}
+
+
+const sHitTestIndexStats &HitTestIndex::GetStats() const
+{
+	return m_sStats;
+}
+
+
+};
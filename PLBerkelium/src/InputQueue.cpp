@@ -0,0 +1,149 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/InputQueue.h"
+
+#include <PLCore/Core/MemoryManager.h>
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLMath;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+InputQueue::InputQueue() :
+	m_nNumOfEvents(0)
+{
+	MemoryManager::Set(&m_sStats, 0, sizeof(sInputQueueStats));
+}
+
+
+InputQueue::~InputQueue()
+{
+}
+
+
+void InputQueue::Receive()
+{
+	m_sStats.nReceived++;
+}
+
+
+bool InputQueue::AddMove(const Vector2i &vPosition, const uint64 &nTime)
+{
+	if (m_nNumOfEvents && m_sEvents[m_nNumOfEvents - 1].nType == InputMouseMove)
+	{
+		// only the last position of consecutive moves matters
+		m_sEvents[m_nNumOfEvents - 1].vPosition = vPosition;
+		m_sEvents[m_nNumOfEvents - 1].nTime = nTime;
+		return true;
+	}
+
+	sInputEvent sEvent;
+	sEvent.nType = InputMouseMove;
+	sEvent.vPosition = vPosition;
+	sEvent.nButton = 0;
+	sEvent.bPressed = false;
+	sEvent.fWheelDelta = 0.0f;
+	sEvent.nTime = nTime;
+	return Append(sEvent);
+}
+
+
+bool InputQueue::AddButton(const Vector2i &vPosition, const int &nButton, const bool &bPressed, const uint64 &nTime)
+{
+	// the order of presses and releases is kept, a click within one update stays a click
+	sInputEvent sEvent;
+	sEvent.nType = InputMouseButton;
+	sEvent.vPosition = vPosition;
+	sEvent.nButton = nButton;
+	sEvent.bPressed = bPressed;
+	sEvent.fWheelDelta = 0.0f;
+	sEvent.nTime = nTime;
+	return Append(sEvent);
+}
+
+
+bool InputQueue::AddWheel(const Vector2i &vPosition, const float &fDelta, const uint64 &nTime)
+{
+	// add up with the wheel turn right before at the same position, after a move or a button the turn may go to
+	// another window
+	if (m_nNumOfEvents)
+	{
+		sInputEvent &sLastEvent = m_sEvents[m_nNumOfEvents - 1];
+		if (sLastEvent.nType == InputMouseWheel && sLastEvent.vPosition == vPosition)
+		{
+			sLastEvent.fWheelDelta += fDelta;
+			sLastEvent.nTime = nTime;
+			return true;
+		}
+	}
+
+	sInputEvent sEvent;
+	sEvent.nType = InputMouseWheel;
+	sEvent.vPosition = vPosition;
+	sEvent.nButton = 0;
+	sEvent.bPressed = false;
+	sEvent.fWheelDelta = fDelta;
+	sEvent.nTime = nTime;
+	return Append(sEvent);
+}
+
+
+uint32 InputQueue::GetNumOfEvents() const
+{
+	return m_nNumOfEvents;
+}
+
+
+const sInputEvent &InputQueue::GetEvent(uint32 nIndex) const
+{
+	return m_sEvents[nIndex];
+}
+
+
+void InputQueue::Clear()
+{
+	m_nNumOfEvents = 0;
+}
+
+
+void InputQueue::AddForwarded(uint32 nNumOfCalls)
+{
+	m_sStats.nForwarded += nNumOfCalls;
+}
+
+
+void InputQueue::AddOverflow()
+{
+	m_sStats.nOverflows++;
+}
+
+
+const sInputQueueStats &InputQueue::GetStats() const
+{
+	return m_sStats;
+}
+
+
+bool InputQueue::Append(const sInputEvent &sEvent)
+{
+	if (m_nNumOfEvents == MAXINPUTEVENTS)
+	{
+		return false;
+	}
+	m_sEvents[m_nNumOfEvents] = sEvent;
+	m_nNumOfEvents++;
+	m_sStats.nQueued++;
+	return true;
+}
+
+
+};
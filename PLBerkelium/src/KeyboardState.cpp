@@ -0,0 +1,303 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/KeyboardState.h"
+
+#include <PLCore/Core/MemoryManager.h>
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+KeyboardState::KeyboardState() :
+	m_nNumOfRepeats(0),
+	m_nNumOfHeldKeys(0),
+	m_nTextRepeatCode(-1),
+	m_nDelay(KEYREPEATDELAY),
+	m_nInterval(KEYREPEATINTERVAL),
+	m_nLastTick(0)
+{
+	for (uint32 i = 0; i < MAXKEYCODES; i++)
+	{
+		m_sKeys[i].bDown = false;
+		m_sKeys[i].bKeypad = false;
+		m_sKeys[i].nText = 0;
+		m_sKeys[i].nModifier = 0;
+		m_sKeys[i].nDueTime = 0;
+		m_sKeys[i].nRepeats = 0;
+		m_sKeys[i].nNext = -1;
+		m_sKeys[i].nPrevious = -1;
+		m_sKeys[i].nSlot = -1;
+	}
+	for (uint32 i = 0; i < KEYREPEATSLOTS; i++)
+	{
+		m_nSlots[i] = -1;
+	}
+	MemoryManager::Set(m_nModifierHolds, 0, sizeof(m_nModifierHolds));
+	MemoryManager::Set(&m_sStats, 0, sizeof(sKeyboardStateStats));
+}
+
+
+KeyboardState::~KeyboardState()
+{
+}
+
+
+void KeyboardState::SetRepeat(const uint32 &nDelay, const uint32 &nInterval)
+{
+	m_nDelay = nDelay;
+	m_nInterval = (nInterval > 0) ? nInterval : 1;
+}
+
+
+uint32 KeyboardState::GetRepeatDelay() const
+{
+	return m_nDelay;
+}
+
+
+uint32 KeyboardState::GetRepeatInterval() const
+{
+	return m_nInterval;
+}
+
+
+bool KeyboardState::Press(const int &nCode, const int &nModifier, const char &nText, const bool &bKeypad, const uint64 &nTime)
+{
+	if (nCode < 0 || nCode >= MAXKEYCODES || m_sKeys[nCode].bDown)
+	{
+		// the native repeat of a held key is no new press
+		return false;
+	}
+
+	sKeyState &sKey = m_sKeys[nCode];
+	sKey.bDown = true;
+	sKey.bKeypad = bKeypad;
+	sKey.nText = nText;
+	sKey.nModifier = nModifier;
+	sKey.nRepeats = 0;
+	m_nNumOfHeldKeys++;
+	m_sStats.nPresses++;
+
+	if (nModifier)
+	{
+		// a modifier is held as long as one of its keys is down
+		for (uint32 i = 0; i < KEYMODIFIERBITS; i++)
+		{
+			if (nModifier & (1 << i))
+			{
+				m_nModifierHolds[i]++;
+			}
+		}
+	}
+	else
+	{
+		if (nText)
+		{
+			// only the last key that types a character repeats
+			if (m_nTextRepeatCode >= 0)
+			{
+				Unschedule(m_nTextRepeatCode);
+			}
+			m_nTextRepeatCode = nCode;
+		}
+		Schedule(nCode, nTime + m_nDelay);
+	}
+	return true;
+}
+
+
+bool KeyboardState::Release(const int &nCode)
+{
+	if (nCode < 0 || nCode >= MAXKEYCODES || !m_sKeys[nCode].bDown)
+	{
+		return false;
+	}
+
+	sKeyState &sKey = m_sKeys[nCode];
+	Unschedule(nCode);
+	if (m_nTextRepeatCode == nCode)
+	{
+		m_nTextRepeatCode = -1;
+	}
+	for (uint32 i = 0; i < KEYMODIFIERBITS; i++)
+	{
+		if (sKey.nModifier & (1 << i))
+		{
+			m_nModifierHolds[i]--;
+		}
+	}
+	sKey.bDown = false;
+	m_nNumOfHeldKeys--;
+	return true;
+}
+
+
+void KeyboardState::StopRepeats()
+{
+	for (uint32 i = 0; i < KEYREPEATSLOTS; i++)
+	{
+		int nCode = m_nSlots[i];
+		while (nCode >= 0)
+		{
+			sKeyState &sKey = m_sKeys[nCode];
+			nCode = sKey.nNext;
+			sKey.nNext = -1;
+			sKey.nPrevious = -1;
+			sKey.nSlot = -1;
+		}
+		m_nSlots[i] = -1;
+	}
+	m_nTextRepeatCode = -1;
+}
+
+
+uint32 KeyboardState::Update(const uint64 &nTime)
+{
+	m_nNumOfRepeats = 0;
+
+	// the slot of the last update is looked at again, its keys may have been due later within the tick
+	const uint64 nTick = nTime / KEYREPEATTICK;
+	const uint64 nFirstTick = (nTick > m_nLastTick) ? m_nLastTick : nTick;
+	uint64 nNumOfTicks = nTick - nFirstTick + 1;
+	if (nNumOfTicks > KEYREPEATSLOTS)
+	{
+		// after a long frame every slot is looked at once
+		nNumOfTicks = KEYREPEATSLOTS;
+	}
+
+	for (uint64 nTickIndex = 0; nTickIndex < nNumOfTicks; nTickIndex++)
+	{
+		int nCode = m_nSlots[(nFirstTick + nTickIndex) & (KEYREPEATSLOTS - 1)];
+		while (nCode >= 0)
+		{
+			sKeyState &sKey = m_sKeys[nCode];
+			const int nNext = sKey.nNext;
+			m_sStats.nVisits++;
+
+			// a slot holds the keys of every revolution of the wheel, only those that are due repeat
+			if (sKey.nDueTime <= nTime)
+			{
+				m_nRepeats[m_nNumOfRepeats] = nCode;
+				m_nNumOfRepeats++;
+				sKey.nRepeats++;
+				m_sStats.nRepeats++;
+
+				// never more than one repeat per update, a long frame does not burst
+				uint64 nDueTime = sKey.nDueTime + m_nInterval;
+				if (nDueTime <= nTime)
+				{
+					nDueTime = nTime + m_nInterval;
+				}
+				Unschedule(nCode);
+				Schedule(nCode, nDueTime);
+			}
+			nCode = nNext;
+		}
+	}
+	if (nTick > m_nLastTick)
+	{
+		m_nLastTick = nTick;
+	}
+
+	return m_nNumOfRepeats;
+}
+
+
+int KeyboardState::GetRepeat(uint32 nIndex) const
+{
+	return m_nRepeats[nIndex];
+}
+
+
+const sKeyState &KeyboardState::GetKey(const int &nCode) const
+{
+	return m_sKeys[nCode];
+}
+
+
+int KeyboardState::GetModifiers() const
+{
+	int nModifiers = 0;
+	for (uint32 i = 0; i < KEYMODIFIERBITS; i++)
+	{
+		if (m_nModifierHolds[i])
+		{
+			nModifiers |= (1 << i);
+		}
+	}
+	return nModifiers;
+}
+
+
+uint32 KeyboardState::GetNumOfHeldKeys() const
+{
+	return m_nNumOfHeldKeys;
+}
+
+
+const sKeyboardStateStats &KeyboardState::GetStats() const
+{
+	return m_sStats;
+}
+
+
+void KeyboardState::Schedule(const int &nCode, const uint64 &nDueTime)
+{
+	sKeyState &sKey = m_sKeys[nCode];
+	sKey.nDueTime = nDueTime;
+
+	// a key due before the last update goes to the slot that is looked at again
+	uint64 nTick = nDueTime / KEYREPEATTICK;
+	if (nTick < m_nLastTick)
+	{
+		nTick = m_nLastTick;
+	}
+	const int nSlot = int(nTick & (KEYREPEATSLOTS - 1));
+
+	sKey.nSlot = nSlot;
+	sKey.nPrevious = -1;
+	sKey.nNext = m_nSlots[nSlot];
+	if (sKey.nNext >= 0)
+	{
+		m_sKeys[sKey.nNext].nPrevious = nCode;
+	}
+	m_nSlots[nSlot] = nCode;
+}
+
+
+void KeyboardState::Unschedule(const int &nCode)
+{
+	sKeyState &sKey = m_sKeys[nCode];
+	if (sKey.nSlot < 0)
+	{
+		return;
+	}
+
+	if (sKey.nPrevious >= 0)
+	{
+		m_sKeys[sKey.nPrevious].nNext = sKey.nNext;
+	}
+	else
+	{
+		m_nSlots[sKey.nSlot] = sKey.nNext;
+	}
+	if (sKey.nNext >= 0)
+	{
+		m_sKeys[sKey.nNext].nPrevious = sKey.nPrevious;
+	}
+	sKey.nNext = -1;
+	sKey.nPrevious = -1;
+	sKey.nSlot = -1;
+}
+
+
+};
@@ -0,0 +1,209 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/ProgramCache.h"
+
+#include <PLCore/Core/MemoryManager.h>
+#include <PLCore/Container/Iterator.h>
+#include <PLRenderer/Renderer/Shader.h>
+#include <PLRenderer/Renderer/ShaderLanguage.h>
+#include <PLRenderer/Renderer/ProgramUniform.h>
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLRenderer;
+using namespace PLMath;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+ProgramCache::ProgramCache()
+{
+	MemoryManager::Set(&m_sStats, 0, sizeof(sProgramCacheStats));
+}
+
+
+ProgramCache::~ProgramCache()
+{
+	// the windows are gone before the cache
+	Clear();
+}
+
+
+ProgramWrapper *ProgramCache::Get(Renderer &cRenderer, EProgramVariant nVariant)
+{
+	// the key is the renderer API and the variant
+	const String sKey = cRenderer.GetAPI() + "#" + String(int(nVariant));
+	sCachedProgram *psProgram = m_mapPrograms.Get(sKey);
+	if (psProgram)
+	{
+		m_sStats.nReused++;
+		return psProgram->pProgramWrapper;
+	}
+
+	// compile and link it once, also when it fails
+	psProgram = new sCachedProgram;
+	psProgram->pVertexShader = nullptr;
+	psProgram->pFragmentShader = nullptr;
+	psProgram->pProgramWrapper = CreateProgram(cRenderer, nVariant, psProgram->pVertexShader, psProgram->pFragmentShader);
+	m_mapPrograms.Add(sKey, psProgram);
+	m_sStats.nCompiled++;
+	return psProgram->pProgramWrapper;
+}
+
+
+VertexBuffer *ProgramCache::GetUnitQuad(Renderer &cRenderer)
+{
+	VertexBuffer *pVertexBuffer = m_mapUnitQuads.Get(cRenderer.GetAPI());
+	if (!pVertexBuffer)
+	{
+		pVertexBuffer = CreateUnitQuad(cRenderer);
+		if (pVertexBuffer)
+		{
+			m_mapUnitQuads.Add(cRenderer.GetAPI(), pVertexBuffer);
+		}
+	}
+	return pVertexBuffer;
+}
+
+
+void ProgramCache::Clear()
+{
+	Iterator<sCachedProgram*> cIterator = m_mapPrograms.GetIterator();
+	while (cIterator.HasNext())
+	{
+		// the program does not take over the shader resource control, so we destroy them ourselves
+		sCachedProgram *psProgram = cIterator.Next();
+		if (nullptr != psProgram->pProgramWrapper)
+		{
+			delete psProgram->pProgramWrapper;
+		}
+		if (nullptr != psProgram->pFragmentShader)
+		{
+			delete psProgram->pFragmentShader;
+		}
+		if (nullptr != psProgram->pVertexShader)
+		{
+			delete psProgram->pVertexShader;
+		}
+		delete psProgram;
+	}
+	m_mapPrograms.Clear();
+
+	Iterator<VertexBuffer*> cUnitQuadIterator = m_mapUnitQuads.GetIterator();
+	while (cUnitQuadIterator.HasNext())
+	{
+		delete cUnitQuadIterator.Next();
+	}
+	m_mapUnitQuads.Clear();
+}
+
+
+uint32 ProgramCache::GetNumOfPrograms() const
+{
+	return m_mapPrograms.GetNumOfElements();
+}
+
+
+const sProgramCacheStats &ProgramCache::GetStats() const
+{
+	return m_sStats;
+}
+
+
+ProgramWrapper *ProgramCache::CreateProgram(Renderer &cRenderer, EProgramVariant nVariant, VertexShader *&pVertexShader, FragmentShader *&pFragmentShader)
+{
+	// declare vertex and fragment shader
+	String sVertexShaderSourceCode;
+	String sFragmentShaderSourceCode;
+	const bool bSwizzle = (nVariant == ProgramVariantSwizzle);
+
+	// account for OpenGL version
+	if (cRenderer.GetAPI() == "OpenGL ES 2.0")
+	{
+		#include "ARGBtoRGBA_GLSL.h"
+		sVertexShaderSourceCode   = "#version 100\n" + sBerkeliumVertexShaderSourceCodeGLSL;
+		sFragmentShaderSourceCode = "#version 100\n" + (bSwizzle ? sBerkeliumFragmentShaderSwizzleSourceCodeGLSL : sBerkeliumFragmentShaderSourceCodeGLSL);
+	}
+	else
+	{
+		#include "ARGBtoRGBA_GLSL.h"
+		sVertexShaderSourceCode   = "#version 110\n" + Shader::RemovePrecisionQualifiersFromGLSL(sBerkeliumVertexShaderSourceCodeGLSL);
+		sFragmentShaderSourceCode = "#version 110\n" + Shader::RemovePrecisionQualifiersFromGLSL(bSwizzle ? sBerkeliumFragmentShaderSwizzleSourceCodeGLSL : sBerkeliumFragmentShaderSourceCodeGLSL);
+	}
+
+	ShaderLanguage *pShaderLanguage = cRenderer.GetShaderLanguage(cRenderer.GetDefaultShaderLanguage());
+	if (!pShaderLanguage)
+	{
+		return nullptr;
+	}
+
+	// create the vertex and fragment shader
+	pVertexShader = pShaderLanguage->CreateVertexShader(sVertexShaderSourceCode, "arbvp1");
+	pFragmentShader = pShaderLanguage->CreateFragmentShader(sFragmentShaderSourceCode, "arbfp1");
+
+	// create the program wrapper
+	return static_cast<ProgramWrapper*>(pShaderLanguage->CreateProgram(pVertexShader, pFragmentShader));
+}
+
+
+VertexBuffer *ProgramCache::CreateUnitQuad(Renderer &cRenderer)
+{
+	// lets create a vertex buffer
+	VertexBuffer *pVertexBuffer = cRenderer.CreateVertexBuffer();
+	if (!pVertexBuffer)
+	{
+		return nullptr;
+	}
+
+	// setup and allocate the vertex buffer, it is written once
+	pVertexBuffer->AddVertexAttribute(VertexBuffer::Position, 0, VertexBuffer::Float2);
+	pVertexBuffer->AddVertexAttribute(VertexBuffer::TexCoord, 0, VertexBuffer::Float2);
+	if (!pVertexBuffer->Allocate(4, Usage::Static) || !pVertexBuffer->Lock(Lock::WriteOnly))
+	{
+		delete pVertexBuffer;
+		return nullptr;
+	}
+
+	// the corners in triangle strip order, the texture coordinate of a corner is its position
+	static const float fCorners[4][2] = { { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 0.0f, 0.0f }, { 1.0f, 0.0f } };
+	for (uint32 i = 0; i < 4; i++)
+	{
+		float *pfVertex = static_cast<float*>(pVertexBuffer->GetData(i, VertexBuffer::Position));
+		pfVertex[0] = fCorners[i][0];
+		pfVertex[1] = fCorners[i][1];
+		pfVertex	= static_cast<float*>(pVertexBuffer->GetData(i, VertexBuffer::TexCoord));
+		pfVertex[0] = fCorners[i][0];
+		pfVertex[1] = fCorners[i][1];
+	}
+
+	// unlock the vertex buffer
+	pVertexBuffer->Unlock();
+	return pVertexBuffer;
+}
+
+
+void ProgramCache::SetQuad(ProgramWrapper &cProgramWrapper, const Vector2 &vPosition, const Vector2 &vSize, const Vector2 &vTextureCoordinateScale, const Vector2 &vTextureCoordinateOffset, const float &fOpacity, const bool &bPremultiply)
+{
+	ProgramUniform *pProgramUniform = cProgramWrapper.GetUniform("QuadRect");
+	if (pProgramUniform)
+		pProgramUniform->Set(vPosition.x, vPosition.y, vSize.x, vSize.y);
+	pProgramUniform = cProgramWrapper.GetUniform("TextureRect");
+	if (pProgramUniform)
+		pProgramUniform->Set(vTextureCoordinateOffset.x, vTextureCoordinateOffset.y, vTextureCoordinateScale.x, vTextureCoordinateScale.y);
+	pProgramUniform = cProgramWrapper.GetUniform("Opacity");
+	if (pProgramUniform)
+		pProgramUniform->Set(fOpacity);
+	pProgramUniform = cProgramWrapper.GetUniform("Premultiply");
+	if (pProgramUniform)
+		pProgramUniform->Set(bPremultiply ? 1.0f : 0.0f);
+}
+
+
+};
@@ -0,0 +1,695 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/SRPCompositor.h"
+#include "PLBerkelium/SRPWindow.h"
+
+#include <PLCore/Core/MemoryManager.h>
+#include <PLMath/Matrix4x4.h>
+#include <PLMath/Rectangle.h>
+#include <PLMath/Vector2i.h>
+#include <PLGraphics/Color/Color4.h>
+#include <PLRenderer/Renderer/ProgramUniform.h>
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLRenderer;
+using namespace PLScene;
+using namespace PLMath;
+using namespace PLGraphics;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ RTTI interface                                        ]
+//[-------------------------------------------------------]
+pl_implement_class(SRPCompositor)
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+SRPCompositor::SRPCompositor(Renderer *pRenderer, SceneRenderer *pSceneRenderer) :
+	m_pCurrentSceneRenderer(pSceneRenderer),
+	m_pCurrentRenderer(pRenderer),
+	m_bInitialized(false),
+	m_lstWindows(),
+	m_pQuads(nullptr),
+	m_nMaxQuads(0),
+	m_nNumOfQuads(0),
+	m_pLastQuads(nullptr),
+	m_nMaxLastQuads(0),
+	m_nNumOfLastQuads(0),
+	m_pVertexBuffer(nullptr),
+	m_pProgramCache(nullptr),
+	m_bDepthOrdered(false),
+	m_bCached(false),
+	m_bPremultiply(false),
+	m_pCacheSurface(nullptr),
+	m_nDirtyReasons(0)
+{
+	for (uint32 i = 0; i < NumOfProgramVariants; i++)
+	{
+		m_pProgramWrappers[i] = nullptr;
+		m_pVertexShaders[i] = nullptr;
+		m_pFragmentShaders[i] = nullptr;
+	}
+	MemoryManager::Set(&m_sStats, 0, sizeof(sCompositorStats));
+	MemoryManager::Set(&m_sCacheStats, 0, sizeof(sCompositeCacheStats));
+
+	// we add the scene render pass, the windows are drawn from within it
+	if (m_pCurrentSceneRenderer && m_pCurrentSceneRenderer->Add(*reinterpret_cast<SceneRendererPass*>(this)))
+	{
+		m_bInitialized = true;
+	}
+}
+
+
+SRPCompositor::~SRPCompositor()
+{
+	// check if the compositor is initialized
+	if (m_bInitialized)
+	{
+		// remove the scene render pass
+		m_pCurrentSceneRenderer->Remove(*reinterpret_cast<SceneRendererPass*>(this));
+	}
+	// cleanup
+	DestroyCache();
+	DestroyProgramWrappers();
+	if (nullptr != m_pQuads)
+	{
+		delete [] m_pQuads;
+	}
+	if (nullptr != m_pLastQuads)
+	{
+		delete [] m_pLastQuads;
+	}
+}
+
+
+void SRPCompositor::DestroyInstance() const
+{
+	// cleanup this instance
+	delete this;
+}
+
+
+bool SRPCompositor::IsInitialized() const
+{
+	return m_bInitialized;
+}
+
+
+void SRPCompositor::DebugToConsole(const String &sString)
+{
+	//undone: [10-07-2012 Icefire] this should be deprecated when not needed anymore
+	System::GetInstance()->GetConsole().Print("PLBerkelium::SRPCompositor - " + sString);
+}
+
+
+bool SRPCompositor::AddWindow(SRPWindow *pSRPWindow)
+{
+	if (!pSRPWindow || m_lstWindows.IsElement(pSRPWindow))
+	{
+		return false;
+	}
+	// new windows are on top
+	m_lstWindows.Add(pSRPWindow);
+	return true;
+}
+
+
+bool SRPCompositor::RemoveWindow(SRPWindow *pSRPWindow)
+{
+	return m_lstWindows.Remove(pSRPWindow);
+}
+
+
+void SRPCompositor::MoveToFront(SRPWindow *pSRPWindow)
+{
+	const int nIndex = m_lstWindows.GetIndex(pSRPWindow);
+	if (nIndex >= 0 && uint32(nIndex) != m_lstWindows.GetNumOfElements() - 1)
+	{
+		m_lstWindows.RemoveAtIndex(nIndex);
+		m_lstWindows.Add(pSRPWindow);
+	}
+}
+
+
+int SRPCompositor::GetIndex(SRPWindow *pSRPWindow) const
+{
+	return m_lstWindows.GetIndex(pSRPWindow);
+}
+
+
+uint32 SRPCompositor::GetNumOfWindows() const
+{
+	return m_lstWindows.GetNumOfElements();
+}
+
+
+SRPWindow *SRPCompositor::GetWindow(uint32 nIndex) const
+{
+	return (nIndex < m_lstWindows.GetNumOfElements()) ? m_lstWindows[nIndex] : nullptr;
+}
+
+
+const sCompositorStats &SRPCompositor::GetStats() const
+{
+	return m_sStats;
+}
+
+
+void SRPCompositor::SetDepthOrdered(const bool &bDepthOrdered)
+{
+	if (m_bDepthOrdered != bDepthOrdered)
+	{
+		// the cache is created again, with or without depth buffer
+		m_bDepthOrdered = bDepthOrdered;
+		DestroyCache();
+	}
+}
+
+
+bool SRPCompositor::IsDepthOrdered() const
+{
+	return m_bDepthOrdered;
+}
+
+
+void SRPCompositor::SetCached(const bool &bCached)
+{
+	if (m_bCached != bCached)
+	{
+		// the cache is created on the next draw, the quads of the last frame are collected from then on
+		m_bCached = bCached;
+		m_nNumOfLastQuads = 0;
+		DestroyCache();
+	}
+}
+
+
+bool SRPCompositor::IsCached() const
+{
+	return m_bCached;
+}
+
+
+void SRPCompositor::Invalidate(const ECompositeDirtyReason &nReason)
+{
+	m_nDirtyReasons |= (1 << nReason);
+}
+
+
+const sCompositeCacheStats &SRPCompositor::GetCacheStats() const
+{
+	return m_sCacheStats;
+}
+
+
+void SRPCompositor::DestroyCache()
+{
+	if (nullptr != m_pCacheSurface)
+	{
+		delete m_pCacheSurface;
+		m_pCacheSurface = nullptr;
+	}
+}
+
+
+void SRPCompositor::SetProgramCache(ProgramCache *pProgramCache)
+{
+	// the programs and the unit quad are taken again on the next draw
+	DestroyProgramWrappers();
+	m_pProgramCache = pProgramCache;
+}
+
+
+void SRPCompositor::Draw(Renderer &cRenderer, const SQCull &cCullQuery)
+{
+	MemoryManager::Set(&m_sStats, 0, sizeof(sCompositorStats));
+
+	if (m_bCached)
+	{
+		// the quads of the last frame tell whether the cache is outdated
+		sCompositorQuad *pQuads = m_pLastQuads;
+		m_pLastQuads = m_pQuads;
+		m_pQuads = pQuads;
+		const uint32 nMaxQuads = m_nMaxLastQuads;
+		m_nMaxLastQuads = m_nMaxQuads;
+		m_nMaxQuads = nMaxQuads;
+		m_nNumOfLastQuads = m_nNumOfQuads;
+	}
+
+	// collect the quads back to front, the Gui uploaded the windows already, this only catches paints that came in since
+	m_nNumOfQuads = 0;
+	for (uint32 i = 0; i < m_lstWindows.GetNumOfElements(); i++)
+		AddWindowQuads(m_lstWindows[i]);
+	if (!m_nNumOfQuads || !GetUnitQuad())
+	{
+		return;
+	}
+
+	// the pixels of the viewport map to the quads
+	const Rectangle &cViewportRect = m_pCurrentRenderer->GetViewport();
+	Matrix4x4 mObjectSpaceToClipSpace;
+	mObjectSpaceToClipSpace.OrthoOffCenter(cViewportRect.vMin.x, cViewportRect.vMax.x, cViewportRect.vMin.y, cViewportRect.vMax.y, -1.0f, 1.0f);
+
+	if (!m_bCached || !DrawCached(mObjectSpaceToClipSpace))
+	{
+		DrawQuads(mObjectSpaceToClipSpace);
+	}
+}
+
+
+void SRPCompositor::DrawQuads(const Matrix4x4 &mObjectSpaceToClipSpace)
+{
+	// quads covered by an opaque quad in front of them are not drawn
+	m_sStats.nCulled = CullOccludedQuads();
+
+	// the program and texture are only set when they change
+	ProgramWrapper *pCurrentProgramWrapper = nullptr;
+	TextureBuffer *pCurrentTextureBuffer = nullptr;
+
+	if (m_bDepthOrdered)
+	{
+		// the depth test keeps the z-order, so the opaque quads can go front to back and what they cover is rejected early
+		const uint32 nZEnable = m_pCurrentRenderer->GetRenderState(RenderState::ZEnable);
+		const uint32 nZWriteEnable = m_pCurrentRenderer->GetRenderState(RenderState::ZWriteEnable);
+		const uint32 nZFunc = m_pCurrentRenderer->GetRenderState(RenderState::ZFunc);
+		m_pCurrentRenderer->Clear(Clear::ZBuffer);
+		m_pCurrentRenderer->SetRenderState(RenderState::ZEnable, true);
+		m_pCurrentRenderer->SetRenderState(RenderState::ZFunc, Compare::Less);
+
+		// opaque quads front to back without blending
+		m_pCurrentRenderer->SetRenderState(RenderState::BlendEnable, false);
+		m_pCurrentRenderer->SetRenderState(RenderState::ZWriteEnable, true);
+		for (int i = int(m_nNumOfQuads) - 1; i >= 0; i--)
+		{
+			if (m_pQuads[i].bOpaque && !m_pQuads[i].bCulled)
+				DrawQuad(uint32(i), mObjectSpaceToClipSpace, pCurrentProgramWrapper, pCurrentTextureBuffer);
+		}
+
+		// blended quads back to front, the ones behind an opaque quad fail the depth test
+		m_pCurrentRenderer->SetRenderState(RenderState::BlendEnable, true);
+		m_pCurrentRenderer->SetRenderState(RenderState::ZWriteEnable, false);
+		for (uint32 i = 0; i < m_nNumOfQuads; i++)
+		{
+			if (!m_pQuads[i].bOpaque && !m_pQuads[i].bCulled)
+				DrawQuad(i, mObjectSpaceToClipSpace, pCurrentProgramWrapper, pCurrentTextureBuffer);
+		}
+
+		m_pCurrentRenderer->SetRenderState(RenderState::ZEnable, nZEnable);
+		m_pCurrentRenderer->SetRenderState(RenderState::ZWriteEnable, nZWriteEnable);
+		m_pCurrentRenderer->SetRenderState(RenderState::ZFunc, nZFunc);
+	}
+	else
+	{
+		// all quads back to front, blending is only enabled for the ones that are not opaque
+		bool bBlend = true;
+		m_pCurrentRenderer->SetRenderState(RenderState::BlendEnable, bBlend);
+		for (uint32 i = 0; i < m_nNumOfQuads; i++)
+		{
+			const sCompositorQuad &sQuad = m_pQuads[i];
+			if (!sQuad.bCulled)
+			{
+				if (sQuad.bOpaque == bBlend)
+				{
+					bBlend = !sQuad.bOpaque;
+					m_pCurrentRenderer->SetRenderState(RenderState::BlendEnable, bBlend);
+				}
+				DrawQuad(i, mObjectSpaceToClipSpace, pCurrentProgramWrapper, pCurrentTextureBuffer);
+			}
+		}
+		if (!bBlend)
+		{
+			// leave blending on as the window passes did
+			m_pCurrentRenderer->SetRenderState(RenderState::BlendEnable, true);
+		}
+	}
+	m_sStats.nQuads = m_nNumOfQuads - m_sStats.nCulled;
+}
+
+
+bool SRPCompositor::DrawCached(const Matrix4x4 &mObjectSpaceToClipSpace)
+{
+	ProgramWrapper *pProgramWrapper = GetProgramWrapper(false);
+	if (!pProgramWrapper)
+	{
+		return false;
+	}
+
+	// the cache has the size of the viewport
+	const Rectangle cViewportRect = m_pCurrentRenderer->GetViewport();
+	const Vector2i vSize(int(cViewportRect.GetWidth()), int(cViewportRect.GetHeight()));
+	if (m_pCacheSurface && m_pCacheSurface->GetSize() != vSize)
+	{
+		DestroyCache();
+		m_nDirtyReasons |= (1 << CompositeDirtyViewport);
+	}
+	if (!m_pCacheSurface)
+	{
+		// depth ordering needs a depth buffer of its own
+		m_pCacheSurface = m_pCurrentRenderer->CreateSurfaceTextureBuffer2D(vSize, TextureBuffer::R8G8B8A8, SurfaceTextureBuffer::NoMultisampleAntialiasing | (m_bDepthOrdered ? SurfaceTextureBuffer::Depth : 0));
+		if (!m_pCacheSurface)
+		{
+			return false;
+		}
+		if (!(m_nDirtyReasons & (1 << CompositeDirtyViewport)))
+		{
+			m_nDirtyReasons |= (1 << CompositeDirtyInvalidated);
+		}
+	}
+	m_nDirtyReasons |= CompareQuads();
+
+	// the window passes blend straight alpha, the cache holds premultiplied colors
+	const uint32 nPreviousSrcBlendFunc = m_pCurrentRenderer->GetRenderState(RenderState::SrcBlendFunc);
+	const uint32 nPreviousDstBlendFunc = m_pCurrentRenderer->GetRenderState(RenderState::DstBlendFunc);
+	m_pCurrentRenderer->SetRenderState(RenderState::SrcBlendFunc, BlendFunc::One);
+	m_pCurrentRenderer->SetRenderState(RenderState::DstBlendFunc, BlendFunc::InvSrcAlpha);
+
+	if (m_nDirtyReasons)
+	{
+		// remember the renderer states we are going to change
+		Surface *pPreviousRenderTarget = m_pCurrentRenderer->GetRenderTarget();
+
+		if (m_pCurrentRenderer->SetRenderTarget(m_pCacheSurface))
+		{
+			// compose the quads into the cleared cache, the same pixels map to it as to the viewport
+			m_pCurrentRenderer->SetViewport();
+			m_pCurrentRenderer->Clear(Clear::Color, Color4(0.0f, 0.0f, 0.0f, 0.0f));
+			m_bPremultiply = true;
+			DrawQuads(mObjectSpaceToClipSpace);
+			m_bPremultiply = false;
+
+			for (uint32 i = 0; i < NumOfCompositeDirtyReasons; i++)
+			{
+				if (m_nDirtyReasons & (1 << i))
+				{
+					m_sCacheStats.nDirtyReasons[i]++;
+				}
+			}
+			m_sCacheStats.nRecomposites++;
+			m_nDirtyReasons = 0;
+		}
+
+		// restore the renderer states
+		m_pCurrentRenderer->SetRenderTarget(pPreviousRenderTarget);
+		m_pCurrentRenderer->SetViewport(&cViewportRect);
+	}
+
+	// present the cache with one quad over the viewport, render targets are bottom up so the texture coordinates flip
+	m_pCurrentRenderer->SetRenderState(RenderState::BlendEnable, true);
+	m_pCurrentRenderer->SetProgram(pProgramWrapper);
+	ProgramUniform *pProgramUniform = pProgramWrapper->GetUniform("ObjectSpaceToClipSpaceMatrix");
+	if (pProgramUniform)
+		pProgramUniform->Set(mObjectSpaceToClipSpace);
+	pProgramWrapper->Set("VertexPosition", m_pVertexBuffer, VertexBuffer::Position);
+	pProgramWrapper->Set("VertexTexCoord", m_pVertexBuffer, VertexBuffer::TexCoord);
+	const int nTextureUnit = pProgramWrapper->Set("TextureMap", m_pCacheSurface->GetTextureBuffer());
+	if (nTextureUnit >= 0)
+	{
+		m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::AddressU, TextureAddressing::Clamp);
+		m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::AddressV, TextureAddressing::Clamp);
+		m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MagFilter, TextureFiltering::None);
+		m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MinFilter, TextureFiltering::None);
+		m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MipFilter, TextureFiltering::None);
+	}
+	pProgramUniform = pProgramWrapper->GetUniform("QuadDepth");
+	if (pProgramUniform)
+		pProgramUniform->Set(0.0f);
+	ProgramCache::SetQuad(*pProgramWrapper, cViewportRect.vMin, Vector2(float(vSize.x), float(vSize.y)), Vector2(1.0f, -1.0f), Vector2(0.0f, 1.0f));
+	m_pCurrentRenderer->DrawPrimitives(Primitive::TriangleStrip, 0, 4);
+	m_sStats.nDrawCalls++;
+	m_sStats.nProgramChanges++;
+	m_sStats.nTextureChanges++;
+	m_sCacheStats.nPresents++;
+
+	m_pCurrentRenderer->SetRenderState(RenderState::SrcBlendFunc, nPreviousSrcBlendFunc);
+	m_pCurrentRenderer->SetRenderState(RenderState::DstBlendFunc, nPreviousDstBlendFunc);
+	return true;
+}
+
+
+uint32 SRPCompositor::CompareQuads() const
+{
+	if (m_nNumOfQuads != m_nNumOfLastQuads)
+	{
+		return (1 << CompositeDirtyVisibility);
+	}
+
+	uint32 nDirtyReasons = 0;
+	for (uint32 i = 0; i < m_nNumOfQuads; i++)
+	{
+		const sCompositorQuad &sQuad = m_pQuads[i];
+		const sCompositorQuad &sLastQuad = m_pLastQuads[i];
+		if (sQuad.pTextureBuffer != sLastQuad.pTextureBuffer)
+		{
+			// a texture that was drawn at another index changed its place, else a window was swapped for another one
+			bool bFound = false;
+			for (uint32 j = 0; j < m_nNumOfLastQuads && !bFound; j++)
+				bFound = (m_pLastQuads[j].pTextureBuffer == sQuad.pTextureBuffer);
+			nDirtyReasons |= (1 << (bFound ? CompositeDirtyOrder : CompositeDirtyVisibility));
+		}
+		else if (sQuad.vPosition != sLastQuad.vPosition || sQuad.vSize != sLastQuad.vSize || sQuad.vTextureCoordinateScale != sLastQuad.vTextureCoordinateScale ||
+				 sQuad.vTextureCoordinateOffset != sLastQuad.vTextureCoordinateOffset || sQuad.fOpacity != sLastQuad.fOpacity || sQuad.bSwizzle != sLastQuad.bSwizzle)
+		{
+			nDirtyReasons |= (1 << CompositeDirtyMove);
+		}
+	}
+	return nDirtyReasons;
+}
+
+
+void SRPCompositor::DrawQuad(uint32 nIndex, const Matrix4x4 &mObjectSpaceToClipSpace, ProgramWrapper *&pCurrentProgramWrapper, TextureBuffer *&pCurrentTextureBuffer)
+{
+	const sCompositorQuad &sQuad = m_pQuads[nIndex];
+	ProgramWrapper *pProgramWrapper = GetProgramWrapper(sQuad.bSwizzle);
+
+	if (pProgramWrapper != pCurrentProgramWrapper)
+	{
+		// set the program with the matrix and vertex attributes
+		m_pCurrentRenderer->SetProgram(pProgramWrapper);
+		ProgramUniform *pProgramUniform = pProgramWrapper->GetUniform("ObjectSpaceToClipSpaceMatrix");
+		if (pProgramUniform)
+			pProgramUniform->Set(mObjectSpaceToClipSpace);
+		pProgramWrapper->Set("VertexPosition", m_pVertexBuffer, VertexBuffer::Position);
+		pProgramWrapper->Set("VertexTexCoord", m_pVertexBuffer, VertexBuffer::TexCoord);
+		pCurrentProgramWrapper = pProgramWrapper;
+		pCurrentTextureBuffer = nullptr;
+		m_sStats.nProgramChanges++;
+	}
+
+	if (sQuad.pTextureBuffer != pCurrentTextureBuffer)
+	{
+		// bind the texture, the renderer drops sampler states that did not change
+		const int nTextureUnit = pProgramWrapper->Set("TextureMap", sQuad.pTextureBuffer);
+		if (nTextureUnit >= 0)
+		{
+			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::AddressU, TextureAddressing::Clamp);
+			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::AddressV, TextureAddressing::Clamp);
+			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MagFilter, sQuad.bLinear ? TextureFiltering::Linear : TextureFiltering::None);
+			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MinFilter, sQuad.bLinear ? TextureFiltering::Linear : TextureFiltering::None);
+			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MipFilter, TextureFiltering::None);
+		}
+		pCurrentTextureBuffer = sQuad.pTextureBuffer;
+		m_sStats.nTextureChanges++;
+	}
+
+	// the depth follows the z-order, front quads are nearer, without depth order all quads stay at 0
+	ProgramUniform *pProgramUniform = pProgramWrapper->GetUniform("QuadDepth");
+	if (pProgramUniform)
+		pProgramUniform->Set(m_bDepthOrdered ? (1.0f - 2.0f*float(nIndex + 1)/float(m_nNumOfQuads + 1)) : 0.0f);
+
+	// place the unit quad and draw it
+	ProgramCache::SetQuad(*pProgramWrapper, sQuad.vPosition, sQuad.vSize, sQuad.vTextureCoordinateScale, sQuad.vTextureCoordinateOffset, sQuad.fOpacity, m_bPremultiply);
+	m_pCurrentRenderer->DrawPrimitives(Primitive::TriangleStrip, 0, 4);
+	m_sStats.nDrawCalls++;
+	if (sQuad.bOpaque)
+	{
+		m_sStats.nOpaque++;
+	}
+}
+
+
+uint32 SRPCompositor::CullOccludedQuads()
+{
+	// front to back, a quad inside an opaque quad in front of it is culled, a culled quad is inside a
+	// quad further in front already, so only the quads that are drawn have to be tested against
+	uint32 nCulled = 0;
+	for (int i = int(m_nNumOfQuads) - 1; i >= 0; i--)
+	{
+		sCompositorQuad &sQuad = m_pQuads[i];
+		sQuad.bCulled = false;
+		for (uint32 j = uint32(i) + 1; j < m_nNumOfQuads; j++)
+		{
+			const sCompositorQuad &sOccluder = m_pQuads[j];
+			if (sOccluder.bOpaque && !sOccluder.bCulled &&
+				sOccluder.vPosition.x <= sQuad.vPosition.x && sOccluder.vPosition.y <= sQuad.vPosition.y &&
+				sOccluder.vPosition.x + sOccluder.vSize.x >= sQuad.vPosition.x + sQuad.vSize.x &&
+				sOccluder.vPosition.y + sOccluder.vSize.y >= sQuad.vPosition.y + sQuad.vSize.y)
+			{
+				sQuad.bCulled = true;
+				nCulled++;
+				break;
+			}
+		}
+	}
+	return nCulled;
+}
+
+
+void SRPCompositor::AddQuad(const sCompositorQuad &sQuad)
+{
+	if (m_nNumOfQuads == m_nMaxQuads)
+	{
+		// grow the list, it is kept for the next frames
+		const uint32 nMaxQuads = m_nMaxQuads ? m_nMaxQuads*2 : 64;
+		sCompositorQuad *pQuads = new sCompositorQuad[nMaxQuads];
+		if (m_pQuads)
+		{
+			MemoryManager::Copy(pQuads, m_pQuads, sizeof(sCompositorQuad)*m_nNumOfQuads);
+			delete [] m_pQuads;
+		}
+		m_pQuads = pQuads;
+		m_nMaxQuads = nMaxQuads;
+	}
+	m_pQuads[m_nNumOfQuads] = sQuad;
+	m_nNumOfQuads++;
+}
+
+
+void SRPCompositor::AddWindowQuads(SRPWindow *pSRPWindow)
+{
+	pSRPWindow->Upload();
+
+	if (!pSRPWindow->m_bInitialized || !pSRPWindow->m_bReadyToDraw || !pSRPWindow->m_psWindowsData->bIsVisable || !pSRPWindow->m_pTextureBuffer ||
+		pSRPWindow->m_psWindowsData->fOpacity <= 0.0f)
+	{
+		// nothing to draw
+		return;
+	}
+
+	// the shader only swizzles when the copy kernel does not
+	const bool bSwizzle = !pSRPWindow->m_psWindowsData->bSwizzleOnCopy;
+	if (!GetProgramWrapper(bSwizzle))
+	{
+		return;
+	}
+
+	// the window, moved, scaled and faded as animated
+	sCompositorQuad sQuad;
+	sQuad.pTextureBuffer = pSRPWindow->m_pTextureBuffer;
+	pSRPWindow->TransformQuad(Vector2(float(pSRPWindow->m_psWindowsData->nXPos), float(pSRPWindow->m_psWindowsData->nYPos)), pSRPWindow->m_vQuadSize, sQuad.vPosition, sQuad.vSize);
+	sQuad.vTextureCoordinateScale = pSRPWindow->m_vQuadTextureCoordinateScale;
+	sQuad.vTextureCoordinateOffset = pSRPWindow->m_vQuadTextureCoordinateOffset;
+	sQuad.fOpacity = pSRPWindow->m_psWindowsData->fOpacity;
+	sQuad.bSwizzle = bSwizzle;
+	// the widgets of an opaque window are opaque as well
+	sQuad.bOpaque = !pSRPWindow->m_psWindowsData->bTransparent && sQuad.fOpacity >= 1.0f;
+	sQuad.bCulled = false;
+	sQuad.bLinear = (pSRPWindow->GetTextureFiltering() == TextureFiltering::Linear);
+	AddQuad(sQuad);
+
+	// the widgets on top of it, their positions are absolute and they follow the animation of the window
+	if (pSRPWindow->m_pmapWidgets->GetNumOfElements() > 0)
+	{
+		Iterator<sWidget*> cIterator = pSRPWindow->m_pmapWidgets->GetIterator();
+		while (cIterator.HasNext())
+		{
+			const sWidget *psWidget = cIterator.Next();
+
+			// a widget has no texture before its first resize, and a pooled texture holds a former surface until
+			// the first paint
+			if (psWidget->pTextureBuffer && psWidget->nWidth > 0 && psWidget->nHeight > 0 && !psWidget->bNeedsFullUpdate)
+			{
+				sQuad.pTextureBuffer = psWidget->pTextureBuffer;
+				pSRPWindow->TransformQuad(Vector2(float(psWidget->nXPos), float(psWidget->nYPos)), pSRPWindow->GetWidgetQuadSize(psWidget), sQuad.vPosition, sQuad.vSize);
+				pSRPWindow->GetTextureCoordinates(psWidget->pTextureBuffer, psWidget->nWidth, psWidget->nHeight, sQuad.vTextureCoordinateScale, sQuad.vTextureCoordinateOffset);
+				AddQuad(sQuad);
+			}
+		}
+	}
+}
+
+
+VertexBuffer *SRPCompositor::GetUnitQuad()
+{
+	if (nullptr == m_pVertexBuffer)
+	{
+		if (m_pProgramCache)
+		{
+			// the unit quad is shared with the windows
+			m_pVertexBuffer = m_pProgramCache->GetUnitQuad(*m_pCurrentRenderer);
+		}
+		else
+		{
+			// no cache, the unit quad is our own
+			m_pVertexBuffer = ProgramCache::CreateUnitQuad(*m_pCurrentRenderer);
+		}
+	}
+	return m_pVertexBuffer;
+}
+
+
+ProgramWrapper *SRPCompositor::GetProgramWrapper(const bool &bSwizzle)
+{
+	const EProgramVariant nVariant = bSwizzle ? ProgramVariantSwizzle : ProgramVariantPlain;
+	if (nullptr == m_pProgramWrappers[nVariant])
+	{
+		if (m_pProgramCache)
+		{
+			// the program is shared with the windows
+			m_pProgramWrappers[nVariant] = m_pProgramCache->Get(*m_pCurrentRenderer, nVariant);
+		}
+		else if (nullptr == m_pVertexShaders[nVariant])
+		{
+			// no cache, the program is our own (tried once)
+			m_pProgramWrappers[nVariant] = ProgramCache::CreateProgram(*m_pCurrentRenderer, nVariant, m_pVertexShaders[nVariant], m_pFragmentShaders[nVariant]);
+		}
+	}
+	return m_pProgramWrappers[nVariant];
+}
+
+
+void SRPCompositor::DestroyProgramWrappers()
+{
+	// the own unit quad goes with the own programs
+	if (!m_pProgramCache && nullptr != m_pVertexBuffer)
+	{
+		delete m_pVertexBuffer;
+	}
+	m_pVertexBuffer = nullptr;
+
+	// the programs do not take over the shader resource control, so we destroy them ourselves
+	for (uint32 i = 0; i < NumOfProgramVariants; i++)
+	{
+		if (m_pProgramCache)
+		{
+			// the cache owns the program
+			m_pProgramWrappers[i] = nullptr;
+		}
+		else if (nullptr != m_pProgramWrappers[i])
+		{
+			delete m_pProgramWrappers[i];
+			m_pProgramWrappers[i] = nullptr;
+		}
+		if (nullptr != m_pFragmentShaders[i])
+		{
+			delete m_pFragmentShaders[i];
+			m_pFragmentShaders[i] = nullptr;
+		}
+		if (nullptr != m_pVertexShaders[i])
+		{
+			delete m_pVertexShaders[i];
+			m_pVertexShaders[i] = nullptr;
+		}
+	}
+}
+
+
+};
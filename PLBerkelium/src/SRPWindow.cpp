@@ -35,7 +35,6 @@ SRPWindow::SRPWindow(const String &sName) :
 	m_pFragmentShader(nullptr),
 	m_pProgramWrapper(nullptr),
 	m_pTextureBuffer(nullptr),
-	m_pTextureBufferNew(nullptr),
 	m_cImage(),
 	m_psWindowsData(new sWindowsData),
 	m_bInitialized(false),
@@ -45,9 +44,47 @@ SRPWindow::SRPWindow(const String &sName) :
 	m_bToolTipEnabled(false),
 	m_pmapDefaultCallBacks(new HashMap<String, sCallBack*>),
 	m_pmapCallBackFunctions(new HashMap<PLCore::String, PLCore::DynFuncPtr>),
-	m_bIgnoreBufferUpdate(false),
-	m_pmapWidgets(new HashMap<Berkelium::Widget*, sWidget*>)
-{
+	m_pmapWidgets(new HashMap<Berkelium::Widget*, sWidget*>),
+	m_pTextureUploader(nullptr),
+	m_pScrollSurface(nullptr),
+	m_bScrollOnGPUChecked(false),
+	m_bScrollOnGPUWorks(false),
+	m_bImageOutdated(false),
+	m_bSuspended(false),
+	m_bPaintsDropped(false),
+	m_pCopyWorkerPool(nullptr),
+	m_pSurfacePool(nullptr),
+	m_vPreviewSize(Vector2i::Zero),
+	m_nPreviewTime(0),
+	m_vResizeSize(Vector2i::Zero),
+	m_pCompositor(nullptr),
+	m_pProgramCache(nullptr),
+	m_vQuadSize(Vector2::Zero),
+	m_vQuadTextureCoordinateScale(Vector2::One),
+	m_vQuadTextureCoordinateOffset(Vector2::Zero),
+	m_pWindowAnimator(nullptr),
+	m_vRenderSize(Vector2i::Zero),
+	m_pHitTestIndex(nullptr)
+{
+	// default window data that is not set by the creator of the window
+	m_psWindowsData->fFullUploadThreshold = 0.5f;
+	m_psWindowsData->bSwizzleOnCopy = true;
+	m_psWindowsData->bScrollOnGPU = false;
+	m_psWindowsData->nNumOfPixelBuffers = 0;
+	m_psWindowsData->bZeroCopy = false;
+	m_psWindowsData->nUploadCallCost = 4096;
+	m_psWindowsData->bSuspendCopyWhenHidden = true;
+	m_psWindowsData->nResizeIdleTime = 150;
+	m_psWindowsData->bResizeStretch = true;
+	m_psWindowsData->fOpacity = 1.0f;
+	m_psWindowsData->vTranslation = Vector2::Zero;
+	m_psWindowsData->fScale = 1.0f;
+	m_psWindowsData->fRenderScale = 1.0f;
+	m_psWindowsData->bClickThrough = false;
+
+	// nothing painted yet
+	ResetStats();
+
 	// we need to create a berkelium context
 	// it might be wise to centralize the context back to the Gui class because each context is represented my a Berkelium.exe process on runtime
 	// the only downside of this is when a window crashes it needs to refresh all windows within the context so they will lose their current state
@@ -58,6 +95,18 @@ SRPWindow::SRPWindow(const String &sName) :
 
 SRPWindow::~SRPWindow()
 {
+	// the compositor must not draw this window anymore
+	if (m_pCompositor)
+	{
+		m_pCompositor->RemoveWindow(this);
+	}
+	// the animator must not animate this window anymore
+	if (m_pWindowAnimator)
+	{
+		m_pWindowAnimator->Stop(this);
+	}
+	// the index must not hit this window anymore
+	InvalidateHitTest();
 	// we should clear the callbacks
 	RemoveCallBacks();
 	// we destroy the used berkelium window
@@ -67,29 +116,19 @@ SRPWindow::~SRPWindow()
 	// destroy the tool tip window
 	DestroyToolTipWindow();
 	// cleanup
-	if (nullptr != m_pVertexBuffer)
-	{
-		delete m_pVertexBuffer;
-	}
-	if (nullptr != m_pProgramWrapper)
-	{
-		delete m_pProgramWrapper;
-	}
-	if (nullptr != m_pFragmentShader)
-	{
-		delete m_pFragmentShader;
-	}
-	if (nullptr != m_pVertexShader)
+	DestroyUnitQuad();
+	DestroyProgramWrapper();
+	if (nullptr != m_pTextureBuffer)
 	{
-		delete m_pVertexShader;
+		DestroySurfaceTexture(m_pTextureBuffer);
 	}
-	if (nullptr != m_pTextureBuffer)
+	if (nullptr != m_pTextureUploader)
 	{
-		delete m_pTextureBuffer;
+		delete m_pTextureUploader;
 	}
-	if (nullptr != m_pTextureBufferNew)
+	if (nullptr != m_pScrollSurface)
 	{
-		delete m_pTextureBufferNew;
+		delete m_pScrollSurface;
 	}
 }
 
@@ -103,9 +142,13 @@ void SRPWindow::DebugToConsole(const String &sString)
 
 void SRPWindow::Draw(Renderer &cRenderer, const SQCull &cCullQuery)
 {
-	if (m_bReadyToDraw)
+	// the Gui uploads all windows before they are drawn, this only catches paints that came in since
+	// (e.g. when berkelium is updated without the Gui update event)
+	Upload();
+
+	if (m_bReadyToDraw && m_psWindowsData->fOpacity > 0.0f)
 	{
-		// draw the window and widgets if we are ready
+		// draw the window and widgets if we are ready and not faded out
 		DrawWindow();
 		DrawWidgets();
 	}
@@ -114,40 +157,86 @@ void SRPWindow::Draw(Renderer &cRenderer, const SQCull &cCullQuery)
 
 void SRPWindow::onPaint(Berkelium::Window *win, const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, size_t numCopyRects, const Berkelium::Rect *copyRects, int dx, int dy, const Berkelium::Rect &scrollRect)
 {
-	if (!m_bIgnoreBufferUpdate)
+	// the first paint at the requested size completes a resize, until then the old size is painted and drawn
+	if (m_vResizeSize != Vector2i::Zero && sourceBufferRect.width() == ToRenderSize(m_vResizeSize).x && sourceBufferRect.height() == ToRenderSize(m_vResizeSize).y)
 	{
-		if (m_psWindowsData->bNeedsFullUpdate)
+		ApplyResize();
+	}
+
+	if (!m_psWindowsData->bIsVisable)
+	{
+		m_sStats.nPaintsHidden++;
+		if (m_psWindowsData->bSuspendCopyWhenHidden || m_psWindowsData->bZeroCopy)
 		{
-			// awaiting a full update disregard all partials ones until the full one comes in
-			BufferCopyFull(m_cImage.GetBuffer()->GetData(), m_psWindowsData->nFrameWidth, m_psWindowsData->nFrameHeight, sourceBuffer, sourceBufferRect);
-			BufferUploadToGPU();
-			m_psWindowsData->bNeedsFullUpdate = false;
+			// hidden, drop the paint, the window asks for a full paint when shown again
+			// (zero copy always drops, the staging buffer can not wait for the show)
+			m_bPaintsDropped = true;
+			m_cAlphaMask.Clear();
+			return;
+		}
+	}
+
+	// the image is updated right away, the upload waits for the next draw
+	m_sStats.nPaints++;
+	const bool bUploadPending = !m_cPendingDamage.IsEmpty();
+	const uint32 nNumOfUploads = m_sStats.nUploads;
+
+	if (m_psWindowsData->bNeedsFullUpdate)
+	{
+		// awaiting a full update disregard all partials ones until the full one comes in
+		BufferCopyFull(GetPaintBuffer(), m_vRenderSize.x, m_vRenderSize.y, sourceBuffer, sourceBufferRect);
+		m_bImageOutdated = false;
+		BufferQueueUpload();
+		m_psWindowsData->bNeedsFullUpdate = false;
+	}
+	else
+	{
+		if (sourceBufferRect.width() == m_vRenderSize.x && sourceBufferRect.height() == m_vRenderSize.y)
+		{
+			// did not suspect a full update but got it anyway, it might happen and is ok
+			BufferCopyFull(GetPaintBuffer(), m_vRenderSize.x, m_vRenderSize.y, sourceBuffer, sourceBufferRect);
+			m_bImageOutdated = false;
+			BufferQueueUpload();
 		}
 		else
 		{
-			if (sourceBufferRect.width() == m_psWindowsData->nFrameWidth && sourceBufferRect.height() == m_psWindowsData->nFrameHeight)
+			if ((dx != 0 || dy != 0) && m_psWindowsData->bScrollOnGPU && m_psWindowsData->bIsVisable && BufferScrollOnGPU(dx, dy, scrollRect))
 			{
-				// did not suspect a full update but got it anyway, it might happen and is ok
-				BufferCopyFull(m_cImage.GetBuffer()->GetData(), m_psWindowsData->nFrameWidth, m_psWindowsData->nFrameHeight, sourceBuffer, sourceBufferRect);
-				BufferUploadToGPU();
+				// the scroll rect has been moved inside the texture, only the exposed rects are dirty
+				BufferCopyRects(GetPaintBuffer(), m_vRenderSize.x, m_vRenderSize.y, sourceBuffer, sourceBufferRect, numCopyRects, copyRects);
+				BufferQueueUpload(numCopyRects, copyRects);
 			}
-			else
+			else if (dx != 0 || dy != 0)
 			{
-				if (dx != 0 || dy != 0)
+				// a scroll has taken place, the moved scroll rect and the exposed rects are dirty
+				if (m_psWindowsData->bZeroCopy)
 				{
-					// a scroll has taken place
-					BufferCopyScroll(m_cImage.GetBuffer()->GetData(), m_psWindowsData->nFrameWidth, m_psWindowsData->nFrameHeight, sourceBuffer, sourceBufferRect, numCopyRects, copyRects, dx, dy, scrollRect);
-					BufferUploadToGPU();
-				}
-				else
-				{
-					// normal partial updates
-					BufferCopyRects(m_cImage.GetBuffer()->GetData(), m_psWindowsData->nFrameWidth, m_psWindowsData->nFrameHeight, sourceBuffer, sourceBufferRect, numCopyRects, copyRects);
-					BufferUploadToGPU();
+					// the GPU could not scroll, the CPU needs the image buffer for that
+					DebugToConsole("Scroll on the GPU failed, leaving zero copy mode\n");
+					SetZeroCopy(false);
 				}
+				SyncImageFromGPU();
+				BufferCopyScroll(m_cImage.GetBuffer()->GetData(), m_vRenderSize.x, m_vRenderSize.y, sourceBuffer, sourceBufferRect, numCopyRects, copyRects, dx, dy, scrollRect);
+				BufferQueueUpload(1, &scrollRect);
+				BufferQueueUpload(numCopyRects, copyRects);
+			}
+			else
+			{
+				// normal partial updates, only the copy rects are dirty
+				BufferCopyRects(GetPaintBuffer(), m_vRenderSize.x, m_vRenderSize.y, sourceBuffer, sourceBufferRect, numCopyRects, copyRects);
+				BufferQueueUpload(numCopyRects, copyRects);
 			}
 		}
 	}
+
+	// the transparent pixels follow the paint
+	UpdateAlphaMask(sourceBuffer, sourceBufferRect, numCopyRects, copyRects, dx, dy, scrollRect);
+
+	// merged if it rides along with an upload that was already pending
+	if (bUploadPending && nNumOfUploads == m_sStats.nUploads)
+	{
+		m_sStats.nPaintsMerged++;
+	}
 }
 
 
@@ -159,31 +248,6 @@ void SRPWindow::onCreatedWindow(Berkelium::Window *win, Berkelium::Window *newWi
 }
 
 
-VertexBuffer *SRPWindow::CreateVertexBuffer(const Vector2 &vPosition, const Vector2 &vImageSize)
-{
-	// lets create a vertex buffer
-	VertexBuffer *pVertexBuffer = m_pCurrentRenderer->CreateVertexBuffer();
-	if (pVertexBuffer)
-	{
-		// setup and allocate the vertex buffer
-		pVertexBuffer->AddVertexAttribute(VertexBuffer::Position, 0, VertexBuffer::Float2);
-		pVertexBuffer->AddVertexAttribute(VertexBuffer::TexCoord, 0, VertexBuffer::Float2);
-		pVertexBuffer->Allocate(4, Usage::WriteOnly);
-
-		// fill the vertex buffer
-		UpdateVertexBuffer(pVertexBuffer, vPosition, vImageSize);
-
-		// return the created vertex buffer
-		return pVertexBuffer;
-	}
-	else
-	{
-		// something when wrong so we return nothing
-		return nullptr;
-	}
-}
-
-
 void SRPWindow::SetRenderer(Renderer *pRenderer)
 {
 	m_pCurrentRenderer = pRenderer;
@@ -195,30 +259,19 @@ ProgramWrapper *SRPWindow::CreateProgramWrapper()
 	// is there already a program instance?
 	if (nullptr == m_pProgramWrapper)
 	{
-		// declare vertex and fragment shader
-		String sVertexShaderSourceCode;
-		String sFragmentShaderSourceCode;
+		// the shader only swizzles when the copy kernel does not
+		const EProgramVariant nVariant = m_psWindowsData->bSwizzleOnCopy ? ProgramVariantPlain : ProgramVariantSwizzle;
 
-		// account for OpenGL version
-		if (m_pCurrentRenderer->GetAPI() == "OpenGL ES 2.0")
+		if (m_pProgramCache)
 		{
-			#include "ARGBtoRGBA_GLSL.h"
-			sVertexShaderSourceCode   = "#version 100\n" + sBerkeliumVertexShaderSourceCodeGLSL;
-			sFragmentShaderSourceCode = "#version 100\n" + sBerkeliumFragmentShaderSourceCodeGLSL;
+			// take the program all windows share
+			m_pProgramWrapper = m_pProgramCache->Get(*m_pCurrentRenderer, nVariant);
 		}
 		else
 		{
-			#include "ARGBtoRGBA_GLSL.h"
-			sVertexShaderSourceCode   = "#version 110\n" + Shader::RemovePrecisionQualifiersFromGLSL(sBerkeliumVertexShaderSourceCodeGLSL);
-			sFragmentShaderSourceCode = "#version 110\n" + Shader::RemovePrecisionQualifiersFromGLSL(sBerkeliumFragmentShaderSourceCodeGLSL);
+			// create our own program
+			m_pProgramWrapper = ProgramCache::CreateProgram(*m_pCurrentRenderer, nVariant, m_pVertexShader, m_pFragmentShader);
 		}
-
-		// create the vertex and fragment shader
-		m_pVertexShader = m_pCurrentRenderer->GetShaderLanguage(m_pCurrentRenderer->GetDefaultShaderLanguage())->CreateVertexShader(sVertexShaderSourceCode, "arbvp1");
-		m_pFragmentShader = m_pCurrentRenderer->GetShaderLanguage(m_pCurrentRenderer->GetDefaultShaderLanguage())->CreateFragmentShader(sFragmentShaderSourceCode, "arbfp1");
-
-		// create the program wrapper
-		m_pProgramWrapper = static_cast<ProgramWrapper*>(m_pCurrentRenderer->GetShaderLanguage(m_pCurrentRenderer->GetDefaultShaderLanguage())->CreateProgram(m_pVertexShader, m_pFragmentShader));
 		if (m_pProgramWrapper)
 		{
 			// return the created program wrapper
@@ -238,65 +291,63 @@ ProgramWrapper *SRPWindow::CreateProgramWrapper()
 }
 
 
-bool SRPWindow::UpdateVertexBuffer(VertexBuffer *pVertexBuffer, const Vector2 &vPosition, const Vector2 &vImageSize)
+VertexBuffer *SRPWindow::CreateUnitQuad()
 {
-	//hack: [10-07-2012 Icefire] i am not sure yet if this method is right for this use case
-
-	if (!pVertexBuffer)
+	// is there already a unit quad?
+	if (nullptr == m_pVertexBuffer)
 	{
-		DebugToConsole("VertexBuffer not valid!\n");
-		return false;
+		if (m_pProgramCache)
+		{
+			// take the unit quad all windows share
+			m_pVertexBuffer = m_pProgramCache->GetUnitQuad(*m_pCurrentRenderer);
+		}
+		else
+		{
+			// create our own unit quad
+			m_pVertexBuffer = ProgramCache::CreateUnitQuad(*m_pCurrentRenderer);
+		}
 	}
-	else
+	return m_pVertexBuffer;
+}
+
+
+void SRPWindow::DestroyUnitQuad()
+{
+	if (!m_pProgramCache && nullptr != m_pVertexBuffer)
 	{
-		// fill the vertex buffer data
-		if (pVertexBuffer->Lock(Lock::WriteOnly))
-		{
-			Vector2 vTextureCoordinate(Vector2::Zero);
-			Vector2 vTextureCoordinateSize(Vector2::One);
-			float fTextureCoordinateScaleX(1.0f);
-			float fTextureCoordinateScaleY(1.0f);
-
-			// Vertex 0
-			float *pfVertex = static_cast<float*>(pVertexBuffer->GetData(0, VertexBuffer::Position));
-			pfVertex[0] = vPosition.x;
-			pfVertex[1] = vPosition.y + vImageSize.y;
-			pfVertex	= static_cast<float*>(pVertexBuffer->GetData(0, VertexBuffer::TexCoord));
-			pfVertex[0] = vTextureCoordinate.x*fTextureCoordinateScaleX;
-			pfVertex[1] = (vTextureCoordinate.y + vTextureCoordinateSize.y)*fTextureCoordinateScaleY;
-
-			// Vertex 1
-			pfVertex	= static_cast<float*>(pVertexBuffer->GetData(1, VertexBuffer::Position));
-			pfVertex[0] = vPosition.x + vImageSize.x;
-			pfVertex[1] = vPosition.y + vImageSize.y;
-			pfVertex	= static_cast<float*>(pVertexBuffer->GetData(1, VertexBuffer::TexCoord));
-			pfVertex[0] = (vTextureCoordinate.x + vTextureCoordinateSize.x)*fTextureCoordinateScaleX;
-			pfVertex[1] = (vTextureCoordinate.y + vTextureCoordinateSize.y)*fTextureCoordinateScaleY;
-
-			// Vertex 2
-			pfVertex	= static_cast<float*>(pVertexBuffer->GetData(2, VertexBuffer::Position));
-			pfVertex[0] = vPosition.x;
-			pfVertex[1] = vPosition.y;
-			pfVertex	= static_cast<float*>(pVertexBuffer->GetData(2, VertexBuffer::TexCoord));
-			pfVertex[0] = vTextureCoordinate.x*fTextureCoordinateScaleX;
-			pfVertex[1] = vTextureCoordinate.y*fTextureCoordinateScaleY;
-
-			// Vertex 3
-			pfVertex	= static_cast<float*>(pVertexBuffer->GetData(3, VertexBuffer::Position));
-			pfVertex[0] = vPosition.x + vImageSize.x;
-			pfVertex[1] = vPosition.y;
-			pfVertex	= static_cast<float*>(pVertexBuffer->GetData(3, VertexBuffer::TexCoord));
-			pfVertex[0] = (vTextureCoordinate.x + vTextureCoordinateSize.x)*fTextureCoordinateScaleX;
-			pfVertex[1] = vTextureCoordinate.y*fTextureCoordinateScaleY;
-
-			// Unlock the vertex buffer
-			pVertexBuffer->Unlock();
-		}
+		// the unit quad is our own
+		delete m_pVertexBuffer;
+	}
+	m_pVertexBuffer = nullptr;
+}
 
-		return true;
+
+void SRPWindow::DestroyProgramWrapper()
+{
+	// the program does not take over the shader resource control, so we destroy them ourselves
+	if (m_pProgramCache)
+	{
+		// the cache owns the program
+		m_pProgramWrapper = nullptr;
+	}
+	else if (nullptr != m_pProgramWrapper)
+	{
+		delete m_pProgramWrapper;
+		m_pProgramWrapper = nullptr;
+	}
+	if (nullptr != m_pFragmentShader)
+	{
+		delete m_pFragmentShader;
+		m_pFragmentShader = nullptr;
+	}
+	if (nullptr != m_pVertexShader)
+	{
+		delete m_pVertexShader;
+		m_pVertexShader = nullptr;
 	}
 }
 
+
 bool SRPWindow::Initialize(Renderer *pRenderer, const Vector2 &vPosition, const Vector2 &vImageSize)
 {
 	// set the renderer
@@ -304,21 +355,37 @@ bool SRPWindow::Initialize(Renderer *pRenderer, const Vector2 &vPosition, const
 
 	//fix: [10-07-2012 Icefire] verify the following to be valid and optimal
 
-	// set the vertex buffer
-	m_pVertexBuffer = CreateVertexBuffer(vPosition, vImageSize);
+	// set the unit quad, the window is placed by the program uniforms
+	m_pVertexBuffer = CreateUnitQuad();
 
 	// set the program wrapper
 	m_pProgramWrapper = CreateProgramWrapper();
 
 	if (m_pVertexBuffer && m_pProgramWrapper)
 	{
+		// berkelium renders the window at its render scale
+		m_vRenderSize = ToRenderSize(Vector2i(m_psWindowsData->nFrameWidth, m_psWindowsData->nFrameHeight));
 		// create the image
-		m_cImage = Image::CreateImage(DataByte, ColorRGBA, Vector3i(m_psWindowsData->nFrameWidth, m_psWindowsData->nFrameHeight, 1));
+		m_cImage = Image::CreateImage(DataByte, ColorRGBA, Vector3i(m_vRenderSize.x, m_vRenderSize.y, 1));
 		// create the texture buffer
-		m_pTextureBuffer = reinterpret_cast<TextureBuffer*>(pRenderer->CreateTextureBuffer2D(m_cImage, TextureBuffer::Unknown, 0));
+		m_pTextureBuffer = CreateSurfaceTexture(m_vRenderSize.x, m_vRenderSize.y);
 
 		if (m_pTextureBuffer)
 		{
+			// map the quad to the used part of the texture
+			UpdateWindowQuad();
+
+			// create the texture uploader
+			if (nullptr == m_pTextureUploader)
+			{
+				m_pTextureUploader = new TextureUploader(pRenderer);
+				if (m_psWindowsData->nNumOfPixelBuffers > 0 && !m_pTextureUploader->SetNumOfPixelBuffers(m_psWindowsData->nNumOfPixelBuffers))
+				{
+					// no pixel buffer support, stay with the straight upload
+					m_psWindowsData->nNumOfPixelBuffers = 0;
+				}
+			}
+
 			// create the image buffer
 			if (nullptr != m_cImage.GetBuffer()->GetData())
 			{
@@ -329,6 +396,12 @@ bool SRPWindow::Initialize(Renderer *pRenderer, const Vector2 &vPosition, const
 				// set the default callback functions
 				SetDefaultCallBackFunctions();
 				m_bInitialized = true;
+				// drop the image buffer if the window was set up for zero copy
+				if (m_psWindowsData->bZeroCopy)
+				{
+					m_psWindowsData->bZeroCopy = false;
+					SetZeroCopy(true);
+				}
 				return true;
 			}
 			// image buffer could not be created
@@ -358,10 +431,9 @@ void SRPWindow::DrawWindow()
 	{
 		// set the program
 		m_pCurrentRenderer->SetProgram(m_pProgramWrapper);
-		// set the render state to allow for transparency
-		m_pCurrentRenderer->SetRenderState(RenderState::BlendEnable, true);
+		// set the render state to allow for transparency, an opaque window does not need blending
+		m_pCurrentRenderer->SetRenderState(RenderState::BlendEnable, m_psWindowsData->bTransparent || m_psWindowsData->fOpacity < 1.0f);
 
-		//todo: [10-07-2012 Icefire] let (re)sizing be handled by the program uniform, see http://dev.pixellight.org/forum/viewtopic.php?f=6&t=503
 		{
 			const Rectangle &cViewportRect = m_pCurrentRenderer->GetViewport();
 			float fX1 = cViewportRect.vMin.x;
@@ -377,14 +449,19 @@ void SRPWindow::DrawWindow()
 			if (pProgramUniform)
 				pProgramUniform->Set(m_mObjectSpaceToClipSpace);
 
+			// place the unit quad, moved, scaled and faded as animated
+			Vector2 vDrawPosition, vDrawSize;
+			TransformQuad(Vector2(float(m_psWindowsData->nXPos), float(m_psWindowsData->nYPos)), m_vQuadSize, vDrawPosition, vDrawSize);
+			ProgramCache::SetQuad(*m_pProgramWrapper, vDrawPosition, vDrawSize, m_vQuadTextureCoordinateScale, m_vQuadTextureCoordinateOffset, m_psWindowsData->fOpacity);
+
 			const int nTextureUnit = m_pProgramWrapper->Set("TextureMap", m_pTextureBuffer);
 			if (nTextureUnit >= 0)
 			{
 				// set sampler states
 				m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::AddressU, TextureAddressing::Clamp);
 				m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::AddressV, TextureAddressing::Clamp);
-				m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MagFilter, TextureFiltering::None);
-				m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MinFilter, TextureFiltering::None);
+				m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MagFilter, GetTextureFiltering());
+				m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MinFilter, GetTextureFiltering());
 				m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MipFilter, TextureFiltering::None);
 			}
 
@@ -403,13 +480,32 @@ void SRPWindow::BufferCopyFull(uint8 *pImageBuffer, int &nWidth, int &nHeight, c
 {
 	if (sourceBufferRect.left() == 0 && sourceBufferRect.top() == 0 && sourceBufferRect.right() == nWidth && sourceBufferRect.bottom() == nHeight)
 	{
-		MemoryManager::Copy(pImageBuffer, sourceBuffer, sourceBufferRect.right() * sourceBufferRect.bottom() * 4);
+		if (m_pCopyWorkerPool)
+		{
+			// full frames are large, share them in row bands
+			m_pCopyWorkerPool->CopyRects(pImageBuffer, nWidth, nHeight, sourceBuffer, sourceBufferRect, 1, &sourceBufferRect, m_psWindowsData->bSwizzleOnCopy);
+		}
+		else
+		{
+			BufferCopy::CopyRect(pImageBuffer, nWidth, nHeight, sourceBuffer, sourceBufferRect, sourceBufferRect, m_psWindowsData->bSwizzleOnCopy);
+		}
 	}
 }
 
 
 bool SRPWindow::AddSceneRenderPass(SceneRenderer *pSceneRenderer)
 {
+	if (m_pCompositor)
+	{
+		// the compositor draws the window within its scene render pass
+		if (m_pCompositor->AddWindow(this))
+		{
+			m_pCurrentSceneRenderer = pSceneRenderer;
+			return true;
+		}
+		return false;
+	}
+
 	// add scene render pass
 	if (pSceneRenderer->Add(*reinterpret_cast<SceneRendererPass*>(this)))
 	{
@@ -425,6 +521,11 @@ bool SRPWindow::AddSceneRenderPass(SceneRenderer *pSceneRenderer)
 
 bool SRPWindow::RemoveSceneRenderPass()
 {
+	if (m_pCompositor)
+	{
+		// remove the window from the compositor
+		return m_pCompositor->RemoveWindow(this);
+	}
 	if (m_pCurrentSceneRenderer)
 	{
 		// remove scene render pass
@@ -456,24 +557,15 @@ void SRPWindow::CreateBerkeliumWindow()
 
 void SRPWindow::BufferCopyRects(PLCore::uint8 *pImageBuffer, int &nWidth, int &nHeight, const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, size_t numCopyRects, const Berkelium::Rect *copyRects)
 {
-	for (size_t i = 0; i < numCopyRects; i++)
+	// copy the clipped rects, swizzling on the fly if wanted
+	if (m_pCopyWorkerPool)
 	{
-		int nCrWidth = copyRects[i].width();
-		int nCrHeight = copyRects[i].height();
-		int nCrTop = copyRects[i].top() - sourceBufferRect.top();
-		int nCrLeft = copyRects[i].left() - sourceBufferRect.left();
-		int nBrTop = copyRects[i].top();
-		int nBrLeft = copyRects[i].left();
-
-		for(int nCrHeightIndex = 0; nCrHeightIndex < nCrHeight; nCrHeightIndex++)
-		{
-			int nStartPosition = (nWidth - nBrLeft) * nBrTop + (nBrTop * nBrLeft) + nBrLeft + (nWidth * nCrHeightIndex);
-			MemoryManager::Copy(
-				&pImageBuffer[nStartPosition * 4],
-				sourceBuffer + (nCrLeft + (nCrHeightIndex + nCrTop) * sourceBufferRect.width()) * 4,
-				nCrWidth * 4
-				);
-		}
+		// the pool keeps small copies on this thread by itself
+		m_pCopyWorkerPool->CopyRects(pImageBuffer, nWidth, nHeight, sourceBuffer, sourceBufferRect, numCopyRects, copyRects, m_psWindowsData->bSwizzleOnCopy);
+	}
+	else
+	{
+		BufferCopy::CopyRects(pImageBuffer, nWidth, nHeight, sourceBuffer, sourceBufferRect, numCopyRects, copyRects, m_psWindowsData->bSwizzleOnCopy);
 	}
 }
 
@@ -483,90 +575,482 @@ void SRPWindow::BufferUploadToGPU()
 	if (m_bInitialized)
 	{
 		// upload data to GPU
-		if (m_pTextureBufferNew)
-		{
-			m_pTextureBufferNew->CopyDataFrom(0, TextureBuffer::R8G8B8A8, m_cImage.GetBuffer()->GetData());
-			if (m_pTextureBuffer)
-				delete m_pTextureBuffer;
-			m_pTextureBuffer = m_pTextureBufferNew;
-			m_pTextureBufferNew = nullptr;
-			UpdateVertexBuffer(m_pVertexBuffer, Vector2(float(m_psWindowsData->nXPos), float(m_psWindowsData->nYPos)), Vector2(float(m_psWindowsData->nFrameWidth), float(m_psWindowsData->nFrameHeight)));
-		}
-		else
-		{
-			m_pTextureBuffer->CopyDataFrom(0, TextureBuffer::R8G8B8A8, m_cImage.GetBuffer()->GetData());
-		}
+		BufferUploadFull(m_pTextureBuffer);
 		// set state for future usage
 		if (!m_bReadyToDraw) m_bReadyToDraw = true;
 	}
 }
 
 
-void SRPWindow::BufferCopyScroll(PLCore::uint8 *pImageBuffer, int &nWidth, int &nHeight, const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, size_t numCopyRects, const Berkelium::Rect *copyRects, int dx, int dy, const Berkelium::Rect &scrollRect)
-{
-	Berkelium::Rect scrolled_rect = scrollRect.translate(-dx, -dy);
-	Berkelium::Rect scrolled_shared_rect = scrollRect.intersect(scrolled_rect);
-	if (scrolled_shared_rect.width() > 0 && scrolled_shared_rect.height() > 0)
+void SRPWindow::BufferUploadToGPU(size_t numCopyRects, const Berkelium::Rect *copyRects)
+{
+	if (m_bInitialized)
 	{
-		int wid = scrollRect.width();
-		int hig = scrollRect.height();
-		int top = scrollRect.top();
-		int left = scrollRect.left();
-		int tw = nWidth;
+		// get the dirty fraction of the surface
+		const float fDirtyFraction = TextureUploader::GetCoveredFraction(m_vRenderSize.x, m_vRenderSize.y, numCopyRects, copyRects);
 
-		if (dy < 0) // scroll down
+		if (m_psWindowsData->bZeroCopy)
 		{
-			for (int y = -dy; y < hig; y++)
-			{
-				unsigned int tb = ((top + y) * tw + left) * 4;
-				unsigned int tb2 = tb + dy * tw * 4;
-				MemoryManager::Copy(&pImageBuffer[tb2], &pImageBuffer[tb], wid * 4);
-			}
+			// only the dirty rects of the staging buffer hold valid data
+			m_pTextureUploader->UploadStaging(m_pTextureBuffer, m_vRenderSize.x, m_vRenderSize.y, numCopyRects, copyRects);
+			// set state for future usage
+			if (!m_bReadyToDraw) m_bReadyToDraw = true;
 		}
-		else if (dy > 0) // scroll up
+		else if (!m_bImageOutdated && fDirtyFraction > m_psWindowsData->fFullUploadThreshold)
 		{
-			for (int y = hig - dy; y > -1; y--)
-			{
-				unsigned int tb = ((top + y) * tw + left) * 4;
-				unsigned int tb2 = tb + dy * tw * 4;
-				MemoryManager::Copy(&pImageBuffer[tb2], &pImageBuffer[tb], wid * 4);
-			}
+			// most of the texture is dirty, so a full upload is the better deal
+			// (not when the image is outdated by a GPU scroll, the texture holds the only valid copy then)
+			BufferUploadToGPU();
 		}
-		if(dx != 0) // scroll horizontal !! WIERD CRASH HERE !!
+		else
 		{
-			//fix: [10-07-2012 Icefire] buffer overflow within this scope
-			// int subx = dx > 0 ? 0 : -dx;
-			for (int y = 0; y < hig; y++)
-			{
-				unsigned int tb = ((top + y) * tw + left) * 4;
-				unsigned int tb2 = tb - dx * 4;
-				MemoryManager::Copy(&pImageBuffer[tb], &pImageBuffer[tb2], wid * 4 - 0);
-			}
+			// upload the dirty rects only
+			m_pTextureUploader->UploadRects(m_pTextureBuffer, m_cImage.GetBuffer()->GetData(), m_vRenderSize.x, m_vRenderSize.y, numCopyRects, copyRects);
+			// set state for future usage
+			if (!m_bReadyToDraw) m_bReadyToDraw = true;
 		}
-	}
-	// new data for scrolling
-	for (size_t i = 0; i < numCopyRects; i++)
+	}
+}
+
+
+void SRPWindow::BufferUploadFull(TextureBuffer *pTextureBuffer)
+{
+	if (m_psWindowsData->bZeroCopy)
+	{
+		// the staging buffer holds a full paint
+		Berkelium::Rect cFullRect;
+		cFullRect.mLeft   = 0;
+		cFullRect.mTop    = 0;
+		cFullRect.mWidth  = m_vRenderSize.x;
+		cFullRect.mHeight = m_vRenderSize.y;
+		m_pTextureUploader->UploadStaging(pTextureBuffer, m_vRenderSize.x, m_vRenderSize.y, 1, &cFullRect);
+	}
+	else
+	{
+		m_pTextureUploader->UploadFull(pTextureBuffer, m_cImage.GetBuffer()->GetData(), m_vRenderSize.x, m_vRenderSize.y);
+	}
+}
+
+
+TextureBuffer *SRPWindow::CreateSurfaceTexture(const int &nWidth, const int &nHeight)
+{
+	if (m_pSurfacePool)
+	{
+		return m_pSurfacePool->Acquire(*m_pCurrentRenderer, nWidth, nHeight);
+	}
+
+	// no pool, create the texture at the exact size
+	Image cImage = Image::CreateImage(DataByte, ColorRGBA, Vector3i(nWidth, nHeight, 1));
+	return reinterpret_cast<TextureBuffer*>(m_pCurrentRenderer->CreateTextureBuffer2D(cImage, TextureBuffer::Unknown, 0));
+}
+
+
+void SRPWindow::DestroySurfaceTexture(TextureBuffer *pTextureBuffer)
+{
+	if (m_pSurfacePool)
+	{
+		m_pSurfacePool->Release(pTextureBuffer);
+	}
+	else
+	{
+		delete pTextureBuffer;
+	}
+}
+
+
+bool SRPWindow::IsSurfaceTextureFitting(TextureBuffer *pTextureBuffer, const int &nWidth, const int &nHeight) const
+{
+	if (!pTextureBuffer)
 	{
-		int nCrWidth = copyRects[i].width();
-		int nCrHeight = copyRects[i].height();
-		int nCrTop = copyRects[i].top() - sourceBufferRect.top();
-		int nCrLeft = copyRects[i].left() - sourceBufferRect.left();
-		int nBrTop = copyRects[i].top();
-		int nBrLeft = copyRects[i].left();
+		return false;
+	}
+	const Vector2i vSize = SurfacePool::GetTextureSize(pTextureBuffer);
+	return (vSize == (m_pSurfacePool ? SurfacePool::GetBucketSize(Vector2i(nWidth, nHeight)) : Vector2i(nWidth, nHeight)));
+}
+
 
-		for(int nCrHeightIndex = 0; nCrHeightIndex < nCrHeight; nCrHeightIndex++)
+uint8 *SRPWindow::GetPaintBuffer()
+{
+	if (m_psWindowsData->bZeroCopy)
+	{
+		uint8 *pStagingBuffer = m_pTextureUploader->MapStaging(m_vRenderSize.x, m_vRenderSize.y);
+		if (pStagingBuffer)
 		{
-			int nStartPosition = (nWidth - nBrLeft) * nBrTop + (nBrTop * nBrLeft) + nBrLeft + (nWidth * nCrHeightIndex);
-			MemoryManager::Copy(
-				&pImageBuffer[nStartPosition * 4],
-				sourceBuffer + (nCrLeft + (nCrHeightIndex + nCrTop) * sourceBufferRect.width()) * 4,
-				nCrWidth * 4
-				);
+			return pStagingBuffer;
 		}
+
+		// no mapped memory, back to the image buffer
+		DebugToConsole("Staging buffer could not be mapped, leaving zero copy mode\n");
+		SetZeroCopy(false);
+	}
+	return m_cImage.GetBuffer()->GetData();
+}
+
+
+void SRPWindow::BufferQueueUpload()
+{
+	// a full upload covers everything that is pending
+	m_cPendingDamage.SetSize(m_vRenderSize.x, m_vRenderSize.y);
+	m_cPendingDamage.AddFull();
+}
+
+
+void SRPWindow::BufferQueueUpload(size_t numCopyRects, const Berkelium::Rect *copyRects)
+{
+	// merged rects may only cover painted pixels when the upload source is not valid everywhere,
+	// that is the staging buffer or an image outdated by a scroll on the GPU
+	m_cPendingDamage.SetSize(m_vRenderSize.x, m_vRenderSize.y);
+	m_cPendingDamage.SetCallCost(m_psWindowsData->nUploadCallCost);
+	m_cPendingDamage.SetExact(m_psWindowsData->bZeroCopy || m_bImageOutdated);
+
+	const size_t nNumOfAdded = m_cPendingDamage.Add(numCopyRects, copyRects);
+	if (nNumOfAdded < numCopyRects)
+	{
+		// too fragmented to merge exactly, upload what we have including the rest of this paint
+		BufferFlushUpload();
+		BufferUploadToGPU(numCopyRects - nNumOfAdded, &copyRects[nNumOfAdded]);
+		InvalidateComposite();
+		m_sStats.nUploads++;
 	}
 }
 
 
+void SRPWindow::BufferFlushUpload()
+{
+	if (m_cPendingDamage.IsFull())
+	{
+		m_cPendingDamage.Clear();
+		BufferUploadToGPU();
+		InvalidateComposite();
+		m_sStats.nUploads++;
+	}
+	else if (!m_cPendingDamage.IsEmpty())
+	{
+		BufferUploadToGPU(m_cPendingDamage.GetNumOfRects(), m_cPendingDamage.GetRects());
+		m_cPendingDamage.Clear();
+		InvalidateComposite();
+		m_sStats.nUploads++;
+	}
+}
+
+
+void SRPWindow::InvalidateComposite() const
+{
+	if (m_pCompositor)
+	{
+		m_pCompositor->Invalidate(CompositeDirtyUpload);
+	}
+}
+
+
+void SRPWindow::InvalidateHitTest() const
+{
+	if (m_pHitTestIndex)
+	{
+		m_pHitTestIndex->Invalidate();
+	}
+}
+
+
+void SRPWindow::UpdateSuspension()
+{
+	const bool bSuspended = !m_psWindowsData->bIsVisable;
+	if (m_bSuspended != bSuspended)
+	{
+		m_bSuspended = bSuspended;
+		if (!bSuspended && m_bPaintsDropped && m_pBerkeliumWindow)
+		{
+			// setting the background invalidates the whole view, so berkelium paints it again in full
+			m_bPaintsDropped = false;
+			m_pBerkeliumWindow->setTransparent(m_psWindowsData->bTransparent);
+			m_sStats.nResyncs++;
+		}
+	}
+}
+
+
+void SRPWindow::UpdateWindowQuad()
+{
+	const Vector2i vSize = GetSize();
+
+	if (vSize.x == m_psWindowsData->nFrameWidth && vSize.y == m_psWindowsData->nFrameHeight)
+	{
+		// the rendered content covers the frame size, upscaled if the render scale is below 1
+		m_vQuadSize = Vector2(float(m_psWindowsData->nFrameWidth), float(m_psWindowsData->nFrameHeight));
+		GetTextureCoordinates(m_pTextureBuffer, m_vRenderSize.x, m_vRenderSize.y, m_vQuadTextureCoordinateScale, m_vQuadTextureCoordinateOffset);
+	}
+	else if (m_psWindowsData->bResizeStretch)
+	{
+		// the current content is stretched over the displayed size
+		m_vQuadSize = Vector2(float(vSize.x), float(vSize.y));
+		GetTextureCoordinates(m_pTextureBuffer, m_vRenderSize.x, m_vRenderSize.y, m_vQuadTextureCoordinateScale, m_vQuadTextureCoordinateOffset);
+	}
+	else
+	{
+		// the current content is cropped to the displayed size, there is nothing to show beyond the frame size
+		const int nWidth = (vSize.x < m_psWindowsData->nFrameWidth) ? vSize.x : m_psWindowsData->nFrameWidth;
+		const int nHeight = (vSize.y < m_psWindowsData->nFrameHeight) ? vSize.y : m_psWindowsData->nFrameHeight;
+		m_vQuadSize = Vector2(float(nWidth), float(nHeight));
+		GetTextureCoordinates(m_pTextureBuffer, nWidth*m_vRenderSize.x/m_psWindowsData->nFrameWidth, nHeight*m_vRenderSize.y/m_psWindowsData->nFrameHeight, m_vQuadTextureCoordinateScale, m_vQuadTextureCoordinateOffset);
+	}
+
+	// the displayed size is where the window takes the mouse
+	InvalidateHitTest();
+}
+
+
+void SRPWindow::TransformQuad(const Vector2 &vPosition, const Vector2 &vSize, Vector2 &vDrawPosition, Vector2 &vDrawSize) const
+{
+	const float fScale = m_psWindowsData->fScale;
+	if (fScale == 1.0f)
+	{
+		vDrawPosition = vPosition + m_psWindowsData->vTranslation;
+		vDrawSize = vSize;
+	}
+	else
+	{
+		// scale around the center of the window quad
+		const Vector2 vCenter = Vector2(float(m_psWindowsData->nXPos), float(m_psWindowsData->nYPos)) + m_vQuadSize*0.5f;
+		vDrawPosition = vCenter + (vPosition - vCenter)*fScale + m_psWindowsData->vTranslation;
+		vDrawSize = vSize*fScale;
+	}
+}
+
+
+void SRPWindow::BufferCopyScroll(PLCore::uint8 *pImageBuffer, int &nWidth, int &nHeight, const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, size_t numCopyRects, const Berkelium::Rect *copyRects, int dx, int dy, const Berkelium::Rect &scrollRect)
+{
+	// move the shared region of the scroll rect in place
+	BufferCopy::ScrollRect(pImageBuffer, nWidth, nHeight, dx, dy, scrollRect);
+
+	// new data for scrolling
+	BufferCopyRects(pImageBuffer, nWidth, nHeight, sourceBuffer, sourceBufferRect, numCopyRects, copyRects);
+}
+
+
+void SRPWindow::UpdateAlphaMask(const unsigned char *sourceBuffer, const Berkelium::Rect &sourceBufferRect, size_t numCopyRects, const Berkelium::Rect *copyRects, int dx, int dy, const Berkelium::Rect &scrollRect)
+{
+	if (!m_psWindowsData->bClickThrough)
+	{
+		return;
+	}
+
+	// a resize clears the mask, it is valid again with the full paint at the new size
+	m_cAlphaMask.SetSize(m_vRenderSize.x, m_vRenderSize.y);
+	if (sourceBufferRect.width() == m_vRenderSize.x && sourceBufferRect.height() == m_vRenderSize.y)
+	{
+		m_cAlphaMask.Update(sourceBuffer, sourceBufferRect, 1, &sourceBufferRect);
+	}
+	else
+	{
+		// the scrolled blocks move along, the exposed ones come with the copy rects
+		if (dx != 0 || dy != 0)
+		{
+			m_cAlphaMask.Scroll(dx, dy, scrollRect);
+		}
+		m_cAlphaMask.Update(sourceBuffer, sourceBufferRect, numCopyRects, copyRects);
+	}
+}
+
+
+bool SRPWindow::BufferScrollOnGPU(int dx, int dy, const Berkelium::Rect &scrollRect)
+{
+	// pending damage has to be in the texture before its content is moved
+	BufferFlushUpload();
+
+	// the blit goes through the window shader, it has to be a plain copy
+	if (!m_bInitialized || !m_bReadyToDraw || !m_psWindowsData->bSwizzleOnCopy)
+	{
+		return false;
+	}
+
+	// the pass is compared with the CPU scroll once before it touches the content of the window
+	if (!m_bScrollOnGPUChecked)
+	{
+		m_bScrollOnGPUChecked = true;
+		m_bScrollOnGPUWorks = VerifyScrollOnGPU();
+		if (!m_bScrollOnGPUWorks)
+		{
+			DebugToConsole("Scroll on the GPU does not match the CPU scroll, scrolling on the CPU\n");
+		}
+	}
+	if (!m_bScrollOnGPUWorks || !ScrollTextureOnGPU(m_pTextureBuffer, dx, dy, scrollRect))
+	{
+		return false;
+	}
+
+	// the image buffer was not scrolled
+	m_bImageOutdated = true;
+	InvalidateComposite();
+	return true;
+}
+
+
+bool SRPWindow::VerifyScrollOnGPU()
+{
+	// a scroll up and to the right, rows in the wrong order or the wrong place show up at once
+	const int nWidth = m_vRenderSize.x;
+	const int nHeight = m_vRenderSize.y;
+	const int dx = 3;
+	const int dy = -5;
+	if (nWidth < 16 || nHeight < 16)
+	{
+		// too small to tell, the CPU scrolls
+		return false;
+	}
+	Berkelium::Rect cScrollRect;
+	cScrollRect.mLeft   = 2;
+	cScrollRect.mTop    = 1;
+	cScrollRect.mWidth  = nWidth - 4;
+	cScrollRect.mHeight = nHeight - 2;
+
+	TextureBuffer *pTextureBuffer = CreateSurfaceTexture(nWidth, nHeight);
+	if (!pTextureBuffer)
+	{
+		return false;
+	}
+
+	// every pixel holds its own position
+	const uint32 nSize = uint32(nWidth) * uint32(nHeight) * 4;
+	uint8 *pExpected = new uint8[nSize];
+	uint8 *pResult = new uint8[nSize];
+	for (int y = 0; y < nHeight; y++)
+	{
+		for (int x = 0; x < nWidth; x++)
+		{
+			uint8 *pPixel = pExpected + (size_t(y) * nWidth + x) * 4;
+			pPixel[0] = uint8(x);
+			pPixel[1] = uint8(y);
+			pPixel[2] = uint8(((x >> 8) & 0x0F) | ((y >> 4) & 0xF0));
+			pPixel[3] = 255;
+		}
+	}
+
+	bool bResult = false;
+	if (m_pTextureUploader->UploadFull(pTextureBuffer, pExpected, nWidth, nHeight) && ScrollTextureOnGPU(pTextureBuffer, dx, dy, cScrollRect) &&
+		m_pTextureUploader->DownloadFull(pTextureBuffer, pResult, nWidth, nHeight))
+	{
+		// the exposed pixels keep their old content on both sides, so the whole image has to match
+		BufferCopy::ScrollRect(pExpected, nWidth, nHeight, dx, dy, cScrollRect);
+		bResult = (MemoryManager::Compare(pExpected, pResult, nSize) == 0);
+	}
+
+	delete [] pExpected;
+	delete [] pResult;
+	DestroySurfaceTexture(pTextureBuffer);
+	return bResult;
+}
+
+
+bool SRPWindow::ScrollTextureOnGPU(TextureBuffer *pTextureBuffer, int dx, int dy, const Berkelium::Rect &scrollRect)
+{
+	const int nWidth = m_vRenderSize.x;
+	const int nHeight = m_vRenderSize.y;
+
+	// get the part of the scroll rect that stays visible after the move, in source coordinates
+	const Berkelium::Rect cClipped = TextureUploader::ClipRect(scrollRect, nWidth, nHeight);
+	const int nLeft   = dx < 0 ? cClipped.left() - dx : cClipped.left();
+	const int nTop    = dy < 0 ? cClipped.top()  - dy : cClipped.top();
+	const int nRight  = dx > 0 ? cClipped.right()  - dx : cClipped.right();
+	const int nBottom = dy > 0 ? cClipped.bottom() - dy : cClipped.bottom();
+	if (nRight <= nLeft || nBottom <= nTop)
+	{
+		// everything has been scrolled out, the copy rects cover the rest
+		return true;
+	}
+	const int nSharedWidth = nRight - nLeft;
+	const int nSharedHeight = nBottom - nTop;
+
+	// (re)create the scratch render target at window size
+	if (m_pScrollSurface && m_pScrollSurface->GetSize() != Vector2i(nWidth, nHeight))
+	{
+		delete m_pScrollSurface;
+		m_pScrollSurface = nullptr;
+	}
+	if (!m_pScrollSurface)
+	{
+		m_pScrollSurface = m_pCurrentRenderer->CreateSurfaceTextureBuffer2D(Vector2i(nWidth, nHeight), TextureBuffer::R8G8B8A8, SurfaceTextureBuffer::NoMultisampleAntialiasing);
+		if (!m_pScrollSurface)
+		{
+			return false;
+		}
+	}
+
+	// the quad covers the shared size at the origin of the scratch target and samples the shared region of the texture
+	// (a pooled texture can be larger than the window)
+	const Vector2i vTextureSize = SurfacePool::GetTextureSize(pTextureBuffer);
+	if (vTextureSize.x < nWidth || vTextureSize.y < nHeight)
+	{
+		return false;
+	}
+	const Vector2 vTextureCoordinateOffset(float(nLeft) / float(vTextureSize.x), float(nTop) / float(vTextureSize.y));
+	const Vector2 vTextureCoordinateScale(float(nSharedWidth) / float(vTextureSize.x), float(nSharedHeight) / float(vTextureSize.y));
+
+	// remember the renderer states we are going to change
+	Surface *pPreviousRenderTarget = m_pCurrentRenderer->GetRenderTarget();
+	const Rectangle cPreviousViewport = m_pCurrentRenderer->GetViewport();
+	const uint32 nPreviousBlendEnable = m_pCurrentRenderer->GetRenderState(RenderState::BlendEnable);
+
+	bool bResult = false;
+	if (m_pCurrentRenderer->SetRenderTarget(m_pScrollSurface))
+	{
+		m_pCurrentRenderer->SetRenderState(RenderState::BlendEnable, false);
+		m_pCurrentRenderer->SetProgram(m_pProgramWrapper);
+
+		// unlike DrawWindow() map the quad bottom up, render target row 0 then holds the first shared texture row and the
+		// copy back reads the rows from the origin in texture order
+		Matrix4x4 mObjectSpaceToClipSpace;
+		mObjectSpaceToClipSpace.OrthoOffCenter(0.0f, float(nWidth), float(nHeight), 0.0f, -1.0f, 1.0f);
+		ProgramUniform *pProgramUniform = m_pProgramWrapper->GetUniform("ObjectSpaceToClipSpaceMatrix");
+		if (pProgramUniform)
+			pProgramUniform->Set(mObjectSpaceToClipSpace);
+
+		const int nTextureUnit = m_pProgramWrapper->Set("TextureMap", pTextureBuffer);
+		if (nTextureUnit >= 0)
+		{
+			// set sampler states
+			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::AddressU, TextureAddressing::Clamp);
+			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::AddressV, TextureAddressing::Clamp);
+			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MagFilter, TextureFiltering::None);
+			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MinFilter, TextureFiltering::None);
+			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MipFilter, TextureFiltering::None);
+		}
+
+		// place the unit quad
+		ProgramCache::SetQuad(*m_pProgramWrapper, Vector2::Zero, Vector2(float(nSharedWidth), float(nSharedHeight)), vTextureCoordinateScale, vTextureCoordinateOffset);
+
+		// set vertex attributes
+		m_pProgramWrapper->Set("VertexPosition", m_pVertexBuffer, VertexBuffer::Position);
+		m_pProgramWrapper->Set("VertexTexCoord", m_pVertexBuffer, VertexBuffer::TexCoord);
+
+		// ping: draw the shared region into the scratch target
+		m_pCurrentRenderer->DrawPrimitives(Primitive::TriangleStrip, 0, 4);
+
+		// pong: copy it back into the window texture at the scrolled position
+		bResult = m_pTextureUploader->CopyFromRenderTarget(pTextureBuffer, nLeft + dx, nTop + dy, 0, 0, nSharedWidth, nSharedHeight);
+	}
+
+	// restore the renderer states
+	m_pCurrentRenderer->SetRenderTarget(pPreviousRenderTarget);
+	m_pCurrentRenderer->SetViewport(&cPreviousViewport);
+	m_pCurrentRenderer->SetRenderState(RenderState::BlendEnable, nPreviousBlendEnable);
+
+	return bResult;
+}
+
+
+void SRPWindow::SyncImageFromGPU() const
+{
+	if (m_bImageOutdated && m_pTextureBuffer && nullptr != m_cImage.GetBuffer())
+	{
+		// read the texture back, it holds the only valid copy of the window content
+		if (m_pTextureUploader->DownloadFull(m_pTextureBuffer, m_cImage.GetBuffer()->GetData(), m_vRenderSize.x, m_vRenderSize.y))
+		{
+			m_bImageOutdated = false;
+		}
+	}
+}
+
+
 void SRPWindow::onLoad(Berkelium::Window *win)
 {
 	m_psWindowsData->bLoaded = true;
@@ -584,11 +1068,17 @@ void SRPWindow::onLoadingStateChanged(Berkelium::Window *win, bool isLoading)
 
 void SRPWindow::MoveToFront()
 {
-	if (m_bInitialized && m_pCurrentSceneRenderer)
+	if (m_bInitialized && m_pCompositor)
+	{
+		// move the window to front within the compositor
+		m_pCompositor->MoveToFront(this);
+	}
+	else if (m_bInitialized && m_pCurrentSceneRenderer)
 	{
 		// move scene render pass to front
 		m_pCurrentSceneRenderer->MoveElement(m_pCurrentSceneRenderer->GetIndex(*reinterpret_cast<SceneRendererPass*>(this)), m_pCurrentSceneRenderer->GetNumOfElements() - 1);
 	}
+	InvalidateHitTest();
 }
 
 
@@ -685,84 +1175,241 @@ void SRPWindow::DestroyContext()
 
 Berkelium::Window *SRPWindow::GetBerkeliumWindow() const
 {
-	return m_pBerkeliumWindow;
+	return m_pBerkeliumWindow;
+}
+
+
+sWindowsData *SRPWindow::GetData() const
+{
+	return m_psWindowsData;
+}
+
+
+String SRPWindow::GetName() const
+{
+	return m_sWindowName;
+}
+
+
+void SRPWindow::DestroyBerkeliumWindow()
+{
+	if (m_pBerkeliumWindow)
+	{
+		// stop window navigation
+		m_pBerkeliumWindow->stop();
+		// unfocus window
+		m_pBerkeliumWindow->unfocus();
+		// destroy window
+		m_pBerkeliumWindow->destroy();
+		// set nullptr
+		m_pBerkeliumWindow = nullptr;
+	}
+}
+
+
+void SRPWindow::SetWindowSettings()
+{
+	m_pBerkeliumWindow->resize(m_vRenderSize.x, m_vRenderSize.y);
+	m_pBerkeliumWindow->setTransparent(m_psWindowsData->bTransparent);
+	m_pBerkeliumWindow->setDelegate(this);
+	m_pBerkeliumWindow->navigateTo(m_psWindowsData->sUrl.GetASCII(), m_psWindowsData->sUrl.GetLength());
+}
+
+
+Vector2i SRPWindow::GetPosition() const
+{
+	if (m_psWindowsData->nXPos && m_psWindowsData->nYPos)
+	{
+		// return the position of the window
+		return Vector2i(m_psWindowsData->nXPos, m_psWindowsData->nYPos);
+	}
+	else
+	{
+		return Vector2i::NegativeOne;
+	}
+}
+
+
+Vector2i SRPWindow::GetSize() const
+{
+	if (IsResizePending())
+	{
+		// return the previewed size, the page follows when the resize is committed
+		return m_vPreviewSize;
+	}
+	else if (m_vResizeSize != Vector2i::Zero)
+	{
+		// return the size berkelium was asked for, the page follows with its next paint
+		return m_vResizeSize;
+	}
+	else if (m_psWindowsData->nFrameWidth && m_psWindowsData->nFrameHeight)
+	{
+		// return the size of the window
+		return Vector2i(m_psWindowsData->nFrameWidth, m_psWindowsData->nFrameHeight);
+	}
+	else
+	{
+		return Vector2i::NegativeOne;
+	}
+}
+
+
+Vector2i SRPWindow::GetRelativeMousePosition(const Vector2i &vMousePos) const
+{
+	// berkelium takes the mouse in rendered pixels
+	const Vector2i vPosition = GetRelativeMousePositionOnScreen(vMousePos);
+	if (m_psWindowsData->fRenderScale == 1.0f)
+	{
+		return vPosition;
+	}
+	return Vector2i(int(float(vPosition.x)*m_psWindowsData->fRenderScale), int(float(vPosition.y)*m_psWindowsData->fRenderScale));
+}
+
+
+Vector2i SRPWindow::GetRelativeMousePositionOnScreen(const Vector2i &vMousePos) const
+{
+	return Vector2i(vMousePos.x - m_psWindowsData->nXPos, vMousePos.y - m_psWindowsData->nYPos);
+}
+
+
+void SRPWindow::SetRenderScale(const float &fRenderScale)
+{
+	const float fClamped = (fRenderScale < MINRENDERSCALE) ? MINRENDERSCALE : ((fRenderScale > 1.0f) ? 1.0f : fRenderScale);
+	if (m_psWindowsData->fRenderScale == fClamped)
+	{
+		return;
+	}
+	m_psWindowsData->fRenderScale = fClamped;
+
+	if (m_bInitialized)
+	{
+		// the page is resized to the scaled size like on a resize of the window, the old content is stretched
+		// over the window until berkelium painted the new size (see ApplyResize())
+		const Vector2i vSize = GetSize();
+		const Vector2i vRenderSize = ToRenderSize(vSize);
+		if (vRenderSize == m_vRenderSize && m_vResizeSize == Vector2i::Zero)
+		{
+			// rounds to the rendered size, nothing to repaint
+			UpdateWindowQuad();
+			return;
+		}
+		m_vPreviewSize = Vector2i::Zero;
+		m_vResizeSize = vSize;
+		m_sStats.nResizes++;
+		UpdateWindowQuad();
+		GetBerkeliumWindow()->resize(vRenderSize.x, vRenderSize.y);
+	}
+}
+
+
+float SRPWindow::GetRenderScale() const
+{
+	return m_psWindowsData->fRenderScale;
+}
+
+
+Vector2i SRPWindow::GetRenderSize() const
+{
+	return m_vRenderSize;
 }
 
 
-sWindowsData *SRPWindow::GetData() const
+void SRPWindow::SetClickThrough(const bool &bClickThrough)
 {
-	return m_psWindowsData;
+	if (m_psWindowsData->bClickThrough == bClickThrough)
+	{
+		return;
+	}
+	m_psWindowsData->bClickThrough = bClickThrough;
+
+	m_cAlphaMask.SetSize(m_vRenderSize.x, m_vRenderSize.y);
+	m_cAlphaMask.Clear();
+	if (bClickThrough && !m_psWindowsData->bZeroCopy && nullptr != m_cImage.GetBuffer())
+	{
+		// build the mask once from the image, the paints keep it up to date afterwards
+		SyncImageFromGPU();
+		if (!m_bImageOutdated)
+		{
+			Berkelium::Rect cFullRect;
+			cFullRect.mLeft   = 0;
+			cFullRect.mTop    = 0;
+			cFullRect.mWidth  = m_vRenderSize.x;
+			cFullRect.mHeight = m_vRenderSize.y;
+			m_cAlphaMask.Update(m_cImage.GetBuffer()->GetData(), cFullRect, 1, &cFullRect);
+		}
+	}
+
+	// the index takes the mask with the next rebuild
+	InvalidateHitTest();
 }
 
 
-String SRPWindow::GetName() const
+const AlphaMask *SRPWindow::GetAlphaMask() const
 {
-	return m_sWindowName;
+	return m_psWindowsData->bClickThrough ? &m_cAlphaMask : nullptr;
 }
 
 
-void SRPWindow::DestroyBerkeliumWindow()
+Vector2i SRPWindow::ToRenderSize(const Vector2i &vSize) const
 {
-	if (m_pBerkeliumWindow)
+	if (m_psWindowsData->fRenderScale == 1.0f)
 	{
-		// stop window navigation
-		m_pBerkeliumWindow->stop();
-		// unfocus window
-		m_pBerkeliumWindow->unfocus();
-		// destroy window
-		m_pBerkeliumWindow->destroy();
-		// set nullptr
-		m_pBerkeliumWindow = nullptr;
+		return vSize;
 	}
+
+	// at least one pixel
+	const int nWidth = int(float(vSize.x)*m_psWindowsData->fRenderScale + 0.5f);
+	const int nHeight = int(float(vSize.y)*m_psWindowsData->fRenderScale + 0.5f);
+	return Vector2i((nWidth > 0) ? nWidth : 1, (nHeight > 0) ? nHeight : 1);
 }
 
 
-void SRPWindow::SetWindowSettings()
+TextureFiltering::Enum SRPWindow::GetTextureFiltering() const
 {
-	m_pBerkeliumWindow->resize(m_psWindowsData->nFrameWidth, m_psWindowsData->nFrameHeight);
-	m_pBerkeliumWindow->setTransparent(m_psWindowsData->bTransparent);
-	m_pBerkeliumWindow->setDelegate(this);
-	m_pBerkeliumWindow->navigateTo(m_psWindowsData->sUrl.GetASCII(), m_psWindowsData->sUrl.GetLength());
+	// rendered at full size the texels map to the pixels, else the texture is upscaled
+	return (m_psWindowsData->fRenderScale == 1.0f) ? TextureFiltering::None : TextureFiltering::Linear;
 }
 
 
-Vector2i SRPWindow::GetPosition() const
+void SRPWindow::GetTextureCoordinates(TextureBuffer *pTextureBuffer, const int &nWidth, const int &nHeight, Vector2 &vScale, Vector2 &vOffset) const
 {
-	if (m_psWindowsData->nXPos && m_psWindowsData->nYPos)
-	{
-		// return the position of the window
-		return Vector2i(m_psWindowsData->nXPos, m_psWindowsData->nYPos);
-	}
-	else
+	vScale = SurfacePool::GetTextureCoordinateScale(pTextureBuffer, nWidth, nHeight);
+	vOffset = Vector2::Zero;
+	if (GetTextureFiltering() == TextureFiltering::None)
 	{
-		return Vector2i::NegativeOne;
+		return;
 	}
-}
-
 
-Vector2i SRPWindow::GetSize() const
-{
-	if (m_psWindowsData->nFrameWidth && m_psWindowsData->nFrameHeight)
+	// a linear filter blends the outermost texels with their neighbours, in a pooled texture those are unused padding,
+	// so the quad samples from the center of the first to the center of the last used texel
+	const Vector2i vSize = SurfacePool::GetTextureSize(pTextureBuffer);
+	if (vSize.x > 0 && nWidth > 1)
 	{
-		// return the size of the window
-		return Vector2i(m_psWindowsData->nFrameWidth, m_psWindowsData->nFrameHeight);
+		vOffset.x = 0.5f / float(vSize.x);
+		vScale.x = float(nWidth - 1) / float(vSize.x);
 	}
-	else
+	if (vSize.y > 0 && nHeight > 1)
 	{
-		return Vector2i::NegativeOne;
+		vOffset.y = 0.5f / float(vSize.y);
+		vScale.y = float(nHeight - 1) / float(vSize.y);
 	}
 }
 
 
-Vector2i SRPWindow::GetRelativeMousePosition(const Vector2i &vMousePos) const
+Vector2 SRPWindow::GetWidgetQuadSize(const sWidget *psWidget) const
 {
-	return Vector2i(vMousePos.x - m_psWindowsData->nXPos, vMousePos.y - m_psWindowsData->nYPos);
+	return Vector2(float(psWidget->nWidth), float(psWidget->nHeight))*(1.0f/m_psWindowsData->fRenderScale);
 }
 
 
 int SRPWindow::GetSceneRenderPassIndex()
 {
-	if (m_pCurrentSceneRenderer)
+	if (m_pCompositor)
+	{
+		// return the z-order index within the compositor
+		return m_pCompositor->GetIndex(this);
+	}
+	else if (m_pCurrentSceneRenderer)
 	{
 		// return scene render pass index
 		return m_pCurrentSceneRenderer->GetIndex(*reinterpret_cast<SceneRendererPass*>(this));
@@ -795,6 +1442,7 @@ void SRPWindow::onJavascriptCallback(Berkelium::Window *win, void *replyMsg, Ber
 	pCallBack->OriginUrl = origin;
 	pCallBack->pReplyMsg = replyMsg;
 	pCallBack->pParameters = args;
+	pCallBack->nNumOfNumbers = 0;
 
 	String sParams = "";
 
@@ -819,6 +1467,13 @@ void SRPWindow::onJavascriptCallback(Berkelium::Window *win, void *replyMsg, Ber
 		{
 			// double
 			sParams = sParams + "Param" + String(i) + "=" + String(jsonStr.data()) + " ";
+
+			// the leading numbers are kept for the default callbacks, the arguments are gone after this call
+			if (pCallBack->nNumOfNumbers == i && i < MAXCALLBACKNUMBERS)
+			{
+				pCallBack->fNumbers[i] = args[i].toDouble();
+				pCallBack->nNumOfNumbers++;
+			}
 		}
 		else
 		{
@@ -863,7 +1518,10 @@ void SRPWindow::onJavascriptCallback(Berkelium::Window *win, void *replyMsg, Ber
 	if (pCallBack->sFunctionName == DRAGWINDOW ||
 		pCallBack->sFunctionName == HIDEWINDOW ||
 		pCallBack->sFunctionName == CLOSEWINDOW ||
-		pCallBack->sFunctionName == RESIZEWINDOW)
+		pCallBack->sFunctionName == RESIZEWINDOW ||
+		pCallBack->sFunctionName == FADEWINDOW ||
+		pCallBack->sFunctionName == SLIDEWINDOW ||
+		pCallBack->sFunctionName == SCALEWINDOW)
 	{
 		// add the callback to the hashmap so that the Gui class can process it
 		m_pmapDefaultCallBacks->Add(pCallBack->sFunctionName, pCallBack);
@@ -884,9 +1542,10 @@ void SRPWindow::MoveWindow(const int &nX, const int &nY)
 {
 	//question: [10-07-2012 Icefire] i am not sure yet if this method is right for this use case
 
+	// the position is a program uniform, there is nothing else to update
 	m_psWindowsData->nXPos = nX;
 	m_psWindowsData->nYPos = nY;
-	UpdateVertexBuffer(m_pVertexBuffer, Vector2(float(nX), float(nY)), Vector2(float(m_psWindowsData->nFrameWidth), float(m_psWindowsData->nFrameHeight)));
+	InvalidateHitTest();
 }
 
 
@@ -913,6 +1572,11 @@ void SRPWindow::SetupToolTipWindow()
 
 	// create tool tip window and set data
 	m_pToolTip = new SRPWindow("ToolTip");
+	m_pToolTip->SetCopyWorkerPool(m_pCopyWorkerPool);
+	m_pToolTip->SetSurfacePool(m_pSurfacePool);
+	m_pToolTip->SetCompositor(m_pCompositor);
+	m_pToolTip->SetProgramCache(m_pProgramCache);
+	m_pToolTip->SetWindowAnimator(m_pWindowAnimator);
 	m_pToolTip->GetData()->bIsVisable = false;
 	m_pToolTip->GetData()->sUrl = "file:///D:/plice/PLMain/Code/GameClient/bin/tooltip.html";
 	m_pToolTip->GetData()->nFrameWidth = 512;
@@ -957,10 +1621,17 @@ void SRPWindow::SetToolTip(const String &sText)
 
 	if (m_pToolTip)
 	{
+		// the fades run on the GPU with the opacity of the tool tip, only a new text repaints the page
 		if (sText == "")
 		{
-			m_pToolTip->GetBerkeliumWindow()->executeJavascript(Berkelium::WideString::point_to(String("fadeEffect(1, 0, 5);").GetUnicode()));
-			m_pToolTip->GetData()->bIsVisable = false;
+			if (m_pWindowAnimator && m_pToolTip->GetData()->bIsVisable)
+			{
+				m_pWindowAnimator->Animate(m_pToolTip, TweenOpacity, Vector2::Zero, TOOLTIPFADEOUTTIME, EasingLinear, true);
+			}
+			else
+			{
+				m_pToolTip->SetVisible(false);
+			}
 		}
 		else
 		{
@@ -968,8 +1639,20 @@ void SRPWindow::SetToolTip(const String &sText)
 			m_pToolTip->MoveWindow(cFrontend.GetMousePositionX() + 10, cFrontend.GetMousePositionY() + 6);
 			m_pToolTip->GetBerkeliumWindow()->executeJavascript(Berkelium::WideString::point_to(String("SetToolTip('" + sText + "')").GetUnicode()));
 			m_pToolTip->MoveToFront();
-			m_pToolTip->GetData()->bIsVisable = true;
-			m_pToolTip->GetBerkeliumWindow()->executeJavascript(Berkelium::WideString::point_to(String("fadeEffect(0, 1, 15);").GetUnicode()));
+			if (m_pWindowAnimator)
+			{
+				// a hidden tool tip fades in from nothing, one that is fading out fades back in from where it is
+				if (!m_pToolTip->GetData()->bIsVisable)
+				{
+					m_pToolTip->GetData()->fOpacity = 0.0f;
+				}
+				m_pToolTip->SetVisible(true);
+				m_pWindowAnimator->Animate(m_pToolTip, TweenOpacity, Vector2(1.0f, 0.0f), TOOLTIPFADEINTIME, EasingLinear);
+			}
+			else
+			{
+				m_pToolTip->SetVisible(true);
+			}
 		}
 	}
 }
@@ -1021,32 +1704,114 @@ sCallBack *SRPWindow::GetCallBack(const String &sKey) const
 
 void SRPWindow::ResizeWindow(const int &nWidth, const int &nHeight)
 {
-	//fix: [10-07-2012 Icefire] let (re)sizing be handled by the program uniform, see http://dev.pixellight.org/forum/viewtopic.php?f=6&t=503
-	// buffer overflows on resize happen to often to accept the current method as is
+	// a real resize replaces any preview
+	m_vPreviewSize = Vector2i::Zero;
 
-	m_bIgnoreBufferUpdate = true;
+	if (m_vResizeSize == Vector2i::Zero && nWidth == m_psWindowsData->nFrameWidth && nHeight == m_psWindowsData->nFrameHeight)
+	{
+		// nothing to resize
+		UpdateWindowQuad();
+		return;
+	}
 
-	m_psWindowsData->bNeedsFullUpdate = true;
+	// the image and texture keep the old size until berkelium paints the new size, the old content is shown
+	// at the new size until then (see ApplyResize()), so the window is never drawn with an undefined texture
+	m_vResizeSize = Vector2i(nWidth, nHeight);
+	m_sStats.nResizes++;
+	UpdateWindowQuad();
+
+	const Vector2i vRenderSize = ToRenderSize(m_vResizeSize);
+	GetBerkeliumWindow()->resize(vRenderSize.x, vRenderSize.y);
+}
+
+
+void SRPWindow::ApplyResize()
+{
+	m_psWindowsData->nFrameWidth = m_vResizeSize.x;
+	m_psWindowsData->nFrameHeight = m_vResizeSize.y;
+	m_vRenderSize = ToRenderSize(m_vResizeSize);
+	m_vResizeSize = Vector2i::Zero;
 
+	// the image is not used in zero copy mode
+	m_cImage = m_psWindowsData->bZeroCopy ? Image() : Image::CreateImage(DataByte, ColorRGBA, Vector3i(m_vRenderSize.x, m_vRenderSize.y, 1));
+	m_bImageOutdated = false;
+	// pending damage belongs to the old size, the full update replaces it
+	m_cPendingDamage.Clear();
+
+	// a resize within the bucket of the texture keeps the texture
+	if (!IsSurfaceTextureFitting(m_pTextureBuffer, m_vRenderSize.x, m_vRenderSize.y))
+	{
+		if (nullptr != m_pTextureBuffer)
+		{
+			DestroySurfaceTexture(m_pTextureBuffer);
+		}
+		m_pTextureBuffer = CreateSurfaceTexture(m_vRenderSize.x, m_vRenderSize.y);
+	}
+
+	// the paint that brought the new size fills the texture, it is uploaded before the next draw
+	m_psWindowsData->bNeedsFullUpdate = true;
 	m_bReadyToDraw = false;
+	UpdateWindowQuad();
+}
 
-	m_psWindowsData->nFrameWidth = nWidth;
-	m_psWindowsData->nFrameHeight = nHeight;
 
-	m_cImage = Image::CreateImage(DataByte, ColorRGBA, Vector3i(m_psWindowsData->nFrameWidth, m_psWindowsData->nFrameHeight, 1));
-	if (nullptr != m_pTextureBufferNew)
+void SRPWindow::PreviewResize(const int &nWidth, const int &nHeight)
+{
+	if (0 == m_psWindowsData->nResizeIdleTime || !m_bInitialized)
+	{
+		// no preview wanted, resize the page right away
+		ResizeWindow(nWidth, nHeight);
+		return;
+	}
+
+	// only move the quad, the page is resized once the preview rests
+	m_vPreviewSize = Vector2i(nWidth, nHeight);
+	m_nPreviewTime = System::GetInstance()->GetMilliseconds();
+	m_sStats.nResizePreviews++;
+	UpdateWindowQuad();
+}
+
+
+bool SRPWindow::UpdateResize()
+{
+	if (IsResizePending() && System::GetInstance()->GetMilliseconds() - m_nPreviewTime >= m_psWindowsData->nResizeIdleTime)
 	{
-		delete m_pTextureBufferNew;
+		// the preview rested long enough
+		return CommitResize();
+	}
+	return false;
+}
+
+
+bool SRPWindow::CommitResize()
+{
+	if (!IsResizePending())
+	{
+		return false;
 	}
-	m_pTextureBufferNew = reinterpret_cast<TextureBuffer*>(m_pCurrentRenderer->CreateTextureBuffer2D(m_cImage, TextureBuffer::Unknown, 0));
 
-	UpdateVertexBuffer(m_pVertexBuffer, Vector2(float(m_psWindowsData->nXPos), float(m_psWindowsData->nYPos)), Vector2(float(m_psWindowsData->nFrameWidth), float(m_psWindowsData->nFrameHeight)));
+	// a preview that ended where it started does not resize the page
+	ResizeWindow(m_vPreviewSize.x, m_vPreviewSize.y);
+	return true;
+}
+
+
+bool SRPWindow::IsResizePending() const
+{
+	return (m_vPreviewSize != Vector2i::Zero);
+}
 
-	GetBerkeliumWindow()->resize(m_psWindowsData->nFrameWidth, m_psWindowsData->nFrameHeight);
 
-	m_bReadyToDraw = true;
+void SRPWindow::Upload()
+{
+	// resync if the window has just been shown
+	UpdateSuspension();
 
-	m_bIgnoreBufferUpdate = false;
+	// upload everything painted since the last upload, a hidden window keeps collecting damage instead
+	if (!m_bSuspended)
+	{
+		BufferFlushUpload();
+	}
 }
 
 
@@ -1116,6 +1881,10 @@ void SRPWindow::SetDefaultCallBackFunctions()
 	GetBerkeliumWindow()->addBindOnStartLoading(Berkelium::WideString::point_to(String(HIDEWINDOW).GetUnicode()), Berkelium::Script::Variant::bindFunction(Berkelium::WideString::point_to(String(HIDEWINDOW).GetUnicode()), false));
 	GetBerkeliumWindow()->addBindOnStartLoading(Berkelium::WideString::point_to(String(CLOSEWINDOW).GetUnicode()), Berkelium::Script::Variant::bindFunction(Berkelium::WideString::point_to(String(CLOSEWINDOW).GetUnicode()), false));
 	GetBerkeliumWindow()->addBindOnStartLoading(Berkelium::WideString::point_to(String(RESIZEWINDOW).GetUnicode()), Berkelium::Script::Variant::bindFunction(Berkelium::WideString::point_to(String(RESIZEWINDOW).GetUnicode()), false));
+	// the animations run on the GPU, FadeWindow(opacity, ms), SlideWindow(x, y, ms) and ScaleWindow(scale, ms)
+	GetBerkeliumWindow()->addBindOnStartLoading(Berkelium::WideString::point_to(String(FADEWINDOW).GetUnicode()), Berkelium::Script::Variant::bindFunction(Berkelium::WideString::point_to(String(FADEWINDOW).GetUnicode()), false));
+	GetBerkeliumWindow()->addBindOnStartLoading(Berkelium::WideString::point_to(String(SLIDEWINDOW).GetUnicode()), Berkelium::Script::Variant::bindFunction(Berkelium::WideString::point_to(String(SLIDEWINDOW).GetUnicode()), false));
+	GetBerkeliumWindow()->addBindOnStartLoading(Berkelium::WideString::point_to(String(SCALEWINDOW).GetUnicode()), Berkelium::Script::Variant::bindFunction(Berkelium::WideString::point_to(String(SCALEWINDOW).GetUnicode()), false));
 }
 
 
@@ -1124,15 +1893,18 @@ void SRPWindow::onWidgetCreated(Berkelium::Window *win, Berkelium::Widget *newWi
 	// we create the widget
 	sWidget *psWidget = new sWidget;
 
-	// we set the data
+	// we set the data, the texture and size follow with the first resize
+	psWidget->pTextureBuffer = nullptr;
+	psWidget->nWidth = 0;
+	psWidget->nHeight = 0;
 	psWidget->bNeedsFullUpdate = true;
 	psWidget->nXPos = m_psWindowsData->nXPos;
 	psWidget->nYPos = m_psWindowsData->nYPos;
 	psWidget->pProgramWrapper = CreateProgramWrapper();
-	psWidget->pVertexBuffer = CreateVertexBuffer(Vector2::Zero, Vector2::Zero);
 
 	// we add the widget to the hashmap
 	m_pmapWidgets->Add(newWidget, psWidget);
+	InvalidateHitTest();
 }
 
 
@@ -1143,19 +1915,15 @@ void SRPWindow::onWidgetDestroyed(Berkelium::Window *win, Berkelium::Widget *wid
 	if (psWidget)
 	{
 		// delete the resources used by this widget
-		if (nullptr != psWidget->pVertexBuffer)
-		{
-			delete psWidget->pVertexBuffer;
-			psWidget->pVertexBuffer = nullptr;
-		}
 		if (nullptr != psWidget->pTextureBuffer)
 		{
-			delete psWidget->pTextureBuffer;
+			DestroySurfaceTexture(psWidget->pTextureBuffer);
 			psWidget->pTextureBuffer = nullptr;
 		}
 
 		// remove it
 		m_pmapWidgets->Remove(wid);
+		InvalidateHitTest();
 	}
 }
 
@@ -1166,14 +1934,10 @@ void SRPWindow::onWidgetMove(Berkelium::Window *win, Berkelium::Widget *wid, int
 	sWidget *psWidget = m_pmapWidgets->Get(wid);
 	if (psWidget)
 	{
-		// set the new position data
-		psWidget->nXPos = m_psWindowsData->nXPos + newX;
-		psWidget->nYPos = m_psWindowsData->nYPos + newY;
-
-		//todo: [10-07-2012 Icefire] let (re)sizing be handled by the program uniform, see http://dev.pixellight.org/forum/viewtopic.php?f=6&t=503
-
-		// update the buffer
-		UpdateVertexBuffer(psWidget->pVertexBuffer, Vector2(float(psWidget->nXPos), float(psWidget->nYPos)), Vector2(float(psWidget->nWidth), float(psWidget->nHeight)));
+		// set the new position data, berkelium places the widget in rendered pixels
+		psWidget->nXPos = m_psWindowsData->nXPos + int(float(newX)/m_psWindowsData->fRenderScale);
+		psWidget->nYPos = m_psWindowsData->nYPos + int(float(newY)/m_psWindowsData->fRenderScale);
+		InvalidateHitTest();
 	}
 }
 
@@ -1189,33 +1953,33 @@ void SRPWindow::onWidgetPaint(Berkelium::Window *win, Berkelium::Widget *wid, co
 			// awaiting a full update disregard all partials ones until the full comes in
 			uint8 *pImageBuffer = psWidget->cImage.GetBuffer()->GetData();
 			BufferCopyFull(pImageBuffer, psWidget->nWidth, psWidget->nHeight, sourceBuffer, sourceBufferRect);
-			psWidget->pTextureBuffer->CopyDataFrom(0, TextureBuffer::R8G8B8A8, pImageBuffer);
+			WidgetUploadToGPU(psWidget);
 			psWidget->bNeedsFullUpdate = false;
 		}
 		else
 		{
-			if (sourceBufferRect.width() == psWidget->nWidth && sourceBufferRect.height() == psWidget->nWidth)
+			if (sourceBufferRect.width() == psWidget->nWidth && sourceBufferRect.height() == psWidget->nHeight)
 			{
 				// did not suspect a full update but got it anyway, it might happen and is ok
 				uint8 *pImageBuffer = psWidget->cImage.GetBuffer()->GetData();
 				BufferCopyFull(pImageBuffer, psWidget->nWidth, psWidget->nHeight, sourceBuffer, sourceBufferRect);
-				psWidget->pTextureBuffer->CopyDataFrom(0, TextureBuffer::R8G8B8A8, pImageBuffer);
+				WidgetUploadToGPU(psWidget);
 			}
 			else
 			{
 				if (dx != 0 || dy != 0)
 				{
-					// a scroll has taken place
+					// a scroll has taken place, the moved scroll rect and the exposed rects are dirty
 					uint8 *pImageBuffer = psWidget->cImage.GetBuffer()->GetData();
 					BufferCopyScroll(pImageBuffer, psWidget->nWidth, psWidget->nHeight, sourceBuffer, sourceBufferRect, numCopyRects, copyRects, dx, dy, scrollRect);
-					psWidget->pTextureBuffer->CopyDataFrom(0, TextureBuffer::R8G8B8A8, pImageBuffer);
+					WidgetUploadToGPU(psWidget, numCopyRects, copyRects, &scrollRect);
 				}
 				else
 				{
-					// normal partial updates
+					// normal partial updates, only the copy rects are dirty
 					uint8 *pImageBuffer = psWidget->cImage.GetBuffer()->GetData();
 					BufferCopyRects(pImageBuffer, psWidget->nWidth, psWidget->nHeight, sourceBuffer, sourceBufferRect, numCopyRects, copyRects);
-					psWidget->pTextureBuffer->CopyDataFrom(0, TextureBuffer::R8G8B8A8, pImageBuffer);
+					WidgetUploadToGPU(psWidget, numCopyRects, copyRects);
 				}
 			}
 		}
@@ -1233,20 +1997,59 @@ void SRPWindow::onWidgetResize(Berkelium::Window *win, Berkelium::Widget *wid, i
 		psWidget->nWidth = newWidth;
 		psWidget->nHeight = newHeight;
 
-		//todo: [10-07-2012 Icefire] let (re)sizing be handled by the program uniform, see http://dev.pixellight.org/forum/viewtopic.php?f=6&t=503
-
-		// update the buffer
-		UpdateVertexBuffer(psWidget->pVertexBuffer, Vector2(float(psWidget->nXPos), float(psWidget->nYPos)), Vector2(float(psWidget->nWidth), float(psWidget->nHeight)));
-
 		// recreate the image
 		psWidget->cImage = Image::CreateImage(DataByte, ColorRGBA, Vector3i(psWidget->nWidth, psWidget->nHeight, 1));
 
-		// recreate the texture buffer
-		if (nullptr != psWidget->pTextureBuffer)
+		// recreate the texture buffer, a resize within the bucket of the texture keeps it
+		if (!IsSurfaceTextureFitting(psWidget->pTextureBuffer, psWidget->nWidth, psWidget->nHeight))
+		{
+			if (nullptr != psWidget->pTextureBuffer)
+			{
+				DestroySurfaceTexture(psWidget->pTextureBuffer);
+			}
+			psWidget->pTextureBuffer = CreateSurfaceTexture(psWidget->nWidth, psWidget->nHeight);
+		}
+		InvalidateHitTest();
+	}
+}
+
+
+void SRPWindow::WidgetUploadToGPU(sWidget *psWidget)
+{
+	if (psWidget->pTextureBuffer)
+	{
+		// upload data to GPU
+		m_pTextureUploader->UploadFull(psWidget->pTextureBuffer, psWidget->cImage.GetBuffer()->GetData(), psWidget->nWidth, psWidget->nHeight);
+		InvalidateComposite();
+	}
+}
+
+
+void SRPWindow::WidgetUploadToGPU(sWidget *psWidget, size_t numCopyRects, const Berkelium::Rect *copyRects, const Berkelium::Rect *pScrollRect)
+{
+	if (psWidget->pTextureBuffer)
+	{
+		// coalesce the dirty rects, the widget image is valid everywhere
+		DamageRegion cDamage;
+		cDamage.SetSize(psWidget->nWidth, psWidget->nHeight);
+		cDamage.SetCallCost(m_psWindowsData->nUploadCallCost);
+		if (pScrollRect)
 		{
-			delete psWidget->pTextureBuffer;
+			cDamage.Add(*pScrollRect);
+		}
+		cDamage.Add(numCopyRects, copyRects);
+
+		if (cDamage.GetCoveredFraction() > m_psWindowsData->fFullUploadThreshold)
+		{
+			// most of the widget is dirty, so a full upload is the better deal
+			WidgetUploadToGPU(psWidget);
+		}
+		else if (!cDamage.IsEmpty())
+		{
+			// upload the dirty rects only
+			m_pTextureUploader->UploadRects(psWidget->pTextureBuffer, psWidget->cImage.GetBuffer()->GetData(), psWidget->nWidth, psWidget->nHeight, cDamage.GetNumOfRects(), cDamage.GetRects());
+			InvalidateComposite();
 		}
-		psWidget->pTextureBuffer = reinterpret_cast<TextureBuffer*>(m_pCurrentRenderer->CreateTextureBuffer2D(psWidget->cImage, TextureBuffer::Unknown, 0));
 	}
 }
 
@@ -1255,10 +2058,8 @@ void SRPWindow::DrawWidget(sWidget *psWidget)
 {
 	// set program
 	m_pCurrentRenderer->SetProgram(psWidget->pProgramWrapper);
-	// set render state to allow for transparency
-	m_pCurrentRenderer->SetRenderState(RenderState::BlendEnable, true);
-
-	//todo: [10-07-2012 Icefire] let (re)sizing be handled by the program uniform, see http://dev.pixellight.org/forum/viewtopic.php?f=6&t=503
+	// set render state to allow for transparency, the widgets of an opaque window do not need blending
+	m_pCurrentRenderer->SetRenderState(RenderState::BlendEnable, m_psWindowsData->bTransparent || m_psWindowsData->fOpacity < 1.0f);
 
 	{
 		const Rectangle &cViewportRect = m_pCurrentRenderer->GetViewport();
@@ -1275,19 +2076,26 @@ void SRPWindow::DrawWidget(sWidget *psWidget)
 		if (pProgramUniform)
 			pProgramUniform->Set(m_mObjectSpaceToClipSpace);
 
+		// place the unit quad, the widget follows the animation of the window
+		Vector2 vDrawPosition, vDrawSize;
+		TransformQuad(Vector2(float(psWidget->nXPos), float(psWidget->nYPos)), GetWidgetQuadSize(psWidget), vDrawPosition, vDrawSize);
+		Vector2 vTextureCoordinateScale, vTextureCoordinateOffset;
+		GetTextureCoordinates(psWidget->pTextureBuffer, psWidget->nWidth, psWidget->nHeight, vTextureCoordinateScale, vTextureCoordinateOffset);
+		ProgramCache::SetQuad(*psWidget->pProgramWrapper, vDrawPosition, vDrawSize, vTextureCoordinateScale, vTextureCoordinateOffset, m_psWindowsData->fOpacity);
+
 		const int nTextureUnit = psWidget->pProgramWrapper->Set("TextureMap", psWidget->pTextureBuffer);
 		if (nTextureUnit >= 0)
 		{
 			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::AddressU, TextureAddressing::Clamp);
 			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::AddressV, TextureAddressing::Clamp);
-			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MagFilter, TextureFiltering::None);
-			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MinFilter, TextureFiltering::None);
+			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MagFilter, GetTextureFiltering());
+			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MinFilter, GetTextureFiltering());
 			m_pCurrentRenderer->SetSamplerState(nTextureUnit, Sampler::MipFilter, TextureFiltering::None);
 		}
 
 		// set the vertex attributes
-		psWidget->pProgramWrapper->Set("VertexPosition", psWidget->pVertexBuffer, VertexBuffer::Position);
-		psWidget->pProgramWrapper->Set("VertexTexCoord", psWidget->pVertexBuffer, VertexBuffer::TexCoord);
+		psWidget->pProgramWrapper->Set("VertexPosition", m_pVertexBuffer, VertexBuffer::Position);
+		psWidget->pProgramWrapper->Set("VertexTexCoord", m_pVertexBuffer, VertexBuffer::TexCoord);
 	}
 
 	// draw the primitives
@@ -1320,7 +2128,8 @@ HashMap<Berkelium::Widget*, sWidget*> *SRPWindow::GetWidgets() const
 
 Vector2i SRPWindow::GetRelativeMousePositionWidget(const sWidget *psWidget, const Vector2i &vMousePos) const
 {
-	return Vector2i(vMousePos.x - psWidget->nXPos, vMousePos.y - psWidget->nYPos);
+	// the widget is rendered at the render scale of its window like the page
+	return Vector2i(int(float(vMousePos.x - psWidget->nXPos)*m_psWindowsData->fRenderScale), int(float(vMousePos.y - psWidget->nYPos)*m_psWindowsData->fRenderScale));
 }
 
 
@@ -1337,8 +2146,248 @@ bool SRPWindow::IsLoaded() const
 }
 
 
+void SRPWindow::SetSwizzleOnCopy(const bool &bSwizzle)
+{
+	if (m_psWindowsData->bSwizzleOnCopy != bSwizzle)
+	{
+		// zero copy needs the swizzle on copy
+		if (!bSwizzle && m_psWindowsData->bZeroCopy)
+		{
+			SetZeroCopy(false);
+		}
+
+		m_psWindowsData->bSwizzleOnCopy = bSwizzle;
+
+		if (m_bInitialized)
+		{
+			// swizzling is its own inverse, so the current content can be converted in place
+			SyncImageFromGPU();
+			uint8 *pImageBuffer = m_cImage.GetBuffer()->GetData();
+			BufferCopy::CopyRow(pImageBuffer, pImageBuffer, uint32(m_vRenderSize.x * m_vRenderSize.y), true);
+			Iterator<sWidget*> cIterator = m_pmapWidgets->GetIterator();
+			while (cIterator.HasNext())
+			{
+				sWidget *psWidget = cIterator.Next();
+				if (psWidget->cImage.GetBuffer())
+				{
+					uint8 *pWidgetImageBuffer = psWidget->cImage.GetBuffer()->GetData();
+					BufferCopy::CopyRow(pWidgetImageBuffer, pWidgetImageBuffer, uint32(psWidget->nWidth * psWidget->nHeight), true);
+					WidgetUploadToGPU(psWidget);
+				}
+			}
+
+			// the window and its widgets need the other shader variant
+			DestroyProgramWrapper();
+			CreateProgramWrapper();
+			Iterator<sWidget*> cProgramIterator = m_pmapWidgets->GetIterator();
+			while (cProgramIterator.HasNext())
+			{
+				cProgramIterator.Next()->pProgramWrapper = m_pProgramWrapper;
+			}
+
+			// upload the converted content
+			BufferUploadToGPU();
+			InvalidateComposite();
+		}
+	}
+}
+
+
+const sWindowStats &SRPWindow::GetStats() const
+{
+	return m_sStats;
+}
+
+
+void SRPWindow::ResetStats()
+{
+	m_sStats.nPaints = 0;
+	m_sStats.nPaintsMerged = 0;
+	m_sStats.nUploads = 0;
+	m_sStats.nPaintsHidden = 0;
+	m_sStats.nResyncs = 0;
+	m_sStats.nResizes = 0;
+	m_sStats.nResizePreviews = 0;
+	if (m_pTextureUploader)
+	{
+		m_pTextureUploader->ResetStats();
+	}
+}
+
+
+const sUploadStats &SRPWindow::GetUploadStats() const
+{
+	static const sUploadStats sNoStats = { 0, 0, 0, 0, 0, 0 };
+	return m_pTextureUploader ? m_pTextureUploader->GetStats() : sNoStats;
+}
+
+
+bool SRPWindow::SetNumOfPixelBuffers(const uint32 &nNumOfBuffers)
+{
+	m_psWindowsData->nNumOfPixelBuffers = nNumOfBuffers;
+	if (m_pTextureUploader)
+	{
+		// the uploader is created on initialize, until then only the setting is kept
+		if (!m_pTextureUploader->SetNumOfPixelBuffers(nNumOfBuffers))
+		{
+			m_psWindowsData->nNumOfPixelBuffers = 0;
+		}
+	}
+	return (m_psWindowsData->nNumOfPixelBuffers > 0);
+}
+
+
+bool SRPWindow::SetZeroCopy(const bool &bZeroCopy)
+{
+	if (!m_bInitialized)
+	{
+		// applied on initialize
+		m_psWindowsData->bZeroCopy = bZeroCopy;
+		return bZeroCopy;
+	}
+	if (m_psWindowsData->bZeroCopy == bZeroCopy)
+	{
+		return bZeroCopy;
+	}
+
+	if (bZeroCopy)
+	{
+		if (!m_pTextureUploader->IsStagingSupported())
+		{
+			return false;
+		}
+
+		// the staging buffer is drawn as is and there is no image buffer to scroll on the CPU
+		SetSwizzleOnCopy(true);
+		m_psWindowsData->bScrollOnGPU = true;
+
+		// pending uploads still read from the image buffer
+		BufferFlushUpload();
+		m_cImage = Image();
+		m_bImageOutdated = false;
+		m_psWindowsData->bZeroCopy = true;
+	}
+	else
+	{
+		// get the staged rects into the texture, then read the texture back into a new image buffer
+		BufferFlushUpload();
+		m_psWindowsData->bZeroCopy = false;
+		m_cImage = Image::CreateImage(DataByte, ColorRGBA, Vector3i(m_vRenderSize.x, m_vRenderSize.y, 1));
+		m_bImageOutdated = true;
+		SyncImageFromGPU();
+	}
+	return m_psWindowsData->bZeroCopy;
+}
+
+
+void SRPWindow::SetVisible(const bool &bVisible)
+{
+	m_psWindowsData->bIsVisable = bVisible;
+	InvalidateHitTest();
+
+	// resync right away, the full paint can then arrive before the next draw
+	UpdateSuspension();
+}
+
+
+void SRPWindow::SetCopyWorkerPool(CopyWorkerPool *pCopyWorkerPool)
+{
+	m_pCopyWorkerPool = pCopyWorkerPool;
+	if (m_pToolTip)
+	{
+		m_pToolTip->SetCopyWorkerPool(pCopyWorkerPool);
+	}
+}
+
+
+void SRPWindow::SetSurfacePool(SurfacePool *pSurfacePool)
+{
+	m_pSurfacePool = pSurfacePool;
+	if (m_pToolTip)
+	{
+		m_pToolTip->SetSurfacePool(pSurfacePool);
+	}
+}
+
+
+void SRPWindow::SetWindowAnimator(WindowAnimator *pWindowAnimator)
+{
+	if (m_pWindowAnimator && m_pWindowAnimator != pWindowAnimator)
+	{
+		// the old animator must not animate this window anymore
+		m_pWindowAnimator->Stop(this, true);
+	}
+	m_pWindowAnimator = pWindowAnimator;
+	if (m_pToolTip)
+	{
+		m_pToolTip->SetWindowAnimator(pWindowAnimator);
+	}
+}
+
+
+void SRPWindow::SetHitTestIndex(HitTestIndex *pHitTestIndex)
+{
+	// the old index may still hold the window
+	InvalidateHitTest();
+	m_pHitTestIndex = pHitTestIndex;
+	InvalidateHitTest();
+}
+
+
+void SRPWindow::SetCompositor(SRPCompositor *pCompositor)
+{
+	// the tool tip takes the compositor when it is set up
+	m_pCompositor = pCompositor;
+}
+
+
+void SRPWindow::SetProgramCache(ProgramCache *pProgramCache)
+{
+	if (m_pProgramCache != pProgramCache)
+	{
+		// let go of the current program and unit quad, the window and its widgets take the ones of the new owner
+		const bool bHadProgram = (nullptr != m_pProgramWrapper);
+		const bool bHadUnitQuad = (nullptr != m_pVertexBuffer);
+		DestroyProgramWrapper();
+		DestroyUnitQuad();
+		m_pProgramCache = pProgramCache;
+		if (bHadUnitQuad)
+		{
+			CreateUnitQuad();
+		}
+		if (bHadProgram)
+		{
+			CreateProgramWrapper();
+			Iterator<sWidget*> cIterator = m_pmapWidgets->GetIterator();
+			while (cIterator.HasNext())
+			{
+				cIterator.Next()->pProgramWrapper = m_pProgramWrapper;
+			}
+		}
+	}
+	if (m_pToolTip)
+	{
+		m_pToolTip->SetProgramCache(pProgramCache);
+	}
+}
+
+
 Image SRPWindow::GetImage() const
 {
+	if (m_psWindowsData->bZeroCopy)
+	{
+		// there is no image buffer, read the texture back into a new image
+		Image cImage = Image::CreateImage(DataByte, ColorRGBA, Vector3i(m_vRenderSize.x, m_vRenderSize.y, 1));
+		if (m_pTextureBuffer && nullptr != cImage.GetBuffer())
+		{
+			m_pTextureUploader->DownloadFull(m_pTextureBuffer, cImage.GetBuffer()->GetData(), m_vRenderSize.x, m_vRenderSize.y);
+		}
+		return cImage;
+	}
+
+	// make sure the image is not outdated by a scroll on the GPU
+	SyncImageFromGPU();
+
 	// we return the image
 	return Image(m_cImage);
 	//question: [10-07-2012 Icefire]
@@ -0,0 +1,205 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/SurfacePool.h"
+
+#include <PLCore/System/System.h>
+#include <PLCore/Core/MemoryManager.h>
+#include <PLRenderer/Renderer/TextureBuffer2D.h>
+#include <PLGraphics/Image/Image.h>
+#include <PLGraphics/Image/ImageBuffer.h>
+#include <PLMath/Vector3i.h>
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLMath;
+using namespace PLGraphics;
+using namespace PLRenderer;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+SurfacePool::SurfacePool() :
+	m_nNumOfFree(0),
+	m_nFreeBytes(0),
+	m_nMaxFreeBytes(64 * 1024 * 1024)
+{
+	MemoryManager::Set(&m_sStats, 0, sizeof(sSurfacePoolStats));
+}
+
+
+SurfacePool::~SurfacePool()
+{
+	// the textures in use belong to the windows, they give them back before the pool goes
+	Trim(0);
+}
+
+
+TextureBuffer *SurfacePool::Acquire(Renderer &cRenderer, const int &nWidth, const int &nHeight)
+{
+	if (nWidth <= 0 || nHeight <= 0)
+	{
+		return nullptr;
+	}
+	const Vector2i vBucketSize = GetBucketSize(Vector2i(nWidth, nHeight));
+
+	// take a free texture of the bucket size, the latest one first
+	for (uint32 i = m_nNumOfFree; i > 0; i--)
+	{
+		sPooledSurface &sSurface = m_sFree[i - 1];
+		if (sSurface.vSize == vBucketSize)
+		{
+			TextureBuffer *pTextureBuffer = sSurface.pTextureBuffer;
+			m_nFreeBytes -= uint64(vBucketSize.x) * uint64(vBucketSize.y) * 4;
+			m_nNumOfFree--;
+			m_sFree[i - 1] = m_sFree[m_nNumOfFree];
+			m_sStats.nReused++;
+			return pTextureBuffer;
+		}
+	}
+
+	// none there, create one (the image only describes the texture, its content does not matter)
+	Image cImage = Image::CreateImage(DataByte, ColorRGBA, Vector3i(vBucketSize.x, vBucketSize.y, 1));
+	TextureBuffer *pTextureBuffer = reinterpret_cast<TextureBuffer*>(cRenderer.CreateTextureBuffer2D(cImage, TextureBuffer::Unknown, 0));
+	if (pTextureBuffer)
+	{
+		m_sStats.nCreated++;
+	}
+	return pTextureBuffer;
+}
+
+
+void SurfacePool::Release(TextureBuffer *pTextureBuffer)
+{
+	if (!pTextureBuffer)
+	{
+		return;
+	}
+
+	const Vector2i vSize = GetTextureSize(pTextureBuffer);
+	const uint64 nBytes = uint64(vSize.x) * uint64(vSize.y) * 4;
+	if (vSize != GetBucketSize(vSize) || nBytes > m_nMaxFreeBytes)
+	{
+		// not one of ours or too large to keep
+		delete pTextureBuffer;
+		return;
+	}
+
+	// make room, within the budget and the number of free slots
+	Trim(m_nMaxFreeBytes - nBytes);
+	if (m_nNumOfFree == MAXPOOLEDSURFACES)
+	{
+		uint32 nOldest = 0;
+		for (uint32 i = 1; i < m_nNumOfFree; i++)
+		{
+			if (m_sFree[i].nReleaseTime < m_sFree[nOldest].nReleaseTime)
+				nOldest = i;
+		}
+		DestroyFree(nOldest);
+	}
+
+	sPooledSurface &sSurface = m_sFree[m_nNumOfFree];
+	sSurface.pTextureBuffer = pTextureBuffer;
+	sSurface.vSize = vSize;
+	sSurface.nReleaseTime = System::GetInstance()->GetMilliseconds();
+	m_nNumOfFree++;
+	m_nFreeBytes += nBytes;
+}
+
+
+void SurfacePool::Trim(uint64 nMaxFreeBytes)
+{
+	while (m_nFreeBytes > nMaxFreeBytes && m_nNumOfFree > 0)
+	{
+		// the texture that has been free the longest goes first
+		uint32 nOldest = 0;
+		for (uint32 i = 1; i < m_nNumOfFree; i++)
+		{
+			if (m_sFree[i].nReleaseTime < m_sFree[nOldest].nReleaseTime)
+				nOldest = i;
+		}
+		DestroyFree(nOldest);
+	}
+}
+
+
+void SurfacePool::SetMaxFreeBytes(uint64 nMaxFreeBytes)
+{
+	m_nMaxFreeBytes = nMaxFreeBytes;
+	Trim(m_nMaxFreeBytes);
+}
+
+
+uint64 SurfacePool::GetMaxFreeBytes() const
+{
+	return m_nMaxFreeBytes;
+}
+
+
+uint64 SurfacePool::GetFreeBytes() const
+{
+	return m_nFreeBytes;
+}
+
+
+uint32 SurfacePool::GetNumOfFreeTextures() const
+{
+	return m_nNumOfFree;
+}
+
+
+const sSurfacePoolStats &SurfacePool::GetStats() const
+{
+	return m_sStats;
+}
+
+
+Vector2i SurfacePool::GetBucketSize(const Vector2i &vSize)
+{
+	const int nWidth  = (vSize.x > 0) ? vSize.x : 1;
+	const int nHeight = (vSize.y > 0) ? vSize.y : 1;
+	return Vector2i(((nWidth  + SURFACEBUCKETSIZE - 1) / SURFACEBUCKETSIZE) * SURFACEBUCKETSIZE,
+					((nHeight + SURFACEBUCKETSIZE - 1) / SURFACEBUCKETSIZE) * SURFACEBUCKETSIZE);
+}
+
+
+Vector2i SurfacePool::GetTextureSize(TextureBuffer *pTextureBuffer)
+{
+	// window and widget textures are always 2D
+	if (pTextureBuffer && pTextureBuffer->GetType() == Resource::TypeTextureBuffer2D)
+	{
+		return static_cast<TextureBuffer2D*>(pTextureBuffer)->GetSize();
+	}
+	return Vector2i::Zero;
+}
+
+
+Vector2 SurfacePool::GetTextureCoordinateScale(TextureBuffer *pTextureBuffer, const int &nWidth, const int &nHeight)
+{
+	const Vector2i vSize = GetTextureSize(pTextureBuffer);
+	if (vSize.x <= 0 || vSize.y <= 0)
+	{
+		return Vector2::One;
+	}
+	return Vector2(float(nWidth) / float(vSize.x), float(nHeight) / float(vSize.y));
+}
+
+
+void SurfacePool::DestroyFree(uint32 nIndex)
+{
+	sPooledSurface &sSurface = m_sFree[nIndex];
+	delete sSurface.pTextureBuffer;
+	m_nFreeBytes -= uint64(sSurface.vSize.x) * uint64(sSurface.vSize.y) * 4;
+	m_nNumOfFree--;
+	m_sFree[nIndex] = m_sFree[m_nNumOfFree];
+	m_sStats.nDestroyed++;
+}
+
+
+};
@@ -0,0 +1,647 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/TextureUploader.h"
+
+#include <PLCore/System/System.h>
+#include <PLCore/Core/MemoryManager.h>
+#include <PLRenderer/Renderer/TextureBuffer2D.h>
+
+#include <string.h>
+
+#ifdef WIN32
+	#include <PLCore/PLCoreWindowsIncludes.h>
+	#include <GL/gl.h>
+#else
+	#include <GL/gl.h>
+	#include <GL/glx.h>
+#endif
+
+
+//[-------------------------------------------------------]
+//[ Definitions                                           ]
+//[-------------------------------------------------------]
+// pixel buffer objects are OpenGL 2.1, the default OpenGL headers do not go that far
+#ifndef GL_PIXEL_UNPACK_BUFFER
+	#define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif
+#ifndef GL_STREAM_DRAW
+	#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_WRITE_ONLY
+	#define GL_WRITE_ONLY 0x88B9
+#endif
+#ifndef APIENTRY
+	#define APIENTRY
+#endif
+typedef void (APIENTRY *PFNPLBERKELIUMGLGENBUFFERS) (GLsizei n, GLuint *buffers);
+typedef void (APIENTRY *PFNPLBERKELIUMGLDELETEBUFFERS) (GLsizei n, const GLuint *buffers);
+typedef void (APIENTRY *PFNPLBERKELIUMGLBINDBUFFER) (GLenum target, GLuint buffer);
+typedef void (APIENTRY *PFNPLBERKELIUMGLBUFFERDATA) (GLenum target, ptrdiff_t size, const GLvoid *data, GLenum usage);
+typedef GLvoid* (APIENTRY *PFNPLBERKELIUMGLMAPBUFFER) (GLenum target, GLenum access);
+typedef GLboolean (APIENTRY *PFNPLBERKELIUMGLUNMAPBUFFER) (GLenum target);
+
+static bool g_bPixelBufferFunctionsLoaded = false;
+static bool g_bPixelBufferFunctionsAvailable = false;
+static PFNPLBERKELIUMGLGENBUFFERS g_pfnGenBuffers = nullptr;
+static PFNPLBERKELIUMGLDELETEBUFFERS g_pfnDeleteBuffers = nullptr;
+static PFNPLBERKELIUMGLBINDBUFFER g_pfnBindBuffer = nullptr;
+static PFNPLBERKELIUMGLBUFFERDATA g_pfnBufferData = nullptr;
+static PFNPLBERKELIUMGLMAPBUFFER g_pfnMapBuffer = nullptr;
+static PFNPLBERKELIUMGLUNMAPBUFFER g_pfnUnmapBuffer = nullptr;
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLMath;
+using namespace PLRenderer;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Internal helpers                                      ]
+//[-------------------------------------------------------]
+/**
+*  @brief
+*    Returns whether or not the current context supports pixel buffer objects
+*
+*  @remarks
+*    The buffer entry points alone are OpenGL 1.5, the pixel unpack target needs OpenGL 2.1 or the extension.
+*/
+static bool IsPixelBufferObjectSupported()
+{
+	// the version string starts with "<major>.<minor>"
+	const char *pszVersion = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+	if (!pszVersion)
+	{
+		return false;
+	}
+	int nMajor = 0;
+	int nMinor = 0;
+	const char *pszCharacter = pszVersion;
+	for (; *pszCharacter >= '0' && *pszCharacter <= '9'; pszCharacter++)
+	{
+		nMajor = nMajor*10 + (*pszCharacter - '0');
+	}
+	if (*pszCharacter == '.')
+	{
+		for (pszCharacter++; *pszCharacter >= '0' && *pszCharacter <= '9'; pszCharacter++)
+		{
+			nMinor = nMinor*10 + (*pszCharacter - '0');
+		}
+	}
+	if (nMajor > 2 || (nMajor == 2 && nMinor >= 1))
+	{
+		return true;
+	}
+
+	// the extension names are separated by spaces, a name must not match the start of a longer one
+	const char *pszExtensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+	if (!pszExtensions)
+	{
+		return false;
+	}
+	static const char szExtension[] = "GL_ARB_pixel_buffer_object";
+	const size_t nLength = sizeof(szExtension) - 1;
+	for (const char *pszFound = strstr(pszExtensions, szExtension); pszFound; pszFound = strstr(pszFound + nLength, szExtension))
+	{
+		if ((pszFound == pszExtensions || pszFound[-1] == ' ') && (pszFound[nLength] == ' ' || pszFound[nLength] == '\0'))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+TextureUploader::TextureUploader(Renderer *pRenderer) :
+	m_pCurrentRenderer(pRenderer),
+	m_bIsOpenGLES(pRenderer->GetAPI() == "OpenGL ES 2.0"),
+	m_nNumOfPixelBuffers(0),
+	m_nCurrentPixelBuffer(0),
+	m_nCurrentStagingBuffer(0),
+	m_pStagingData(nullptr),
+	m_nStagingBytes(0)
+{
+	MemoryManager::Set(m_nPixelBuffers, 0, sizeof(m_nPixelBuffers));
+	MemoryManager::Set(m_nPixelBufferSize, 0, sizeof(m_nPixelBufferSize));
+	MemoryManager::Set(m_nStagingBuffers, 0, sizeof(m_nStagingBuffers));
+	ResetStats();
+}
+
+
+TextureUploader::~TextureUploader()
+{
+	DestroyPixelBuffers();
+	DestroyStagingBuffers();
+}
+
+
+bool TextureUploader::SetNumOfPixelBuffers(uint32 nNumOfBuffers)
+{
+	if (nNumOfBuffers > 4)
+	{
+		nNumOfBuffers = 4;
+	}
+
+	if (nNumOfBuffers != m_nNumOfPixelBuffers)
+	{
+		DestroyPixelBuffers();
+
+		// there are no pixel buffer objects on OpenGL ES 2.0
+		if (nNumOfBuffers > 0 && !m_bIsOpenGLES && LoadPixelBufferFunctions())
+		{
+			g_pfnGenBuffers(GLsizei(nNumOfBuffers), m_nPixelBuffers);
+			m_nNumOfPixelBuffers = nNumOfBuffers;
+			m_nCurrentPixelBuffer = 0;
+		}
+	}
+
+	return (m_nNumOfPixelBuffers > 0);
+}
+
+
+uint32 TextureUploader::GetNumOfPixelBuffers() const
+{
+	return m_nNumOfPixelBuffers;
+}
+
+
+uint8 *TextureUploader::MapStaging(const int &nWidth, const int &nHeight)
+{
+	const uint64 nBytes = uint64(nWidth) * uint64(nHeight) * 4;
+	if (m_pStagingData)
+	{
+		if (nBytes == m_nStagingBytes)
+		{
+			// still mapped
+			return m_pStagingData;
+		}
+
+		// the image size changed, whatever was written is lost anyway
+		g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_nStagingBuffers[m_nCurrentStagingBuffer]);
+		g_pfnUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		m_pStagingData = nullptr;
+	}
+	if (nWidth <= 0 || nHeight <= 0 || !IsStagingSupported())
+	{
+		return nullptr;
+	}
+
+	// create the staging buffers on first use
+	if (0 == m_nStagingBuffers[0])
+	{
+		g_pfnGenBuffers(2, m_nStagingBuffers);
+	}
+
+	// take the other buffer, the GPU might still pull from the last one
+	m_nCurrentStagingBuffer = (m_nCurrentStagingBuffer + 1) % 2;
+	g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_nStagingBuffers[m_nCurrentStagingBuffer]);
+
+	// respecify the storage so mapping does not wait for the GPU
+	g_pfnBufferData(GL_PIXEL_UNPACK_BUFFER, ptrdiff_t(nBytes), nullptr, GL_STREAM_DRAW);
+	m_pStagingData = static_cast<uint8*>(g_pfnMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY));
+	m_nStagingBytes = nBytes;
+
+	// a mapped buffer does not need to stay bound
+	g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	return m_pStagingData;
+}
+
+
+bool TextureUploader::UploadStaging(TextureBuffer *pTextureBuffer, const int &nWidth, const int &nHeight, size_t nNumOfRects, const Berkelium::Rect *pRects)
+{
+	if (!pTextureBuffer || 0 == m_nStagingBuffers[0])
+	{
+		return false;
+	}
+
+	const uint64 nStart = System::GetInstance()->GetMicroseconds();
+
+	// bind the texture buffer through the renderer so that its state cache stays valid
+	if (!m_pCurrentRenderer->SetTextureBuffer(0, pTextureBuffer))
+	{
+		return false;
+	}
+
+	g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_nStagingBuffers[m_nCurrentStagingBuffer]);
+	if (m_pStagingData)
+	{
+		m_pStagingData = nullptr;
+		if (!g_pfnUnmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+		{
+			// the buffer content got lost, e.g. on a display mode change
+			g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			return false;
+		}
+	}
+
+	// the staging buffer is laid out like the image
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, nWidth);
+
+	uint64 nBytes = 0;
+	for (size_t i = 0; i < nNumOfRects; i++)
+	{
+		const Berkelium::Rect cRect = ClipRect(pRects[i], nWidth, nHeight);
+		if (cRect.width() > 0 && cRect.height() > 0)
+		{
+			glTexSubImage2D(GL_TEXTURE_2D, 0, cRect.left(), cRect.top(), cRect.width(), cRect.height(), GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<const GLvoid*>((size_t(cRect.top()) * size_t(nWidth) + size_t(cRect.left())) * 4));
+			nBytes += uint64(cRect.width()) * uint64(cRect.height()) * 4;
+		}
+	}
+
+	// restore the default unpack state
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	m_sStats.nPixelBufferUploads++;
+	m_sStats.nPixelBufferBytes += nBytes;
+	m_sStats.nPixelBufferTime += System::GetInstance()->GetMicroseconds() - nStart;
+
+	return true;
+}
+
+
+bool TextureUploader::IsStagingSupported() const
+{
+	// there are no pixel buffer objects on OpenGL ES 2.0
+	return (!m_bIsOpenGLES && LoadPixelBufferFunctions());
+}
+
+
+const sUploadStats &TextureUploader::GetStats() const
+{
+	return m_sStats;
+}
+
+
+void TextureUploader::ResetStats()
+{
+	MemoryManager::Set(&m_sStats, 0, sizeof(sUploadStats));
+}
+
+
+bool TextureUploader::UploadFull(TextureBuffer *pTextureBuffer, const uint8 *pImageBuffer, const int &nWidth, const int &nHeight)
+{
+	if (pTextureBuffer && pImageBuffer)
+	{
+		const uint64 nStart = System::GetInstance()->GetMicroseconds();
+
+		// window and widget textures are always 2D
+		const Vector2i vSize = (pTextureBuffer->GetType() == Resource::TypeTextureBuffer2D) ? static_cast<TextureBuffer2D*>(pTextureBuffer)->GetSize() : Vector2i::Zero;
+		if (vSize != Vector2i(nWidth, nHeight))
+		{
+			// a pooled texture is larger than the image, upload the image as one rectangle
+			Berkelium::Rect cRect;
+			cRect.mLeft   = 0;
+			cRect.mTop    = 0;
+			cRect.mWidth  = nWidth;
+			cRect.mHeight = nHeight;
+			return UploadRects(pTextureBuffer, pImageBuffer, nWidth, nHeight, 1, &cRect);
+		}
+
+		if (m_nNumOfPixelBuffers > 0 && vSize.x > 0 && vSize.y > 0 && m_pCurrentRenderer->SetTextureBuffer(0, pTextureBuffer))
+		{
+			// stream the whole image as one rectangle
+			Berkelium::Rect cRect;
+			cRect.mLeft   = 0;
+			cRect.mTop    = 0;
+			cRect.mWidth  = vSize.x;
+			cRect.mHeight = vSize.y;
+			const uint64 nBytes = UploadThroughPixelBuffer(pImageBuffer, vSize.x, 1, &cRect);
+			if (nBytes > 0)
+			{
+				m_sStats.nPixelBufferUploads++;
+				m_sStats.nPixelBufferBytes += nBytes;
+				m_sStats.nPixelBufferTime += System::GetInstance()->GetMicroseconds() - nStart;
+				return true;
+			}
+		}
+
+		// upload the whole image
+		const bool bResult = pTextureBuffer->CopyDataFrom(0, TextureBuffer::R8G8B8A8, pImageBuffer);
+		m_sStats.nUploads++;
+		m_sStats.nUploadedBytes += uint64(vSize.x) * uint64(vSize.y) * 4;
+		m_sStats.nUploadTime += System::GetInstance()->GetMicroseconds() - nStart;
+		return bResult;
+	}
+	return false;
+}
+
+
+bool TextureUploader::DownloadFull(TextureBuffer *pTextureBuffer, uint8 *pImageBuffer, const int &nWidth, const int &nHeight)
+{
+	if (!pTextureBuffer || !pImageBuffer || nWidth <= 0 || nHeight <= 0)
+	{
+		return false;
+	}
+
+	// window and widget textures are always 2D
+	const Vector2i vSize = (pTextureBuffer->GetType() == Resource::TypeTextureBuffer2D) ? static_cast<TextureBuffer2D*>(pTextureBuffer)->GetSize() : Vector2i::Zero;
+	if (vSize == Vector2i(nWidth, nHeight))
+	{
+		return pTextureBuffer->CopyDataTo(0, TextureBuffer::R8G8B8A8, pImageBuffer);
+	}
+	if (vSize.x < nWidth || vSize.y < nHeight)
+	{
+		return false;
+	}
+
+	// a pooled texture is larger than the image, read it all and keep the top left corner
+	uint8 *pTextureData = new uint8[size_t(vSize.x) * size_t(vSize.y) * 4];
+	const bool bResult = pTextureBuffer->CopyDataTo(0, TextureBuffer::R8G8B8A8, pTextureData);
+	if (bResult)
+	{
+		for (int nRow = 0; nRow < nHeight; nRow++)
+		{
+			MemoryManager::Copy(&pImageBuffer[size_t(nRow) * size_t(nWidth) * 4], &pTextureData[size_t(nRow) * size_t(vSize.x) * 4], size_t(nWidth) * 4);
+		}
+	}
+	delete [] pTextureData;
+	return bResult;
+}
+
+
+bool TextureUploader::UploadRects(TextureBuffer *pTextureBuffer, const uint8 *pImageBuffer, const int &nWidth, const int &nHeight, size_t nNumOfRects, const Berkelium::Rect *pRects)
+{
+	if (!pTextureBuffer || !pImageBuffer)
+	{
+		return false;
+	}
+
+	// bind the texture buffer through the renderer so that its state cache stays valid
+	if (!m_pCurrentRenderer->SetTextureBuffer(0, pTextureBuffer))
+	{
+		return false;
+	}
+
+	const uint64 nStart = System::GetInstance()->GetMicroseconds();
+
+	// the image rows are tightly packed
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	if (m_nNumOfPixelBuffers > 0)
+	{
+		// clip the rectangles first, they are packed one after the other into a pixel buffer
+		Berkelium::Rect cClippedRects[64];
+		uint64 nBytes = 0;
+		bool bStreamed = true;
+		size_t nRect = 0;
+		while (nRect < nNumOfRects && bStreamed)
+		{
+			size_t nNumOfClippedRects = 0;
+			for (; nRect < nNumOfRects && nNumOfClippedRects < 64; nRect++)
+			{
+				const Berkelium::Rect cRect = ClipRect(pRects[nRect], nWidth, nHeight);
+				if (cRect.width() > 0 && cRect.height() > 0)
+				{
+					cClippedRects[nNumOfClippedRects] = cRect;
+					nNumOfClippedRects++;
+				}
+			}
+			if (nNumOfClippedRects > 0)
+			{
+				const uint64 nStreamedBytes = UploadThroughPixelBuffer(pImageBuffer, nWidth, nNumOfClippedRects, cClippedRects);
+				nBytes += nStreamedBytes;
+				bStreamed = (nStreamedBytes > 0);
+			}
+		}
+		if (bStreamed)
+		{
+			m_sStats.nPixelBufferUploads++;
+			m_sStats.nPixelBufferBytes += nBytes;
+			m_sStats.nPixelBufferTime += System::GetInstance()->GetMicroseconds() - nStart;
+			return true;
+		}
+		// the pixel buffer could not be mapped, upload everything straight to the texture
+	}
+
+	uint64 nBytes = 0;
+	if (!m_bIsOpenGLES)
+	{
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, nWidth);
+	}
+
+	for (size_t i = 0; i < nNumOfRects; i++)
+	{
+		const Berkelium::Rect cRect = ClipRect(pRects[i], nWidth, nHeight);
+		if (cRect.width() > 0 && cRect.height() > 0)
+		{
+			if (m_bIsOpenGLES)
+			{
+				// no unpack row length available, upload the full rows covered by the rectangle
+				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, cRect.top(), nWidth, cRect.height(), GL_RGBA, GL_UNSIGNED_BYTE, &pImageBuffer[cRect.top() * nWidth * 4]);
+				nBytes += uint64(nWidth) * uint64(cRect.height()) * 4;
+			}
+			else
+			{
+				glTexSubImage2D(GL_TEXTURE_2D, 0, cRect.left(), cRect.top(), cRect.width(), cRect.height(), GL_RGBA, GL_UNSIGNED_BYTE, &pImageBuffer[(cRect.top() * nWidth + cRect.left()) * 4]);
+				nBytes += uint64(cRect.width()) * uint64(cRect.height()) * 4;
+			}
+		}
+	}
+
+	// restore the default unpack state
+	if (!m_bIsOpenGLES)
+	{
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	}
+
+	m_sStats.nUploads++;
+	m_sStats.nUploadedBytes += nBytes;
+	m_sStats.nUploadTime += System::GetInstance()->GetMicroseconds() - nStart;
+
+	return true;
+}
+
+
+bool TextureUploader::CopyFromRenderTarget(TextureBuffer *pTextureBuffer, const int &nX, const int &nY, const int &nSourceX, const int &nSourceY, const int &nWidth, const int &nHeight)
+{
+	if (!pTextureBuffer || nWidth <= 0 || nHeight <= 0)
+	{
+		return false;
+	}
+
+	// bind the texture buffer through the renderer so that its state cache stays valid
+	if (!m_pCurrentRenderer->SetTextureBuffer(0, pTextureBuffer))
+	{
+		return false;
+	}
+
+	// copy from the currently bound render target
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, nX, nY, nSourceX, nSourceY, nWidth, nHeight);
+
+	return true;
+}
+
+
+float TextureUploader::GetCoveredFraction(const int &nWidth, const int &nHeight, size_t nNumOfRects, const Berkelium::Rect *pRects)
+{
+	if (nWidth <= 0 || nHeight <= 0)
+	{
+		return 0.0f;
+	}
+
+	// sum up the clipped areas
+	uint64 nArea = 0;
+	for (size_t i = 0; i < nNumOfRects; i++)
+	{
+		const Berkelium::Rect cRect = ClipRect(pRects[i], nWidth, nHeight);
+		nArea += uint64(cRect.width()) * uint64(cRect.height());
+	}
+	return float(double(nArea) / (double(nWidth) * double(nHeight)));
+}
+
+
+Berkelium::Rect TextureUploader::ClipRect(const Berkelium::Rect &cRect, const int &nWidth, const int &nHeight)
+{
+	const int nLeft   = cRect.left()   < 0       ? 0       : cRect.left();
+	const int nTop    = cRect.top()    < 0       ? 0       : cRect.top();
+	const int nRight  = cRect.right()  > nWidth  ? nWidth  : cRect.right();
+	const int nBottom = cRect.bottom() > nHeight ? nHeight : cRect.bottom();
+
+	Berkelium::Rect cClipped;
+	cClipped.mLeft   = nLeft;
+	cClipped.mTop    = nTop;
+	cClipped.mWidth  = nRight  > nLeft ? nRight  - nLeft : 0;
+	cClipped.mHeight = nBottom > nTop  ? nBottom - nTop  : 0;
+	return cClipped;
+}
+
+
+bool TextureUploader::LoadPixelBufferFunctions()
+{
+	if (!g_bPixelBufferFunctionsLoaded)
+	{
+		g_bPixelBufferFunctionsLoaded = true;
+
+		// a context has to be current, the renderer made sure of that
+		#ifdef WIN32
+			#define PLBERKELIUM_GETPROCADDRESS(sName) wglGetProcAddress(sName)
+		#else
+			#define PLBERKELIUM_GETPROCADDRESS(sName) glXGetProcAddressARB(reinterpret_cast<const GLubyte*>(sName))
+		#endif
+		g_pfnGenBuffers    = reinterpret_cast<PFNPLBERKELIUMGLGENBUFFERS>   (PLBERKELIUM_GETPROCADDRESS("glGenBuffers"));
+		g_pfnDeleteBuffers = reinterpret_cast<PFNPLBERKELIUMGLDELETEBUFFERS>(PLBERKELIUM_GETPROCADDRESS("glDeleteBuffers"));
+		g_pfnBindBuffer    = reinterpret_cast<PFNPLBERKELIUMGLBINDBUFFER>   (PLBERKELIUM_GETPROCADDRESS("glBindBuffer"));
+		g_pfnBufferData    = reinterpret_cast<PFNPLBERKELIUMGLBUFFERDATA>   (PLBERKELIUM_GETPROCADDRESS("glBufferData"));
+		g_pfnMapBuffer     = reinterpret_cast<PFNPLBERKELIUMGLMAPBUFFER>    (PLBERKELIUM_GETPROCADDRESS("glMapBuffer"));
+		g_pfnUnmapBuffer   = reinterpret_cast<PFNPLBERKELIUMGLUNMAPBUFFER>  (PLBERKELIUM_GETPROCADDRESS("glUnmapBuffer"));
+		#undef PLBERKELIUM_GETPROCADDRESS
+
+		// an entry point can be there while the driver does not support the pixel unpack target
+		g_bPixelBufferFunctionsAvailable = (g_pfnGenBuffers && g_pfnDeleteBuffers && g_pfnBindBuffer && g_pfnBufferData && g_pfnMapBuffer && g_pfnUnmapBuffer &&
+											IsPixelBufferObjectSupported());
+	}
+	return g_bPixelBufferFunctionsAvailable;
+}
+
+
+void TextureUploader::DestroyPixelBuffers()
+{
+	if (m_nNumOfPixelBuffers > 0)
+	{
+		g_pfnDeleteBuffers(GLsizei(m_nNumOfPixelBuffers), m_nPixelBuffers);
+		MemoryManager::Set(m_nPixelBuffers, 0, sizeof(m_nPixelBuffers));
+		MemoryManager::Set(m_nPixelBufferSize, 0, sizeof(m_nPixelBufferSize));
+		m_nNumOfPixelBuffers = 0;
+		m_nCurrentPixelBuffer = 0;
+	}
+}
+
+
+void TextureUploader::DestroyStagingBuffers()
+{
+	if (0 != m_nStagingBuffers[0])
+	{
+		if (m_pStagingData)
+		{
+			g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_nStagingBuffers[m_nCurrentStagingBuffer]);
+			g_pfnUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			m_pStagingData = nullptr;
+		}
+		g_pfnDeleteBuffers(2, m_nStagingBuffers);
+		MemoryManager::Set(m_nStagingBuffers, 0, sizeof(m_nStagingBuffers));
+	}
+}
+
+
+uint64 TextureUploader::UploadThroughPixelBuffer(const uint8 *pImageBuffer, const int &nWidth, size_t nNumOfRects, const Berkelium::Rect *pRects)
+{
+	// get the size of the packed rectangles
+	uint64 nBytes = 0;
+	for (size_t i = 0; i < nNumOfRects; i++)
+	{
+		nBytes += uint64(pRects[i].width()) * uint64(pRects[i].height()) * 4;
+	}
+	if (nBytes == 0)
+	{
+		return 0;
+	}
+
+	// take the next buffer of the ring, the GPU might still pull from the previous ones
+	m_nCurrentPixelBuffer = (m_nCurrentPixelBuffer + 1) % m_nNumOfPixelBuffers;
+	g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_nPixelBuffers[m_nCurrentPixelBuffer]);
+
+	// respecify the storage, if the GPU still uses the buffer the driver hands out fresh memory instead of waiting
+	if (m_nPixelBufferSize[m_nCurrentPixelBuffer] < nBytes)
+	{
+		m_nPixelBufferSize[m_nCurrentPixelBuffer] = nBytes;
+	}
+	g_pfnBufferData(GL_PIXEL_UNPACK_BUFFER, ptrdiff_t(m_nPixelBufferSize[m_nCurrentPixelBuffer]), nullptr, GL_STREAM_DRAW);
+
+	uint8 *pPixelBuffer = static_cast<uint8*>(g_pfnMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY));
+	if (!pPixelBuffer)
+	{
+		g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		return 0;
+	}
+
+	// pack the rectangles tightly
+	uint64 nOffset = 0;
+	for (size_t i = 0; i < nNumOfRects; i++)
+	{
+		const Berkelium::Rect &cRect = pRects[i];
+		const size_t nRowSize = size_t(cRect.width()) * 4;
+		for (int nRow = 0; nRow < cRect.height(); nRow++)
+		{
+			MemoryManager::Copy(&pPixelBuffer[nOffset], &pImageBuffer[(size_t(cRect.top() + nRow) * size_t(nWidth) + size_t(cRect.left())) * 4], nRowSize);
+			nOffset += nRowSize;
+		}
+	}
+
+	if (!g_pfnUnmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+	{
+		// the buffer content got lost, e.g. on a display mode change
+		g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		return 0;
+	}
+
+	// queue the texture updates, the data pointer is an offset into the bound pixel buffer
+	nOffset = 0;
+	for (size_t i = 0; i < nNumOfRects; i++)
+	{
+		const Berkelium::Rect &cRect = pRects[i];
+		glTexSubImage2D(GL_TEXTURE_2D, 0, cRect.left(), cRect.top(), cRect.width(), cRect.height(), GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<const GLvoid*>(size_t(nOffset)));
+		nOffset += uint64(cRect.width()) * uint64(cRect.height()) * 4;
+	}
+
+	g_pfnBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	return nBytes;
+}
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+} // PLBerkelium
@@ -0,0 +1,245 @@
+//[-------------------------------------------------------]
+//[ Header                                                ]
+//[-------------------------------------------------------]
+#include "PLBerkelium/WindowAnimator.h"
+#include "PLBerkelium/SRPWindow.h"
+
+#include <PLCore/System/System.h>
+#include <PLCore/Core/MemoryManager.h>
+
+
+//[-------------------------------------------------------]
+//[ Namespace                                             ]
+//[-------------------------------------------------------]
+using namespace PLCore;
+using namespace PLMath;
+
+namespace PLBerkelium {
+
+
+//[-------------------------------------------------------]
+//[ Functions		                                      ]
+//[-------------------------------------------------------]
+WindowAnimator::WindowAnimator() :
+	m_nNumOfTweens(0)
+{
+	MemoryManager::Set(&m_sStats, 0, sizeof(sWindowAnimatorStats));
+}
+
+
+WindowAnimator::~WindowAnimator()
+{
+	// the windows are not owned, the tweens just end
+}
+
+
+bool WindowAnimator::Animate(SRPWindow *pSRPWindow, const EWindowTweenProperty &nProperty, const Vector2 &vTo, const uint32 &nDuration, const EWindowTweenEasing &nEasing, const bool &bHideOnEnd)
+{
+	if (!pSRPWindow)
+	{
+		return false;
+	}
+
+	// a running tween of the property is replaced, the new one starts where it is now
+	for (uint32 i = 0; i < m_nNumOfTweens; i++)
+	{
+		if (m_sTweens[i].pSRPWindow == pSRPWindow && m_sTweens[i].nProperty == nProperty)
+		{
+			RemoveTween(i);
+			m_sStats.nInterrupted++;
+			break;
+		}
+	}
+
+	sWindowTween sTween;
+	sTween.pSRPWindow = pSRPWindow;
+	sTween.nProperty = nProperty;
+	sTween.nEasing = nEasing;
+	sTween.vFrom = GetValue(pSRPWindow, nProperty);
+	sTween.vTo = vTo;
+	sTween.nStartTime = System::GetInstance()->GetMilliseconds();
+	sTween.nDuration = nDuration;
+	sTween.bHideOnEnd = bHideOnEnd;
+
+	if (!nDuration || m_nNumOfTweens == MAXWINDOWTWEENS)
+	{
+		// nothing to animate or no slot left, jump to the end
+		if (nDuration)
+		{
+			m_sStats.nSkipped++;
+		}
+		Finish(sTween);
+		return false;
+	}
+
+	m_sTweens[m_nNumOfTweens] = sTween;
+	m_nNumOfTweens++;
+	m_sStats.nStarted++;
+	return true;
+}
+
+
+void WindowAnimator::Stop(SRPWindow *pSRPWindow, const bool &bFinish)
+{
+	uint32 i = 0;
+	while (i < m_nNumOfTweens)
+	{
+		if (m_sTweens[i].pSRPWindow == pSRPWindow)
+		{
+			if (bFinish)
+			{
+				Finish(m_sTweens[i]);
+			}
+			else
+			{
+				m_sStats.nInterrupted++;
+			}
+			RemoveTween(i);
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+
+bool WindowAnimator::IsAnimating(const SRPWindow *pSRPWindow) const
+{
+	for (uint32 i = 0; i < m_nNumOfTweens; i++)
+	{
+		if (m_sTweens[i].pSRPWindow == pSRPWindow)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+uint32 WindowAnimator::Update()
+{
+	const uint64 nTime = System::GetInstance()->GetMilliseconds();
+
+	uint32 i = 0;
+	while (i < m_nNumOfTweens)
+	{
+		const sWindowTween &sTween = m_sTweens[i];
+		const uint64 nElapsed = nTime - sTween.nStartTime;
+		if (nElapsed >= sTween.nDuration)
+		{
+			// the tween ended, its slot is taken by the last one
+			Finish(sTween);
+			RemoveTween(i);
+		}
+		else
+		{
+			const float fProgress = Ease(sTween.nEasing, float(nElapsed)/float(sTween.nDuration));
+			SetValue(sTween.pSRPWindow, sTween.nProperty, sTween.vFrom + (sTween.vTo - sTween.vFrom)*fProgress);
+			i++;
+		}
+	}
+	return m_nNumOfTweens;
+}
+
+
+uint32 WindowAnimator::GetNumOfTweens() const
+{
+	return m_nNumOfTweens;
+}
+
+
+const sWindowAnimatorStats &WindowAnimator::GetStats() const
+{
+	return m_sStats;
+}
+
+
+float WindowAnimator::Ease(const EWindowTweenEasing &nEasing, const float &fProgress)
+{
+	const float t = (fProgress < 0.0f) ? 0.0f : ((fProgress > 1.0f) ? 1.0f : fProgress);
+	switch (nEasing)
+	{
+		case EasingSmooth:
+			return t*t*(3.0f - 2.0f*t);
+
+		case EasingOut:
+			return 1.0f - (1.0f - t)*(1.0f - t);
+
+		case EasingLinear:
+		default:
+			return t;
+	}
+}
+
+
+Vector2 WindowAnimator::GetValue(const SRPWindow *pSRPWindow, const EWindowTweenProperty &nProperty)
+{
+	const sWindowsData *psWindowsData = pSRPWindow->GetData();
+	switch (nProperty)
+	{
+		case TweenOpacity:
+			return Vector2(psWindowsData->fOpacity, 0.0f);
+
+		case TweenTranslation:
+			return psWindowsData->vTranslation;
+
+		case TweenScale:
+			return Vector2(psWindowsData->fScale, 0.0f);
+
+		default:
+			return Vector2::Zero;
+	}
+}
+
+
+void WindowAnimator::SetValue(SRPWindow *pSRPWindow, const EWindowTweenProperty &nProperty, const Vector2 &vValue)
+{
+	sWindowsData *psWindowsData = pSRPWindow->GetData();
+	switch (nProperty)
+	{
+		case TweenOpacity:
+			psWindowsData->fOpacity = (vValue.x < 0.0f) ? 0.0f : ((vValue.x > 1.0f) ? 1.0f : vValue.x);
+			break;
+
+		case TweenTranslation:
+			psWindowsData->vTranslation = vValue;
+			break;
+
+		case TweenScale:
+			psWindowsData->fScale = (vValue.x < 0.0f) ? 0.0f : vValue.x;
+			break;
+
+		default:
+			break;
+	}
+}
+
+
+void WindowAnimator::Finish(const sWindowTween &sTween)
+{
+	if (sTween.bHideOnEnd)
+	{
+		// hidden at the end, the value goes back to the start so a plain show brings the window back as it was
+		sTween.pSRPWindow->SetVisible(false);
+		SetValue(sTween.pSRPWindow, sTween.nProperty, sTween.vFrom);
+	}
+	else
+	{
+		SetValue(sTween.pSRPWindow, sTween.nProperty, sTween.vTo);
+	}
+	m_sStats.nFinished++;
+}
+
+
+void WindowAnimator::RemoveTween(uint32 nIndex)
+{
+	m_nNumOfTweens--;
+	if (nIndex < m_nNumOfTweens)
+	{
+		m_sTweens[nIndex] = m_sTweens[m_nNumOfTweens];
+	}
+}
+
+
+};